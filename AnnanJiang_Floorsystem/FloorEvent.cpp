@@ -1,59 +1,157 @@
 #include "FloorEvent.h"
-#include <sstream>
-#include <iostream>
+#include <charconv>
+#include <cstring>
 
-// 默认构造函数（实现）
-FloorEvent::FloorEvent() : timestamp(""), floorNumber(0), buttonType(""), carButton(0) {}
+namespace {
 
-// 带参数的构造函数（实现）
-FloorEvent::FloorEvent(const std::string& time, int floor, const std::string& button, int targetFloor)
-    : timestamp(time), floorNumber(floor), buttonType(button), carButton(targetFloor) {}
-
-// 将对象转换为字符串（实现）
-std::string FloorEvent::serialize() const {
-    std::ostringstream oss;
-    oss << timestamp << "," << floorNumber << "," << buttonType << "," << carButton;
-    return oss.str();
+// 读取一个无符号整数，恰好 digits 位（digits 为 0 时不限位数）
+bool readNumber(const char*& p, const char* end, uint32_t& value, size_t digits = 0) {
+    auto result = std::from_chars(p, end, value);
+    if (result.ec != std::errc() || (digits != 0 && static_cast<size_t>(result.ptr - p) != digits)) {
+        return false;
+    }
+    p = result.ptr;
+    return true;
 }
 
-// 将字符串转换为对象（实现）
-FloorEvent FloorEvent::deserialize(const std::string& data) {
-    std::istringstream iss(data);
-    std::string timestamp, buttonType;
-    int floorNumber = 0;
-    int carButton = 0;
-    char delimiter;
+bool readInt(const char*& p, const char* end, int32_t& value) {
+    while (p < end && *p == ' ') ++p;
+    auto result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    p = result.ptr;
+    while (p < end && *p == ' ') ++p;
+    return true;
+}
 
-    // 解析时间戳
-    if (!std::getline(iss, timestamp, ',')) {
-        std::cerr << "Error: Failed to parse timestamp from '" << data << "'" << std::endl;
-        return FloorEvent();
+bool expect(const char*& p, const char* end, char c) {
+    if (p == end || *p != c) {
+        return false;
     }
+    ++p;
+    return true;
+}
 
-    // 解析楼层号
-    if (!(iss >> floorNumber)) {
-        std::cerr << "Error: Failed to parse floorNumber from '" << data << "'" << std::endl;
-        return FloorEvent();
+// 解析时间戳：[yyyy-mm-ddT]hh:mm:ss[.mmm]
+bool readTimestamp(const char*& p, const char* end, uint32_t& date, uint32_t& timeMs) {
+    uint32_t year = 0, month = 0, day = 0, hour, minute, second, ms = 0;
+    date = 0;
+    if (end - p > 4 && p[4] == '-') {
+        if (!readNumber(p, end, year, 4) || !expect(p, end, '-') ||
+            !readNumber(p, end, month, 2) || !expect(p, end, '-') ||
+            !readNumber(p, end, day, 2) || !expect(p, end, 'T')) {
+            return false;
+        }
+        if (month < 1 || month > 12 || day < 1 || day > 31) {
+            return false;
+        }
+        date = year * 10000 + month * 100 + day;
+    }
+    if (!readNumber(p, end, hour, 2) || !expect(p, end, ':') ||
+        !readNumber(p, end, minute, 2) || !expect(p, end, ':') ||
+        !readNumber(p, end, second, 2)) {
+        return false;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        const char* start = p;
+        if (!readNumber(p, end, ms) || p - start > 3) {
+            return false;
+        }
+        for (auto n = p - start; n < 3; ++n) ms *= 10;  // ".5" 是 500 毫秒
+    }
+    if (hour > 23 || minute > 59 || second > 59) {
+        return false;
     }
+    timeMs = ((hour * 60 + minute) * 60 + second) * 1000 + ms;
+    return true;
+}
 
-    // 跳过逗号
-    if (!(iss >> delimiter) || delimiter != ',') {
-        std::cerr << "Error: Missing or incorrect delimiter after floorNumber in '" << data << "'" << std::endl;
-        return FloorEvent();
+bool readButton(const char*& p, const char* end, ButtonType& button) {
+    const char* start = p;
+    while (p < end && *p != ',') ++p;
+    std::string_view word(start, p - start);
+    while (!word.empty() && word.back() == ' ') word.remove_suffix(1);
+    while (!word.empty() && word.front() == ' ') word.remove_prefix(1);
+    if (word.size() == 2 && (word[0] | 0x20) == 'u' && (word[1] | 0x20) == 'p') {
+        button = ButtonType::Up;
+        return true;
+    }
+    if (word.size() == 4 && (word[0] | 0x20) == 'd' && (word[1] | 0x20) == 'o' &&
+        (word[2] | 0x20) == 'w' && (word[3] | 0x20) == 'n') {
+        button = ButtonType::Down;
+        return true;
     }
+    return false;
+}
 
-    // 解析按钮类型
-    if (!std::getline(iss, buttonType, ',')) {
-        std::cerr << "Error: Failed to parse buttonType from '" << data << "'" << std::endl;
-        return FloorEvent();
+// 写入固定位数的数字，不足补 0
+char* writePadded(char* p, uint32_t value, int digits) {
+    for (int i = digits - 1; i >= 0; --i) {
+        p[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
     }
+    return p + digits;
+}
+
+} // namespace
+
+const char* buttonTypeName(ButtonType button) {
+    return button == ButtonType::Up ? "up" : "down";
+}
 
-    // 解析目标楼层号
-    if (!(iss >> carButton)) {
-        std::cerr << "Error: Failed to parse carButton from '" << data << "'" << std::endl;
-        return FloorEvent();
+// 将对象转换为字符串（实现）
+size_t FloorEvent::serialize(char* buffer, size_t size) const {
+    if (size < MAX_TEXT) {
+        return 0;
+    }
+    char* p = buffer;
+    char* end = buffer + size - 1;  // 留出 '\0'
+    if (date != 0) {
+        p = writePadded(p, date / 10000, 4);
+        *p++ = '-';
+        p = writePadded(p, date / 100 % 100, 2);
+        *p++ = '-';
+        p = writePadded(p, date % 100, 2);
+        *p++ = 'T';
+    }
+    uint32_t seconds = timeMs / 1000;
+    p = writePadded(p, seconds / 3600, 2);
+    *p++ = ':';
+    p = writePadded(p, seconds / 60 % 60, 2);
+    *p++ = ':';
+    p = writePadded(p, seconds % 60, 2);
+    if (timeMs % 1000 != 0) {
+        *p++ = '.';
+        p = writePadded(p, timeMs % 1000, 3);
     }
+    *p++ = ',';
+    p = std::to_chars(p, end, floorNumber).ptr;
+    *p++ = ',';
+    const char* name = buttonTypeName(buttonType);
+    size_t length = std::strlen(name);
+    std::memcpy(p, name, length);
+    p += length;
+    *p++ = ',';
+    p = std::to_chars(p, end, carButton).ptr;
+    *p = '\0';
+    return p - buffer;
+}
+
+std::string FloorEvent::serialize() const {
+    char buffer[MAX_TEXT];
+    return std::string(buffer, serialize(buffer, sizeof(buffer)));
+}
+
+// 将字符串转换为对象（实现）
+bool FloorEvent::deserialize(std::string_view data, FloorEvent& event) {
+    const char* p = data.data();
+    const char* end = p + data.size();
+    while (end > p && (end[-1] == '\r' || end[-1] == ' ')) --end;  // Windows 行尾
 
-    // 返回解析后的 FloorEvent 对象
-    return FloorEvent(timestamp, floorNumber, buttonType, carButton);
+    return readTimestamp(p, end, event.date, event.timeMs) && expect(p, end, ',') &&
+           readInt(p, end, event.floorNumber) && expect(p, end, ',') &&
+           readButton(p, end, event.buttonType) && expect(p, end, ',') &&
+           readInt(p, end, event.carButton) && p == end;
 }
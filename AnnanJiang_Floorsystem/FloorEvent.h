@@ -1,26 +1,45 @@
 #ifndef FLOOREVENT_H
 #define FLOOREVENT_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
-class FloorEvent
+// 按钮类型
+enum class ButtonType : uint8_t {
+    Up,
+    Down
+};
+
+// 一行输入，例如 "2023-10-01T12:34:56,5,up,6"
+// POD: 可以直接复制、放进数组，不申请内存
+struct FloorEvent
 {
-public:
-    std::string timestamp;  // 时间戳
-    int floorNumber;        // 楼层号
-    std::string buttonType; // 按钮类型
-    int carButton;   
+    uint32_t date;          // 日期 yyyymmdd，没有日期时为 0
+    uint32_t timeMs;        // 时间戳：当天零点起的毫秒数
+    int32_t floorNumber;    // 楼层号
+    ButtonType buttonType;  // 按钮类型
+    int32_t carButton;      // 目标楼层号
 
-    FloorEvent();
+    // Longest line serialize() can produce, including the terminating '\0'
+    static constexpr size_t MAX_TEXT = 64;
 
-    // construct
-    FloorEvent(const std::string& time, int floor, const std::string& button, int targetFloor);
+    // turn object to string: writes into buffer (NUL-terminated), returns the length, 0 if it does not fit
+    size_t serialize(char* buffer, size_t size) const;
 
-    // turn object to string
+    // turn object to string (allocates; for logging)
     std::string serialize() const;
 
-    // turn string to object
-    static FloorEvent deserialize(const std::string& data);
+    // turn string to object: false if the line is malformed, event is then unspecified
+    static bool deserialize(std::string_view data, FloorEvent& event);
 };
 
-#endif
\ No newline at end of file
+static_assert(std::is_trivial<FloorEvent>::value && std::is_standard_layout<FloorEvent>::value,
+              "FloorEvent must stay a POD");
+
+// "up" / "down"
+const char* buttonTypeName(ButtonType button);
+
+#endif
@@ -1,44 +1,81 @@
 #include "InputParser.h"
 #include "FloorEvent.h"
-#include <fstream>
-#include <sstream>
+#include <cstring>
 #include <iostream>
-#include <queue>
+#include <string_view>
 
-std::queue<FloorEvent> InputParser::parseFile(const std::string& fileName) {
-    std::queue<FloorEvent> eventQueue; // Queue to store parsed FloorEvent objects
-    std::ifstream file(fileName);     // Open the input file
-
-    if (!file.is_open()) {
+InputParser::InputParser(const std::string& fileName)
+    : file(std::fopen(fileName.c_str(), "rb")), buffer(nullptr), start(0), filled(0), skipping(false), atEnd(false) {
+    if (file == nullptr) {
         std::cerr << "Error: Unable to open file " << fileName << std::endl;
-        return eventQueue; // Return an empty queue if the file cannot be opened
+        return;
     }
+    buffer = new char[BUFFER_SIZE];
+}
 
-    std::string line;
-    while (std::getline(file, line)) { // Read each line from the file
-        if (line.empty()) { // Skip empty lines
-            continue;
-        }
+InputParser::~InputParser() {
+    if (file != nullptr) {
+        std::fclose(file); // Close the file
+    }
+    delete[] buffer;
+}
 
-        std::istringstream iss(line); // Create a string stream for parsing the line
-        std::string timestamp, buttonType;
-        int floorNumber = 0, carButton = 0;
-        char delimiter;
+// Move the unfinished line to the front of the buffer and read more after it
+bool InputParser::refill() {
+    if (atEnd) {
+        return false;
+    }
+    std::memmove(buffer, buffer + start, filled - start);
+    filled -= start;
+    start = 0;
+    size_t count = std::fread(buffer + filled, 1, BUFFER_SIZE - filled, file);
+    if (count == 0) {
+        atEnd = true;
+    }
+    filled += count;
+    return count > 0;
+}
 
-        // Parse the line using ',' as a delimiter
-        if (std::getline(iss, timestamp, ',') &&  // Parse timestamp
-            (iss >> floorNumber) &&               // Parse floor number
-            (iss >> delimiter) && delimiter == ',' &&  // Validate and skip delimiter
-            std::getline(iss, buttonType, ',') && // Parse button type
-            (iss >> carButton)) {                 // Parse car button
-            // Successfully parsed all fields, add the event to the queue
-            eventQueue.emplace(timestamp, floorNumber, buttonType, carButton);
+bool InputParser::next(FloorEvent& event) {
+    if (file == nullptr) {
+        return false;
+    }
+    while (true) {
+        const char* lineStart = buffer + start;
+        const char* newline = static_cast<const char*>(std::memchr(lineStart, '\n', filled - start));
+        size_t length;
+        if (newline != nullptr) {
+            length = newline - lineStart;
+        } else if (start == 0 && filled == BUFFER_SIZE) {
+            // No newline in a full buffer: the line is too long, drop it up to the next newline
+            if (!skipping) {
+                std::cerr << "Warning: Line longer than " << BUFFER_SIZE << " bytes skipped" << std::endl;
+            }
+            skipping = true;
+            filled = 0;
+            refill();
+            continue;
+        } else if (refill()) {
+            continue;
+        } else if (start < filled) {
+            length = filled - start;  // Last line without a newline
         } else {
-            // Handle invalid line format
-            std::cerr << "Warning: Invalid line format: " << line << std::endl;
+            return false;
         }
-    }
 
-    file.close(); // Close the file
-    return eventQueue; // Return the queue with parsed events
+        std::string_view line(lineStart, length);
+        start += length + (newline != nullptr ? 1 : 0);
+        if (skipping) { // Tail of an over-long line
+            skipping = false;
+            continue;
+        }
+        if (line.empty() || line == "\r") { // Skip empty lines
+            continue;
+        }
+        if (FloorEvent::deserialize(line, event)) {
+            return true;
+        }
+        // Handle invalid line format
+        std::cerr << "Warning: Invalid line format: " << line << std::endl;
+    }
 }
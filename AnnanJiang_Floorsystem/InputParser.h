@@ -1,14 +1,70 @@
 #ifndef INPUTPARSER_H
 #define INPUTPARSER_H
 
+#include <cstdio>
+#include <cstddef>
+#include <iterator>
 #include <string>
-#include <queue>
-#include "FloorEvent.h" 
+#include "FloorEvent.h"
 
+// 逐行读取输入文件，边读边解析，不把整个文件放进内存
+//
+//     InputParser parser("input.txt");
+//     for (const FloorEvent& event : parser) { ... }
+//
+// 格式错误的行会打印警告并跳过。
 class InputParser {
 public:
-    // 解析输入文件并返回事件队列
-    static std::queue<FloorEvent> parseFile(const std::string& fileName);
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;  // 一次读入的字节数，也是最长的行
+
+    explicit InputParser(const std::string& fileName);
+    ~InputParser();
+    InputParser(const InputParser&) = delete;
+    InputParser& operator=(const InputParser&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    // 读取下一个事件，文件结束时返回 false
+    bool next(FloorEvent& event);
+
+    // Single-pass input iterator over the remaining events
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = FloorEvent;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const FloorEvent*;
+        using reference = const FloorEvent&;
+
+        iterator() : parser(nullptr), event() {}
+        explicit iterator(InputParser* parser) : parser(parser), event() { ++*this; }
+
+        reference operator*() const { return event; }
+        pointer operator->() const { return &event; }
+        iterator& operator++() {
+            if (parser != nullptr && !parser->next(event)) parser = nullptr;
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return parser == other.parser; }
+        bool operator!=(const iterator& other) const { return parser != other.parser; }
+
+    private:
+        InputParser* parser;  // nullptr once the file is exhausted
+        FloorEvent event;
+    };
+
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+
+private:
+    std::FILE* file;
+    char* buffer;       // BUFFER_SIZE bytes, allocated once
+    size_t start;       // 下一行的开始位置
+    size_t filled;      // buffer 中有效的字节数
+    bool skipping;      // 正在跳过过长的行
+    bool atEnd;
+
+    bool refill();
 };
 
 #endif // INPUTPARSER_H
@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "InputParser.h"
+#include "FloorEvent.h"
+
+// 测量解析速度（百万事件/秒）
+//     g++ -std=c++17 -O2 -o bench ParseBenchmark.cpp FloorEvent.cpp InputParser.cpp
+
+static const size_t EVENT_COUNT = 2000000;
+static const char* BENCH_FILE = "bench_input.txt";
+
+static double millionsPerSecond(size_t events, std::chrono::steady_clock::duration elapsed) {
+    return events / std::chrono::duration<double>(elapsed).count() / 1e6;
+}
+
+int main() {
+    // 生成输入：和 input.txt 相同的格式
+    std::vector<char> text;
+    char line[FloorEvent::MAX_TEXT];
+    for (size_t i = 0; i < EVENT_COUNT; i++) {
+        FloorEvent event = {20231001, static_cast<uint32_t>(i * 37 % 86400000), static_cast<int32_t>(i % 20 + 1),
+                            i % 2 ? ButtonType::Down : ButtonType::Up, static_cast<int32_t>(i % 19 + 1)};
+        size_t length = event.serialize(line, sizeof(line));
+        text.insert(text.end(), line, line + length);
+        text.push_back('\n');
+    }
+
+    // 1. 只解析：内存中的每一行
+    size_t parsed = 0;
+    long checksum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos < text.size();) {
+        size_t newline = pos;
+        while (text[newline] != '\n') newline++;
+        FloorEvent event;
+        if (FloorEvent::deserialize(std::string_view(&text[pos], newline - pos), event)) {
+            parsed++;
+            checksum += event.timeMs + event.carButton;
+        }
+        pos = newline + 1;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    std::cout << "deserialize: " << parsed << " events, " << millionsPerSecond(parsed, elapsed)
+              << " M events/s (checksum " << checksum << ")" << std::endl;
+
+    // 2. 格式化
+    size_t bytes = 0;
+    begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < EVENT_COUNT; i++) {
+        FloorEvent event = {20231001, static_cast<uint32_t>(i * 37 % 86400000), 5, ButtonType::Up, 6};
+        bytes += event.serialize(line, sizeof(line));
+    }
+    elapsed = std::chrono::steady_clock::now() - begin;
+    std::cout << "serialize:   " << EVENT_COUNT << " events, " << millionsPerSecond(EVENT_COUNT, elapsed)
+              << " M events/s (" << bytes << " bytes)" << std::endl;
+
+    // 3. 从文件流式解析
+    std::FILE* file = std::fopen(BENCH_FILE, "wb");
+    if (file == nullptr) {
+        std::cerr << "Error: Unable to write " << BENCH_FILE << std::endl;
+        return 1;
+    }
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+
+    parsed = 0;
+    begin = std::chrono::steady_clock::now();
+    {
+        InputParser parser(BENCH_FILE);
+        for (const FloorEvent& event : parser) {
+            parsed++;
+            checksum += event.floorNumber;
+        }
+    }
+    elapsed = std::chrono::steady_clock::now() - begin;
+    std::cout << "InputParser: " << parsed << " events, " << millionsPerSecond(parsed, elapsed)
+              << " M events/s (checksum " << checksum << ")" << std::endl;
+
+    std::remove(BENCH_FILE);
+    return parsed == EVENT_COUNT ? 0 : 1;
+}
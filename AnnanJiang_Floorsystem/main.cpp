@@ -1,21 +1,17 @@
 #include <iostream>
 #include "InputParser.h"
 #include "FloorEvent.h"
-#include <queue>
 
 int main() {
     // 测试输入文件
     std::string fileName = "input.txt";
 
-    // 解析文件
-    std::queue<FloorEvent> events = InputParser::parseFile(fileName);
-
-    // 打印解析的事件
-    while (!events.empty()) {
-        FloorEvent event = events.front();
-        events.pop();
-        std::cout << "Event: " << event.timestamp << ", Floor: " << event.floorNumber
-                  << ", Button: " << event.buttonType <<", Carbutton: "<<event.carButton<< std::endl;
+    // 解析文件，逐个打印事件
+    InputParser parser(fileName);
+    char text[FloorEvent::MAX_TEXT];
+    for (const FloorEvent& event : parser) {
+        event.serialize(text, sizeof(text));
+        std::cout << "Event: " << text << std::endl;
     }
 
     return 0;
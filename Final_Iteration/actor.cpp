@@ -0,0 +1,258 @@
+/* actor.cpp */
+#include "actor.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+Actor::Actor()
+    : resumePoint_(0), finished_(false), executor_(nullptr), timerId_(0), timerFired_(false),
+      waitingForMessage_(false), queued_(false), watchedFd_(-1), mailHead_(0) {}
+
+bool Actor::sleepFor(long ms) {
+    if (timerFired_) {
+        timerFired_ = false;
+        return true;
+    }
+    if (timerId_ == 0)
+        executor_->arm(*this, executor_->now() + ms);
+    return false;
+}
+
+bool Actor::message() {
+    if (hasMessage() || stopping()) {
+        waitingForMessage_ = false;
+        return true;
+    }
+    waitingForMessage_ = true;
+    return false;
+}
+
+bool Actor::messageOrTimeout(long ms) {
+    if (hasMessage() || timerFired_ || stopping()) {
+        executor_->cancel(*this);
+        timerFired_ = false;
+        waitingForMessage_ = false;
+        return true;
+    }
+    if (timerId_ == 0)
+        executor_->arm(*this, executor_->now() + ms);
+    waitingForMessage_ = true;
+    return false;
+}
+
+bool Actor::takeMessage(ElevatorMessage &msg, struct sockaddr_in *from) {
+    if (!hasMessage())
+        return false;
+    const Mail &mail = mailbox_[mailHead_++];
+    msg = mail.msg;
+    if (from != nullptr && mail.from.sin_family != 0)
+        *from = mail.from;
+    if (mailHead_ == mailbox_.size()) {
+        mailbox_.clear();
+        mailHead_ = 0;
+    }
+    return true;
+}
+
+long Actor::now() const {
+    return executor_->now();
+}
+
+bool Actor::stopping() const {
+    return executor_->stopping_;
+}
+
+void Actor::deliver(const Mail &mail) {
+    mailbox_.push_back(mail);
+    if (waitingForMessage_) {
+        waitingForMessage_ = false;
+        executor_->wake(*this);
+    }
+}
+
+ActorExecutor::ActorExecutor(bool simulatedTime)
+    : simulated_(simulatedTime), simNow_(0), start_(std::chrono::steady_clock::now()),
+      epollFd_(epoll_create1(0)), wakeFd_(eventfd(0, EFD_NONBLOCK)), stopping_(false), stopped_(false),
+      watched_(0), live_(0), nextTimerId_(1), resumes_(0) {
+    if (epollFd_ < 0)
+        std::cerr << "[EXECUTOR] epoll_create1 failed: " << strerror(errno) << "\n";
+    // The wake event has no actor: data.ptr stays null.
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    if (epollFd_ >= 0 && wakeFd_ >= 0)
+        epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &event);
+}
+
+ActorExecutor::~ActorExecutor() {
+    if (wakeFd_ >= 0)
+        close(wakeFd_);
+    if (epollFd_ >= 0)
+        close(epollFd_);
+}
+
+long ActorExecutor::now() const {
+    if (simulated_)
+        return simNow_;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_).count();
+}
+
+void ActorExecutor::spawn(Actor &actor) {
+    actor.executor_ = this;
+    actors_.push_back(&actor);
+    live_++;
+    wake(actor);
+}
+
+void ActorExecutor::shutdown() {
+    stopping_ = true;
+    uint64_t one = 1;
+    if (wakeFd_ >= 0 && write(wakeFd_, &one, sizeof(one)) < 0 && errno != EAGAIN)
+        std::cerr << "[EXECUTOR] eventfd write failed: " << strerror(errno) << "\n";
+}
+
+// Resume every actor blocked on a message so it sees stopping(). Actors asleep
+// on a timer see it at their next message wait.
+void ActorExecutor::stopActors() {
+    stopped_ = true;
+    for (Actor *actor : actors_) {
+        if (actor->waitingForMessage_) {
+            actor->waitingForMessage_ = false;
+            wake(*actor);
+        }
+    }
+}
+
+bool ActorExecutor::watch(Actor &actor, int fd) {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = &actor;
+    if (epollFd_ < 0 || epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) < 0)
+        return false;
+    actor.watchedFd_ = fd;
+    watched_++;
+    return true;
+}
+
+void ActorExecutor::post(Actor &actor, const ElevatorMessage &msg) {
+    Actor::Mail mail;
+    mail.msg = msg;
+    memset(&mail.from, 0, sizeof(mail.from));
+    actor.deliver(mail);
+}
+
+void ActorExecutor::arm(Actor &actor, long at) {
+    Timer timer = {at, nextTimerId_++, &actor};
+    actor.timerId_ = timer.id;
+    timers_.push(timer);
+}
+
+void ActorExecutor::wake(Actor &actor) {
+    if (actor.queued_ || actor.finished_)
+        return;
+    actor.queued_ = true;
+    ready_.push_back(&actor);
+}
+
+// Timers whose actor re-armed or cancelled since are stale and skipped.
+void ActorExecutor::fireTimers() {
+    long current = now();
+    while (!timers_.empty() && timers_.top().at <= current) {
+        Timer timer = timers_.top();
+        timers_.pop();
+        if (timer.actor->timerId_ != timer.id)
+            continue;
+        timer.actor->timerId_ = 0;
+        timer.actor->timerFired_ = true;
+        wake(*timer.actor);
+    }
+}
+
+// Drain every readable socket into its actor's mailbox. A timeout of -1 waits
+// until something arrives.
+void ActorExecutor::pollSockets(long timeoutMs) {
+    struct epoll_event events[ACTOR_MAX_EVENTS];
+    int count = epoll_wait(epollFd_, events, ACTOR_MAX_EVENTS, static_cast<int>(timeoutMs));
+    for (int i = 0; i < count; i++) {
+        if (events[i].data.ptr == nullptr) {
+            uint64_t wakeups;
+            while (read(wakeFd_, &wakeups, sizeof(wakeups)) == sizeof(wakeups)) {}
+            continue;
+        }
+        Actor &actor = *static_cast<Actor*>(events[i].data.ptr);
+        Actor::Mail mail;
+        socklen_t addrLen = sizeof(mail.from);
+        while (recvfrom(actor.watchedFd_, &mail.msg, sizeof(mail.msg), MSG_DONTWAIT,
+                        (struct sockaddr*)&mail.from, &addrLen) == sizeof(mail.msg)) {
+            actor.deliver(mail);
+            addrLen = sizeof(mail.from);
+        }
+    }
+}
+
+void ActorExecutor::retire(Actor &actor) {
+    cancel(actor);
+    if (actor.watchedFd_ >= 0) {
+        epoll_ctl(epollFd_, EPOLL_CTL_DEL, actor.watchedFd_, nullptr);
+        actor.watchedFd_ = -1;
+        watched_--;
+    }
+    live_--;
+}
+
+void ActorExecutor::runUntil(long limit) {
+    while (live_ > 0) {
+        if (stopping_ && !stopped_)
+            stopActors();
+        // Resume everything that is ready; actors woken meanwhile run in the next round.
+        while (!ready_.empty()) {
+            running_.swap(ready_);
+            for (Actor *actor : running_) {
+                actor->queued_ = false;
+                actor->run();
+                resumes_++;
+                if (actor->finished_)
+                    retire(*actor);
+            }
+            running_.clear();
+        }
+        if (live_ == 0)
+            break;
+
+        long next = timers_.empty() ? -1 : timers_.top().at;
+        if (limit >= 0 && now() >= limit)
+            return;
+        if (simulated_) {
+            if (watched_ > 0)
+                pollSockets(0);
+            if (ready_.empty()) {
+                if (next < 0 || (limit >= 0 && next > limit)) {
+                    // Nothing left to happen before the limit.
+                    if (limit >= 0)
+                        simNow_ = limit;
+                    return;
+                }
+                simNow_ = std::max(simNow_, next);
+            }
+        } else {
+            if (next < 0 && watched_ == 0)
+                return;   // Every actor waits on something that can never come
+            long timeout = next < 0 ? -1 : std::max(0L, next - now());
+            if (limit >= 0) {
+                long left = std::max(0L, limit - now());
+                timeout = timeout < 0 ? left : std::min(timeout, left);
+            }
+            if (epollFd_ >= 0)
+                pollSockets(timeout);
+            else if (timeout > 0)
+                usleep(static_cast<useconds_t>(timeout) * 1000);
+        }
+        fireTimers();
+    }
+}
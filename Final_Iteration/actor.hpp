@@ -0,0 +1,178 @@
+#ifndef ACTOR_HPP
+#define ACTOR_HPP
+
+#include "message.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+#include <netinet/in.h>
+
+#define ACTOR_MAX_EVENTS 64      // Sockets handled per epoll_wait
+
+// Resumable actor bodies. run() reads top to bottom like a blocking loop, but each
+// wait hands control back to the executor instead of parking a thread:
+//
+//     void run() {
+//         ACTOR_BEGIN;
+//         while (!stopping()) {
+//             ACTOR_AWAIT(message());
+//             if (!takeMessage(request_)) continue;
+//             ...
+//         }
+//         ACTOR_END;
+//     }
+//
+// A resumed actor jumps straight back to the ACTOR_AWAIT it left, so anything that
+// must survive a wait is a member of the actor (its frame), never a local declared
+// before the wait in the same block. The compiler rejects an initialised local there
+// ("jump to case label crosses initialization"), but not an uninitialised one, so
+// each run() lists the members it keeps across waits. One ACTOR_AWAIT per line.
+#define ACTOR_BEGIN switch (resumePoint_) { case 0:
+#define ACTOR_AWAIT(ready) \
+    do { resumePoint_ = __LINE__; ACTOR_FALLTHROUGH; case __LINE__: if (!(ready)) return; } while (0)
+#define ACTOR_END } finished_ = true
+
+// Falling into the resume label is intended; say so for -Wimplicit-fallthrough
+// ([[fallthrough]] needs C++17).
+#if defined(__has_attribute)
+#if __has_attribute(fallthrough)
+#define ACTOR_FALLTHROUGH __attribute__((fallthrough))
+#endif
+#endif
+#ifndef ACTOR_FALLTHROUGH
+#define ACTOR_FALLTHROUGH do {} while (0)
+#endif
+
+class ActorExecutor;
+
+class Actor {
+public:
+    Actor();
+    virtual ~Actor() {}
+
+    // Resume from the last ACTOR_AWAIT (or the top on the first call).
+    virtual void run() = 0;
+
+    bool finished() const { return finished_; }
+
+protected:
+    // Awaitables: each returns true once the wait is over. The first call that
+    // returns false arms the wait; the executor resumes the actor when it ends.
+    // Message waits also end once the executor is shutting down.
+    bool sleepFor(long ms);
+    bool message();                   // A message is waiting
+    bool messageOrTimeout(long ms);   // A message is waiting, or ms have passed
+
+    bool hasMessage() const { return mailHead_ < mailbox_.size(); }
+
+    // The executor has been asked to shut down: finish the current work and return.
+    bool stopping() const;
+
+    // Pop the next message. from is set when it arrived on a watched socket.
+    bool takeMessage(ElevatorMessage &msg, struct sockaddr_in *from = nullptr);
+
+    long now() const;   // Executor clock, milliseconds
+
+    int resumePoint_;
+    bool finished_;
+
+private:
+    friend class ActorExecutor;
+
+    struct Mail {
+        ElevatorMessage msg;
+        struct sockaddr_in from;   // sin_family 0 when posted in-process
+    };
+
+    void deliver(const Mail &mail);
+
+    ActorExecutor *executor_;
+    uint64_t timerId_;          // Armed timer, 0 if none
+    bool timerFired_;
+    bool waitingForMessage_;
+    bool queued_;               // In the executor's ready list
+    int watchedFd_;
+    std::vector<Mail> mailbox_;
+    size_t mailHead_;
+};
+
+// Runs many actors on the calling thread: a ready list, a timer heap and an epoll
+// set over the actors' sockets. Not thread safe; use one executor per thread and
+// give each actor to exactly one of them.
+//
+// With simulatedTime the clock jumps straight to the next timer whenever every
+// actor is waiting, so a run takes as long as the work in it rather than the
+// wall-clock time it models.
+//
+// An idle executor blocks in epoll_wait until a socket, a timer or shutdown()
+// needs it; nothing polls.
+class ActorExecutor {
+public:
+    explicit ActorExecutor(bool simulatedTime = false);
+    ~ActorExecutor();
+
+    ActorExecutor(const ActorExecutor &) = delete;
+    ActorExecutor &operator=(const ActorExecutor &) = delete;
+
+    void spawn(Actor &actor);
+
+    // Deliver every ElevatorMessage datagram arriving on fd to actor's mailbox.
+    bool watch(Actor &actor, int fd);
+
+    // In-process delivery, e.g. from a driver in a simulation.
+    void post(Actor &actor, const ElevatorMessage &msg);
+
+    // Run until every spawned actor has finished (or nothing can wake them).
+    void run() { runUntil(-1); }
+
+    // Run until the clock reaches now() + ms.
+    void runFor(long ms) { runUntil(now() + ms); }
+
+    long now() const;
+
+    // Ask every actor to stop: message waits end and stopping() turns true, and run()
+    // returns once the actors have finished. Safe to call from any thread.
+    void shutdown();
+
+    uint64_t resumes() const { return resumes_; }
+
+private:
+    friend class Actor;
+
+    struct Timer {
+        long at;
+        uint64_t id;
+        Actor *actor;
+        bool operator>(const Timer &other) const { return at != other.at ? at > other.at : id > other.id; }
+    };
+
+    void runUntil(long limit);
+    void arm(Actor &actor, long at);
+    void cancel(Actor &actor) { actor.timerId_ = 0; }
+    void wake(Actor &actor);
+    void fireTimers();
+    void pollSockets(long timeoutMs);
+    void retire(Actor &actor);
+    void stopActors();
+
+    bool simulated_;
+    long simNow_;
+    std::chrono::steady_clock::time_point start_;
+    int epollFd_;
+    int wakeFd_;                // eventfd in the epoll set; shutdown() writes to it
+    std::atomic<bool> stopping_;
+    bool stopped_;              // stopActors() has run
+    int watched_;
+    int live_;
+    uint64_t nextTimerId_;
+    uint64_t resumes_;
+    std::vector<Actor*> actors_;
+    std::vector<Actor*> ready_;
+    std::vector<Actor*> running_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+};
+
+#endif // ACTOR_HPP
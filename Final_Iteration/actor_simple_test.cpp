@@ -0,0 +1,214 @@
+// actor_simple_test.cpp
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "actor.hpp"
+#include "elevator.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+// Sleeps `naps` times and records the clock after each one.
+class Sleeper : public Actor {
+public:
+    Sleeper(long napMs, int naps) : napMs_(napMs), naps_(naps), done_(0) {}
+    std::vector<long> wakeTimes;
+
+    void run() override {
+        ACTOR_BEGIN;
+        for (done_ = 0; done_ < naps_; done_++) {
+            ACTOR_AWAIT(sleepFor(napMs_));
+            wakeTimes.push_back(now());
+        }
+        ACTOR_END;
+    }
+
+private:
+    long napMs_;
+    int naps_;
+    int done_;
+};
+
+// Waits twice for a message with a timeout and records what happened.
+class Listener : public Actor {
+public:
+    std::vector<long> wakeTimes;
+    std::vector<int> floors;   // -1 for a timeout
+
+    void run() override {
+        ACTOR_BEGIN;
+        ACTOR_AWAIT(messageOrTimeout(1000));
+        record();
+        ACTOR_AWAIT(messageOrTimeout(1000));
+        record();
+        ACTOR_END;
+    }
+
+private:
+    void record() {
+        ElevatorMessage msg;
+        wakeTimes.push_back(now());
+        floors.push_back(takeMessage(msg) ? msg.floorNumber : -1);
+    }
+};
+
+// Takes messages until its executor shuts down. Kept across waits: received.
+class Waiter : public Actor {
+public:
+    Waiter() : received(0) {}
+    int received;
+
+    void run() override {
+        ACTOR_BEGIN;
+        while (!stopping()) {
+            ACTOR_AWAIT(message());
+            ElevatorMessage msg;
+            if (takeMessage(msg)) received++;
+        }
+        ACTOR_END;
+    }
+};
+
+// Sends the listener one message after a delay.
+class Sender : public Actor {
+public:
+    Sender(ActorExecutor &executor, Actor &target) : executor_(executor), target_(target) {}
+
+    void run() override {
+        ACTOR_BEGIN;
+        ACTOR_AWAIT(sleepFor(300));
+        executor_.post(target_, ElevatorMessage(7, 9, true, 0, 0));
+        ACTOR_END;
+    }
+
+private:
+    ActorExecutor &executor_;
+    Actor &target_;
+};
+
+// Test timers on a simulated clock
+int testSleep() {
+    std::cout << "\n=== Testing Actor Timers ===" << std::endl;
+
+    std::cout << "  Test Case 1: Two sleepers interleave on one executor" << std::endl;
+    ActorExecutor executor(true);
+    Sleeper fast(100, 3), slow(250, 2);
+    executor.spawn(fast);
+    executor.spawn(slow);
+    executor.run();
+    TEST_ASSERT(fast.finished() && slow.finished(), "Both actors should run to the end");
+    TEST_ASSERT(fast.wakeTimes == std::vector<long>({100, 200, 300}), "Fast sleeper should wake every 100 ms");
+    TEST_ASSERT(slow.wakeTimes == std::vector<long>({250, 500}), "Slow sleeper should wake every 250 ms");
+    TEST_ASSERT(executor.now() == 500, "Simulated clock should stop at the last timer");
+
+    std::cout << "  Test Case 2: runFor stops at the limit and resumes later" << std::endl;
+    ActorExecutor limited(true);
+    Sleeper sleeper(100, 5);
+    limited.spawn(sleeper);
+    limited.runFor(250);
+    TEST_ASSERT(sleeper.wakeTimes.size() == 2 && limited.now() == 250, "Only two naps should fit in 250 ms");
+    limited.run();
+    TEST_ASSERT(sleeper.finished() && sleeper.wakeTimes.back() == 500, "The rest should run after resuming");
+
+    std::cout << "Actor Timers: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test waiting for messages
+int testMessages() {
+    std::cout << "\n=== Testing Actor Messages ===" << std::endl;
+
+    std::cout << "  Test Case 1: A message ends the wait early, then the wait times out" << std::endl;
+    ActorExecutor executor(true);
+    Listener listener;
+    Sender sender(executor, listener);
+    executor.spawn(listener);
+    executor.spawn(sender);
+    executor.run();
+    TEST_ASSERT(listener.finished(), "Listener should finish");
+    TEST_ASSERT(listener.wakeTimes[0] == 300 && listener.floors[0] == 7, "First wait should end with the message at 300 ms");
+    TEST_ASSERT(listener.wakeTimes[1] == 1300 && listener.floors[1] == -1, "Second wait should time out at 1300 ms");
+
+    std::cout << "  Test Case 2: shutdown() from another thread ends a wait that has no timer" << std::endl;
+    ActorExecutor live;
+    Waiter waiter;
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    live.spawn(waiter);
+    TEST_ASSERT(live.watch(waiter, fd), "Waiter should watch an unbound socket");
+    std::thread stopper([&live]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        live.shutdown();
+    });
+    auto start = std::chrono::steady_clock::now();
+    live.run();
+    long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    stopper.join();
+    close(fd);
+    TEST_ASSERT(waiter.finished() && waiter.received == 0, "Waiter should finish without a message");
+    TEST_ASSERT(live.resumes() == 2 && elapsed < 1000, "Waiter should run once at spawn and once at shutdown");
+
+    std::cout << "Actor Messages: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test an elevator actor serving a call without sockets
+int testElevatorActor() {
+    std::cout << "\n=== Testing Elevator Actor ===" << std::endl;
+
+    std::cout << "  Test Case 1: Car serves floor 3 to floor 6 in simulated time" << std::endl;
+    ActorExecutor executor(true);
+    ElevatorActor car(0, -1);
+    executor.spawn(car);
+    ElevatorMessage request(3, 6, true, 0, 0);
+    executor.post(car, request);
+    // Two floors to the pickup, three to the destination, a door cycle at each.
+    executor.runFor(1000 * (2 + 3 + 2 * (DOOR_OPEN_TICKS + DOOR_CLOSE_TICKS)));
+    TEST_ASSERT(car.car().floor == 6 && car.car().state == IDLE, "Car should be idle at floor 6");
+    TEST_ASSERT(!car.finished(), "Car should keep waiting for work");
+
+    std::cout << "  Test Case 2: An idle car is not resumed while it waits" << std::endl;
+    uint64_t resumes = executor.resumes();
+    executor.runFor(60000);
+    TEST_ASSERT(executor.resumes() == resumes && !car.finished(), "A minute idle should not wake the car");
+
+    std::cout << "  Test Case 3: Car stops when the executor shuts down" << std::endl;
+    executor.shutdown();
+    executor.run();
+    TEST_ASSERT(car.finished(), "Car should finish once the executor shuts down");
+
+    std::cout << "Elevator Actor: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING ACTOR TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testSleep();
+    failures += testMessages();
+    failures += testElevatorActor();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " ACTOR TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " ACTOR TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
@@ -0,0 +1,88 @@
+/* batch_dispatch.cpp */
+#include "batch_dispatch.hpp"
+#include <algorithm>
+#include <limits>
+
+// Shortest augmenting path Hungarian algorithm for n <= m, O(n^2 m).
+// a is 1-indexed: a[i * (m + 1) + j] for 1 <= i <= n, 1 <= j <= m.
+static std::vector<int> hungarian(const std::vector<int> &a, int n, int m) {
+    const int INF = std::numeric_limits<int>::max() / 2;
+    std::vector<int> u(n + 1, 0), v(m + 1, 0), p(m + 1, 0), way(m + 1, 0);
+    std::vector<int> minv(m + 1);
+    std::vector<char> used(m + 1);
+
+    for (int i = 1; i <= n; i++) {
+        p[0] = i;
+        int j0 = 0;
+        std::fill(minv.begin(), minv.end(), INF);
+        std::fill(used.begin(), used.end(), 0);
+        do {
+            used[j0] = 1;
+            int i0 = p[j0];
+            int delta = INF;
+            int j1 = 0;
+            const int *row = &a[i0 * (m + 1)];
+            for (int j = 1; j <= m; j++) {
+                if (used[j]) continue;
+                int cur = row[j] - u[i0] - v[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= m; j++) {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0);
+    }
+
+    // p[j] = row matched to column j; invert to row -> column.
+    std::vector<int> match(n + 1, -1);
+    for (int j = 1; j <= m; j++) {
+        if (p[j] != 0) match[p[j]] = j;
+    }
+    return match;
+}
+
+std::vector<int> solveAssignment(const std::vector<int> &cost, int rows, int cols) {
+    std::vector<int> result(rows, -1);
+    if (rows == 0 || cols == 0) return result;
+
+    // The solver needs the smaller side as rows, so transpose if necessary.
+    bool transposed = rows > cols;
+    int n = transposed ? cols : rows;
+    int m = transposed ? rows : cols;
+    std::vector<int> a((n + 1) * (m + 1), 0);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            int i = transposed ? c : r;
+            int j = transposed ? r : c;
+            a[(i + 1) * (m + 1) + (j + 1)] = cost[r * cols + c];
+        }
+    }
+
+    std::vector<int> match = hungarian(a, n, m);
+    for (int i = 1; i <= n; i++) {
+        int j = match[i];
+        if (j < 1) continue;
+        int r = transposed ? j - 1 : i - 1;
+        int c = transposed ? i - 1 : j - 1;
+        if (cost[r * cols + c] < ETA_UNREACHABLE) result[r] = c;
+    }
+    return result;
+}
@@ -0,0 +1,17 @@
+#ifndef BATCH_DISPATCH_HPP
+#define BATCH_DISPATCH_HPP
+
+#include <vector>
+
+#define BATCH_WINDOW_MS 300         // Hall calls arriving within this window are assigned together
+#define ETA_SECONDS_PER_FLOOR 1     // Matches FLOOR_TRAVEL_TIME in elevator.cpp
+#define ETA_SECONDS_PER_TRIP 4      // Door cycles at pickup and destination
+#define ETA_UNREACHABLE 1000000     // Cost of a car that cannot take the call
+
+// Minimum-cost assignment (Hungarian algorithm) over a row-major rows x cols
+// cost matrix. Every row of the smaller side is matched to a distinct entry
+// of the larger side. Returns, for each row, its column, or -1 if unmatched.
+// Pairs whose cost is ETA_UNREACHABLE or more are reported as unmatched.
+std::vector<int> solveAssignment(const std::vector<int> &cost, int rows, int cols);
+
+#endif // BATCH_DISPATCH_HPP
@@ -0,0 +1,129 @@
+// batch_dispatch_simple_test.cpp
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include "batch_dispatch.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+// Total cost of an assignment, counting each matched row once
+static int totalCost(const std::vector<int> &cost, int cols, const std::vector<int> &match) {
+    int total = 0;
+    for (size_t r = 0; r < match.size(); r++) {
+        if (match[r] >= 0) total += cost[r * cols + match[r]];
+    }
+    return total;
+}
+
+// Cheapest cost over every way to give each of the 3 rows a distinct column
+static int bruteForce(const std::vector<int> &cost, int cols) {
+    std::vector<int> perm(cols);
+    for (int c = 0; c < cols; c++) perm[c] = c;
+    int best = 1 << 30;
+    do {
+        best = std::min(best, cost[0 * cols + perm[0]] + cost[1 * cols + perm[1]] + cost[2 * cols + perm[2]]);
+    } while (std::next_permutation(perm.begin(), perm.end()));
+    return best;
+}
+
+// Test that the greedy trap is avoided
+int testJointAssignment() {
+    std::cout << "\n=== Testing Joint Assignment ===" << std::endl;
+
+    std::cout << "  Test Case 1: Greedy would pick the wrong pairing" << std::endl;
+    // Car 0 is close to both calls; car 1 is only close to call 0.
+    std::vector<int> cost = {1, 2,
+                             2, 9};
+    std::vector<int> match = solveAssignment(cost, 2, 2);
+    TEST_ASSERT(match[0] == 1 && match[1] == 0, "Car 0 should take call 1 and car 1 call 0");
+
+    std::cout << "  Test Case 2: More calls than cars" << std::endl;
+    std::vector<int> wide = {5, 1, 7,
+                             2, 3, 9};
+    match = solveAssignment(wide, 2, 3);
+    TEST_ASSERT(match[0] == 1 && match[1] == 0, "Each car should get its cheapest compatible call");
+
+    std::cout << "  Test Case 3: Unreachable pairs stay unmatched" << std::endl;
+    std::vector<int> blocked = {ETA_UNREACHABLE, ETA_UNREACHABLE,
+                                4, 6};
+    match = solveAssignment(blocked, 2, 2);
+    TEST_ASSERT(match[0] == -1 && match[1] == 0, "Faulted car 0 should get nothing");
+
+    std::cout << "Joint Assignment: All tests passed" << std::endl;
+    return 0;
+}
+
+// Compare against brute force on random 3 x 6 matrices
+int testOptimality() {
+    std::cout << "\n=== Testing Optimality ===" << std::endl;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(0, 50);
+    for (int trial = 0; trial < 200; trial++) {
+        std::vector<int> cost(3 * 6);
+        for (auto &c : cost) c = dist(gen);
+        std::vector<int> match = solveAssignment(cost, 3, 6);
+        if (totalCost(cost, 6, match) != bruteForce(cost, 6)) {
+            TEST_ASSERT(false, "Solver cost should equal brute force on trial " << trial);
+        }
+    }
+    TEST_ASSERT(true, "200 random matrices solved optimally");
+
+    std::cout << "Optimality: All tests passed" << std::endl;
+    return 0;
+}
+
+// Time the 64 cars x 200 calls case
+int testSolveTime() {
+    std::cout << "\n=== Testing Solve Time (64 cars x 200 calls) ===" << std::endl;
+    std::mt19937 gen(3303);
+    std::uniform_int_distribution<int> dist(0, 120);
+    std::vector<int> cost(64 * 200);
+    for (auto &c : cost) c = dist(gen);
+
+    const int runs = 200;
+    auto start = std::chrono::steady_clock::now();
+    int checksum = 0;
+    for (int i = 0; i < runs; i++) {
+        cost[i % cost.size()] = dist(gen);
+        checksum += solveAssignment(cost, 64, 200)[0];
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "    Average solve time: " << elapsed.count() / runs << " us (checksum " << checksum << ")" << std::endl;
+    TEST_ASSERT(elapsed.count() / runs < 1000, "Solve should take under a millisecond");
+
+    std::cout << "Solve Time: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING BATCH DISPATCH TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testJointAssignment();
+    failures += testOptimality();
+    failures += testSolveTime();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " BATCH DISPATCH TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " BATCH DISPATCH TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
@@ -0,0 +1,278 @@
+#ifndef CAR_STATE_MACHINE_HPP
+#define CAR_STATE_MACHINE_HPP
+
+#include "message.hpp"
+#include <cstdint>
+
+// One tick is one second of simulated time: a floor of travel, or one second of a door phase.
+#define DOOR_OPEN_TICKS 1       // Doors stay open this long at a stop
+#define DOOR_CLOSE_TICKS 1      // ... and take this long to close
+#define DOOR_FAULT_TICKS 5      // Doors held open before a door fault is reported
+#define STUCK_FAULT_TICKS 10    // Car held between floors before a stuck fault is reported
+
+#define CAR_STATE_COUNT 4       // IDLE, DOOR_OPEN, DOOR_CLOSED, MOVING (message.hpp)
+#define CAR_MAX_ALTERNATIVES 5  // Guarded transitions per (state, event), tried in order
+
+enum CarEvent {
+    CAR_TICK,           // One tick has passed
+    CAR_GO,             // Serve a stop at target: travel there, then cycle the doors
+    CAR_PARK,           // Reposition to target with the doors shut
+    CAR_STOP,           // Abandon a parking move (new work arrived)
+    CAR_DOOR_FAULT,     // Injected fault: doors jam open
+    CAR_STUCK_FAULT,    // Injected fault: car jams between floors
+    CAR_EVENT_COUNT
+};
+
+enum CarGuard {
+    GUARD_ALWAYS,
+    GUARD_AT_TARGET,
+    GUARD_AWAY,             // Not at target
+    GUARD_TIMER_RUNNING,    // Current phase lasts beyond this tick
+    GUARD_FAULTED,
+    GUARD_PARKING,
+    GUARD_ARRIVING,         // The next floor is the target
+    GUARD_ARRIVING_TO_PARK
+};
+
+enum CarAction {
+    ACTION_REJECTED,        // No transition: the event is ignored in this state
+    ACTION_NONE,
+    ACTION_DEPART,          // Head for target (no floor moved yet)
+    ACTION_DEPART_TO_PARK,
+    ACTION_OPEN_DOORS,
+    ACTION_MOVE,            // Moved one floor
+    ACTION_MOVE_AND_OPEN,   // Moved onto the target floor and opened the doors
+    ACTION_MOVE_AND_PARK,   // Moved onto the parking floor
+    ACTION_COUNT_DOWN,
+    ACTION_CLOSE_DOORS,
+    ACTION_FINISH_STOP,     // Doors shut after a stop; the car is free again
+    ACTION_HALT,            // Parking move abandoned where the car is
+    ACTION_HOLD_DOORS,
+    ACTION_JAM,
+    ACTION_REPORT_FAULT,    // Fault hold is over; the runtime reports it
+    CAR_ACTION_COUNT
+};
+
+// Everything the state machine knows about one car; small enough to keep thousands in cache.
+struct CarMotion {
+    int16_t floor;
+    int16_t target;
+    uint8_t state;      // ElevatorState
+    int8_t direction;   // +1 up, -1 down, 0 stopped
+    uint8_t timer;      // Ticks left in the current door or fault phase
+    uint8_t flags;      // CAR_PARKING | CAR_FAULTED
+};
+
+#define CAR_PARKING 1
+#define CAR_FAULTED 2
+
+struct CarTransition {
+    uint8_t guard;
+    uint8_t action;
+    uint8_t next;
+};
+
+// What one step did, for the runtime to turn into messages, traces and logs.
+struct CarStep {
+    CarAction action;
+    ElevatorState from;
+    ElevatorState to;
+};
+
+// Transitions indexed by [state][event]; alternatives are tried in order and the first
+// whose guard holds is taken. Unused slots are {0, ACTION_REJECTED, 0}.
+constexpr CarTransition CAR_TRANSITIONS[CAR_STATE_COUNT][CAR_EVENT_COUNT][CAR_MAX_ALTERNATIVES] = {
+    { // IDLE
+        /* TICK */        {{GUARD_ALWAYS, ACTION_NONE, IDLE}},
+        /* GO */          {{GUARD_AWAY, ACTION_DEPART, MOVING},
+                           {GUARD_ALWAYS, ACTION_OPEN_DOORS, DOOR_OPEN}},
+        /* PARK */        {{GUARD_AWAY, ACTION_DEPART_TO_PARK, MOVING},
+                           {GUARD_ALWAYS, ACTION_NONE, IDLE}},
+        /* STOP */        {{GUARD_ALWAYS, ACTION_NONE, IDLE}},
+        /* DOOR_FAULT */  {{GUARD_ALWAYS, ACTION_HOLD_DOORS, DOOR_OPEN}},
+        /* STUCK_FAULT */ {{GUARD_ALWAYS, ACTION_JAM, MOVING}},
+    },
+    { // DOOR_OPEN
+        /* TICK */        {{GUARD_TIMER_RUNNING, ACTION_COUNT_DOWN, DOOR_OPEN},
+                           {GUARD_FAULTED, ACTION_REPORT_FAULT, IDLE},
+                           {GUARD_ALWAYS, ACTION_CLOSE_DOORS, DOOR_CLOSED}},
+        /* GO */          {},
+        /* PARK */        {},
+        /* STOP */        {},
+        /* DOOR_FAULT */  {},
+        /* STUCK_FAULT */ {},
+    },
+    { // DOOR_CLOSED
+        /* TICK */        {{GUARD_TIMER_RUNNING, ACTION_COUNT_DOWN, DOOR_CLOSED},
+                           {GUARD_ALWAYS, ACTION_FINISH_STOP, IDLE}},
+        /* GO */          {},
+        /* PARK */        {},
+        /* STOP */        {},
+        /* DOOR_FAULT */  {},
+        /* STUCK_FAULT */ {},
+    },
+    { // MOVING
+        /* TICK */        {{GUARD_TIMER_RUNNING, ACTION_COUNT_DOWN, MOVING},
+                           {GUARD_FAULTED, ACTION_REPORT_FAULT, IDLE},
+                           {GUARD_ARRIVING_TO_PARK, ACTION_MOVE_AND_PARK, IDLE},
+                           {GUARD_ARRIVING, ACTION_MOVE_AND_OPEN, DOOR_OPEN},
+                           {GUARD_ALWAYS, ACTION_MOVE, MOVING}},
+        /* GO */          {},
+        /* PARK */        {},
+        /* STOP */        {{GUARD_PARKING, ACTION_HALT, IDLE}},
+        /* DOOR_FAULT */  {},
+        /* STUCK_FAULT */ {},
+    },
+};
+
+// Compile-time checks on CAR_TRANSITIONS.
+namespace car_table_check {
+
+constexpr const CarTransition &at(int s, int e, int i) { return CAR_TRANSITIONS[s][e][i]; }
+constexpr bool used(int s, int e, int i) { return at(s, e, i).action != ACTION_REJECTED; }
+
+// State an action must lead to, or -1 if it may stay put (none/count-down).
+constexpr int actionTarget(int action) {
+    return action == ACTION_DEPART || action == ACTION_DEPART_TO_PARK || action == ACTION_MOVE ||
+                   action == ACTION_JAM ? MOVING
+         : action == ACTION_OPEN_DOORS || action == ACTION_MOVE_AND_OPEN || action == ACTION_HOLD_DOORS ? DOOR_OPEN
+         : action == ACTION_CLOSE_DOORS ? DOOR_CLOSED
+         : action == ACTION_MOVE_AND_PARK || action == ACTION_FINISH_STOP || action == ACTION_HALT ||
+                   action == ACTION_REPORT_FAULT ? IDLE
+         : -1;
+}
+
+// Each used slot has a valid target consistent with its action; used slots come first;
+// nothing follows an unconditional slot (it could never be taken).
+constexpr bool slotsValid(int s, int e, int i) {
+    return i == CAR_MAX_ALTERNATIVES ? true
+         : !used(s, e, i) ? (i + 1 == CAR_MAX_ALTERNATIVES || !used(s, e, i + 1)) && slotsValid(s, e, i + 1)
+         : at(s, e, i).next < CAR_STATE_COUNT && at(s, e, i).action < CAR_ACTION_COUNT &&
+           (actionTarget(at(s, e, i).action) == -1 || actionTarget(at(s, e, i).action) == at(s, e, i).next) &&
+           (at(s, e, i).guard != GUARD_ALWAYS || i + 1 == CAR_MAX_ALTERNATIVES || !used(s, e, i + 1)) &&
+           slotsValid(s, e, i + 1);
+}
+
+constexpr bool hasFallback(int s, int e, int i) {
+    return i < CAR_MAX_ALTERNATIVES && used(s, e, i) && (at(s, e, i).guard == GUARD_ALWAYS || hasFallback(s, e, i + 1));
+}
+
+constexpr bool tableValid(int s, int e) {
+    return s == CAR_STATE_COUNT ? true
+         : e == CAR_EVENT_COUNT ? tableValid(s + 1, 0)
+         : slotsValid(s, e, 0) && tableValid(s, e + 1);
+}
+
+constexpr bool tickAlwaysHandled(int s) {
+    return s == CAR_STATE_COUNT ? true : hasFallback(s, CAR_TICK, 0) && tickAlwaysHandled(s + 1);
+}
+
+// Can `from` reach `to` within depth transitions, using only event e (or any event if e < 0)?
+constexpr bool reaches(int from, int to, int e, int depth);
+constexpr bool reachesVia(int from, int to, int e, int ev, int i, int depth) {
+    return ev == CAR_EVENT_COUNT ? false
+         : (e >= 0 && ev != e) || i == CAR_MAX_ALTERNATIVES || !used(from, ev, i) ? reachesVia(from, to, e, ev + 1, 0, depth)
+         : reaches(at(from, ev, i).next, to, e, depth - 1) || reachesVia(from, to, e, ev, i + 1, depth);
+}
+constexpr bool reaches(int from, int to, int e, int depth) {
+    return from == to || (depth > 0 && reachesVia(from, to, e, 0, 0, depth));
+}
+
+constexpr bool allReachableFromIdle(int s) {
+    return s == CAR_STATE_COUNT ? true : reaches(IDLE, s, -1, CAR_STATE_COUNT) && allReachableFromIdle(s + 1);
+}
+
+constexpr bool ticksLeadToIdle(int s) {
+    return s == CAR_STATE_COUNT ? true : reaches(s, IDLE, CAR_TICK, CAR_STATE_COUNT) && ticksLeadToIdle(s + 1);
+}
+
+} // namespace car_table_check
+
+static_assert(IDLE == 0 && DOOR_OPEN == 1 && DOOR_CLOSED == 2 && MOVING == 3, "CAR_TRANSITIONS rows follow ElevatorState");
+static_assert(car_table_check::tableValid(0, 0), "a transition has a bad target, a misplaced slot or an unreachable alternative");
+static_assert(car_table_check::tickAlwaysHandled(0), "every state needs an unconditional TICK transition");
+static_assert(car_table_check::allReachableFromIdle(0), "a state cannot be reached from IDLE");
+static_assert(car_table_check::ticksLeadToIdle(0), "a state can never return to IDLE on ticks alone");
+
+inline CarMotion makeCar(int floor) {
+    CarMotion car = {static_cast<int16_t>(floor), static_cast<int16_t>(floor), IDLE, 0, 0, 0};
+    return car;
+}
+
+inline bool carGuardHolds(int guard, const CarMotion &car) {
+    switch (guard) {
+    case GUARD_AT_TARGET: return car.floor == car.target;
+    case GUARD_AWAY: return car.floor != car.target;
+    case GUARD_TIMER_RUNNING: return car.timer > 1;
+    case GUARD_FAULTED: return (car.flags & CAR_FAULTED) != 0;
+    case GUARD_PARKING: return (car.flags & CAR_PARKING) != 0;
+    case GUARD_ARRIVING: return car.floor + car.direction == car.target;
+    case GUARD_ARRIVING_TO_PARK: return (car.flags & CAR_PARKING) && car.floor + car.direction == car.target;
+    default: return true;
+    }
+}
+
+// Apply one event to a car: a table lookup, a guard check per alternative and the action.
+// Never blocks; the caller decides how long a tick lasts.
+inline CarStep carStep(CarMotion &car, CarEvent event) {
+    const CarTransition *t = CAR_TRANSITIONS[car.state][event];
+    CarStep step = {ACTION_REJECTED, static_cast<ElevatorState>(car.state), static_cast<ElevatorState>(car.state)};
+    for (int i = 0; i < CAR_MAX_ALTERNATIVES && t[i].action != ACTION_REJECTED; i++) {
+        if (!carGuardHolds(t[i].guard, car))
+            continue;
+        switch (t[i].action) {
+        case ACTION_DEPART:
+        case ACTION_DEPART_TO_PARK:
+            car.direction = car.target > car.floor ? 1 : -1;
+            car.flags = t[i].action == ACTION_DEPART_TO_PARK ? CAR_PARKING : 0;
+            car.timer = 0;
+            break;
+        case ACTION_MOVE:
+            car.floor += car.direction;
+            break;
+        case ACTION_MOVE_AND_OPEN:
+            car.floor += car.direction;
+            car.direction = 0;
+            car.timer = DOOR_OPEN_TICKS;
+            break;
+        case ACTION_OPEN_DOORS:
+            car.timer = DOOR_OPEN_TICKS;
+            break;
+        case ACTION_MOVE_AND_PARK:
+            car.floor += car.direction;
+            car.direction = 0;
+            car.flags = 0;
+            break;
+        case ACTION_COUNT_DOWN:
+            car.timer--;
+            break;
+        case ACTION_CLOSE_DOORS:
+            car.timer = DOOR_CLOSE_TICKS;
+            break;
+        case ACTION_HALT:
+        case ACTION_FINISH_STOP:
+        case ACTION_REPORT_FAULT:
+            car.direction = 0;
+            car.flags = 0;
+            car.timer = 0;
+            break;
+        case ACTION_HOLD_DOORS:
+            car.flags = CAR_FAULTED;
+            car.timer = DOOR_FAULT_TICKS;
+            break;
+        case ACTION_JAM:
+            car.flags = CAR_FAULTED;
+            car.timer = STUCK_FAULT_TICKS;
+            break;
+        default:
+            break;
+        }
+        car.state = t[i].next;
+        step.action = static_cast<CarAction>(t[i].action);
+        step.to = static_cast<ElevatorState>(car.state);
+        return step;
+    }
+    return step;
+}
+
+#endif // CAR_STATE_MACHINE_HPP
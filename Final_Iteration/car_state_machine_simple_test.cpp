@@ -0,0 +1,129 @@
+// car_state_machine_simple_test.cpp
+#include <iostream>
+#include "car_state_machine.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+// Tick until the car is idle again; returns the number of ticks, or -1 if it never settles.
+static int tickUntilIdle(CarMotion &car, int &moves, int &doorOpens) {
+    moves = 0;
+    doorOpens = 0;
+    for (int ticks = 1; ticks <= 100; ticks++) {
+        CarStep step = carStep(car, CAR_TICK);
+        if (step.action == ACTION_MOVE || step.action == ACTION_MOVE_AND_OPEN || step.action == ACTION_MOVE_AND_PARK)
+            moves++;
+        if (step.action == ACTION_MOVE_AND_OPEN)
+            doorOpens++;
+        if (car.state == IDLE)
+            return ticks;
+    }
+    return -1;
+}
+
+// Test a stop: travel, doors open, doors close, idle
+int testServeStop() {
+    std::cout << "\n=== Testing Serving a Stop ===" << std::endl;
+    int moves, doorOpens;
+
+    std::cout << "  Test Case 1: Travel from floor 2 up to floor 6" << std::endl;
+    CarMotion car = makeCar(2);
+    car.target = 6;
+    CarStep step = carStep(car, CAR_GO);
+    TEST_ASSERT(step.action == ACTION_DEPART && car.state == MOVING && car.direction == 1, "GO should start the car moving up");
+    TEST_ASSERT(car.floor == 2, "Departing should not move a floor yet");
+    int ticks = tickUntilIdle(car, moves, doorOpens);
+    TEST_ASSERT(car.floor == 6 && moves == 4 && doorOpens == 1, "Car should move four floors and open once at floor 6");
+    TEST_ASSERT(ticks == 4 + DOOR_OPEN_TICKS + DOOR_CLOSE_TICKS, "Trip should take one tick per floor plus the door cycle");
+
+    std::cout << "  Test Case 2: A stop at the current floor only cycles the doors" << std::endl;
+    step = carStep(car, CAR_GO);
+    TEST_ASSERT(step.action == ACTION_OPEN_DOORS && car.state == DOOR_OPEN, "GO at the target should open the doors");
+    TEST_ASSERT(carStep(car, CAR_TICK).action == ACTION_CLOSE_DOORS && car.state == DOOR_CLOSED, "Doors should close after DOOR_OPEN_TICKS");
+    TEST_ASSERT(carStep(car, CAR_TICK).action == ACTION_FINISH_STOP && car.state == IDLE, "Car should be idle after the doors close");
+
+    std::cout << "  Test Case 3: Busy cars ignore new work" << std::endl;
+    car.target = 1;
+    carStep(car, CAR_GO);
+    TEST_ASSERT(carStep(car, CAR_GO).action == ACTION_REJECTED, "A moving car should reject another GO");
+    TEST_ASSERT(carStep(car, CAR_STOP).action == ACTION_REJECTED, "Only a parking move can be stopped");
+    TEST_ASSERT(carStep(car, CAR_TICK).action == ACTION_MOVE && car.floor == 5 && car.direction == -1, "Car should move down a floor");
+
+    std::cout << "Serving a Stop: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test parking moves and interrupting them
+int testParking() {
+    std::cout << "\n=== Testing Parking ===" << std::endl;
+    int moves, doorOpens;
+
+    std::cout << "  Test Case 1: Park with the doors shut" << std::endl;
+    CarMotion car = makeCar(1);
+    car.target = 4;
+    TEST_ASSERT(carStep(car, CAR_PARK).action == ACTION_DEPART_TO_PARK, "PARK should start a parking move");
+    int ticks = tickUntilIdle(car, moves, doorOpens);
+    TEST_ASSERT(ticks == 3 && car.floor == 4 && doorOpens == 0, "Car should reach floor 4 in three ticks without opening");
+    TEST_ASSERT(car.flags == 0, "Parking flag should be cleared on arrival");
+
+    std::cout << "  Test Case 2: STOP halts a parking move where the car is" << std::endl;
+    car.target = 10;
+    carStep(car, CAR_PARK);
+    carStep(car, CAR_TICK);
+    TEST_ASSERT(carStep(car, CAR_STOP).action == ACTION_HALT && car.state == IDLE && car.floor == 5, "Car should halt at floor 5");
+    car.target = 5;
+    TEST_ASSERT(carStep(car, CAR_PARK).action == ACTION_NONE && car.state == IDLE, "Parking at the current floor is a no-op");
+
+    std::cout << "Parking: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test injected faults
+int testFaults() {
+    std::cout << "\n=== Testing Faults ===" << std::endl;
+    int moves, doorOpens;
+
+    std::cout << "  Test Case 1: Door fault holds the doors for DOOR_FAULT_TICKS" << std::endl;
+    CarMotion car = makeCar(3);
+    TEST_ASSERT(carStep(car, CAR_DOOR_FAULT).action == ACTION_HOLD_DOORS && car.state == DOOR_OPEN, "Doors should be held open");
+    int ticks = tickUntilIdle(car, moves, doorOpens);
+    TEST_ASSERT(ticks == DOOR_FAULT_TICKS && moves == 0 && car.flags == 0, "Fault should be reported after DOOR_FAULT_TICKS");
+
+    std::cout << "  Test Case 2: Stuck fault holds the car for STUCK_FAULT_TICKS" << std::endl;
+    TEST_ASSERT(carStep(car, CAR_STUCK_FAULT).action == ACTION_JAM && car.state == MOVING, "Car should be jammed");
+    ticks = tickUntilIdle(car, moves, doorOpens);
+    TEST_ASSERT(ticks == STUCK_FAULT_TICKS && moves == 0 && car.floor == 3, "Car should not move while stuck");
+
+    std::cout << "Faults: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING CAR STATE MACHINE TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testServeStop();
+    failures += testParking();
+    failures += testFaults();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " CAR STATE MACHINE TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " CAR STATE MACHINE TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
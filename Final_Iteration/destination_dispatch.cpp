@@ -0,0 +1,70 @@
+/* destination_dispatch.cpp */
+#include "destination_dispatch.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+std::vector<TripGroup> groupCalls(const std::vector<ElevatorMessage> &calls, int maxSpan, int maxPersons) {
+    CallGrouping grouping;
+    groupCalls(calls, maxSpan, maxPersons, grouping);
+    grouping.groups.resize(grouping.count);
+    return grouping.groups;
+}
+
+void groupCalls(const std::vector<ElevatorMessage> &calls, int maxSpan, int maxPersons, CallGrouping &grouping) {
+    // Order calls by origin, direction, then destination in the order the car will stop;
+    // equal calls keep their arrival order.
+    std::vector<int> &order = grouping.order;
+    order.resize(calls.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = static_cast<int>(i);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        const ElevatorMessage &x = calls[a];
+        const ElevatorMessage &y = calls[b];
+        if (x.floorNumber != y.floorNumber) return x.floorNumber < y.floorNumber;
+        if (x.directionUp != y.directionUp) return x.directionUp;
+        if (x.destination != y.destination)
+            return x.directionUp ? x.destination < y.destination : x.destination > y.destination;
+        return a < b;
+    });
+
+    std::vector<TripGroup> &groups = grouping.groups;
+    size_t &count = grouping.count;
+    count = 0;
+    for (int index : order) {
+        const ElevatorMessage &call = calls[index];
+        bool joined = false;
+        if (count > 0) {
+            TripGroup &last = groups[count - 1];
+            const ElevatorMessage &first = calls[last.members.front()];
+            joined = last.origin == call.floorNumber &&
+                     last.directionUp == call.directionUp &&
+                     std::abs(call.destination - first.destination) <= maxSpan &&
+                     last.passengers + call.passengers <= maxPersons;
+            if (joined) {
+                last.members.push_back(index);
+                last.passengers += call.passengers;
+            }
+        }
+        if (!joined) {
+            if (count == groups.size())
+                groups.push_back(TripGroup());
+            TripGroup &group = groups[count++];
+            group.origin = call.floorNumber;
+            group.directionUp = call.directionUp;
+            group.passengers = call.passengers;
+            group.members.clear();
+            group.members.push_back(index);
+        }
+    }
+}
+
+int countStops(const std::vector<ElevatorMessage> &calls, const TripGroup &group) {
+    int stops = 0;
+    int lastFloor = -1;
+    for (int index : group.members) {
+        if (calls[index].destination != lastFloor) {
+            stops++;
+            lastFloor = calls[index].destination;
+        }
+    }
+    return stops;
+}
@@ -0,0 +1,38 @@
+#ifndef DESTINATION_DISPATCH_HPP
+#define DESTINATION_DISPATCH_HPP
+
+#include "message.hpp"
+#include <cstddef>
+#include <vector>
+
+#define GROUP_DESTINATION_SPAN 3    // Destinations at most this many floors apart share a car
+
+// Passengers from one origin, travelling the same way, bound for nearby floors.
+struct TripGroup {
+    int origin;
+    bool directionUp;
+    int passengers;             // Total passengers across all members
+    std::vector<int> members;   // Indices into the call list, in visiting order
+};
+
+// Group destination calls: same origin and direction, destinations within
+// maxSpan floors of the group's first stop, and at most maxPersons per group.
+std::vector<TripGroup> groupCalls(const std::vector<ElevatorMessage> &calls, int maxSpan, int maxPersons);
+
+// Storage for groupCalls() that is reused from call to call: groups past count
+// are left over from earlier calls and keep their member vectors' capacity.
+struct CallGrouping {
+    std::vector<int> order;
+    std::vector<TripGroup> groups;
+    size_t count;               // groups[0, count) are the result
+
+    CallGrouping() : count(0) {}
+};
+
+// As above, into grouping; allocates only when grouping has to grow.
+void groupCalls(const std::vector<ElevatorMessage> &calls, int maxSpan, int maxPersons, CallGrouping &grouping);
+
+// Number of distinct destination stops a group makes.
+int countStops(const std::vector<ElevatorMessage> &calls, const TripGroup &group);
+
+#endif // DESTINATION_DISPATCH_HPP
@@ -0,0 +1,82 @@
+// destination_dispatch_simple_test.cpp
+#include <iostream>
+#include <vector>
+#include "destination_dispatch.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+// Test grouping by origin, direction and nearby destinations
+int testGrouping() {
+    std::cout << "\n=== Testing Passenger Grouping ===" << std::endl;
+    std::vector<ElevatorMessage> calls;
+    calls.push_back(ElevatorMessage(1, 9, true, -1, 0));
+    calls.push_back(ElevatorMessage(1, 8, true, -1, 0));
+    calls.push_back(ElevatorMessage(1, 20, true, -1, 0));
+    calls.push_back(ElevatorMessage(5, 9, true, -1, 0));
+    calls.push_back(ElevatorMessage(1, 10, true, -1, 0));
+
+    std::cout << "  Test Case 1: Nearby destinations from the lobby share a group" << std::endl;
+    std::vector<TripGroup> groups = groupCalls(calls, 3, 13);
+    TEST_ASSERT(groups.size() == 3, "Expected lobby 8-10, lobby 20 and floor 5 groups");
+    TEST_ASSERT(groups[0].origin == 1 && groups[0].members.size() == 3, "Lobby group should hold 3 calls");
+    TEST_ASSERT(calls[groups[0].members[0]].destination == 8, "Group members should be in visiting order");
+    TEST_ASSERT(countStops(calls, groups[0]) == 3, "Group should make 3 stops");
+
+    std::cout << "  Test Case 2: Capacity splits a group" << std::endl;
+    groups = groupCalls(calls, 3, 2);
+    TEST_ASSERT(groups.size() == 4, "Lobby 8-10 should split when only 2 persons fit");
+
+    std::cout << "  Test Case 3: Negative span disables grouping" << std::endl;
+    groups = groupCalls(calls, -1, 13);
+    TEST_ASSERT(groups.size() == calls.size(), "Every call should be its own group");
+
+    std::cout << "Passenger Grouping: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test that opposite directions never share a group
+int testDirections() {
+    std::cout << "\n=== Testing Direction Separation ===" << std::endl;
+    std::vector<ElevatorMessage> calls;
+    calls.push_back(ElevatorMessage(10, 12, true, -1, 0));
+    calls.push_back(ElevatorMessage(10, 8, false, -1, 0));
+    calls.push_back(ElevatorMessage(10, 7, false, -1, 0));
+
+    std::vector<TripGroup> groups = groupCalls(calls, 5, 13);
+    TEST_ASSERT(groups.size() == 2, "Up and down calls should form separate groups");
+    TEST_ASSERT(!groups[1].directionUp && calls[groups[1].members[0]].destination == 8,
+               "Down group should stop at 8 before 7");
+
+    std::cout << "Direction Separation: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING DESTINATION DISPATCH TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testGrouping();
+    failures += testDirections();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " DESTINATION DISPATCH TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " DESTINATION DISPATCH TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
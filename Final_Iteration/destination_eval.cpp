@@ -0,0 +1,218 @@
+// destination_eval.cpp
+// Up-peak handling-capacity benchmark: conventional up/down hall calls versus
+// destination dispatch with passenger grouping, on identical arrival streams.
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <random>
+#include <algorithm>
+#include "destination_dispatch.hpp"
+#include "load_model.hpp"
+#include "sim_arena.hpp"
+
+#define LOBBY 1
+#define MAX_FLOOR 22
+#define NUM_CARS 4
+#define STOP_TIME 4          // seconds per stop (doors open and close), as in elevator.cpp
+#define RUN_SECONDS 3600
+#define MAX_MEAN_WAIT 60     // a rate is handled if the mean lobby wait stays under this
+
+struct Passenger {
+    int arrival;
+    int destination;
+};
+
+// Everything a run allocates comes from one arena, reset after each arrival rate.
+typedef std::vector<Passenger, ArenaAllocator<Passenger>> Arrivals;
+typedef std::deque<Passenger, ArenaAllocator<Passenger>> WaitingQueue;
+
+// One remaining destination stop; a car's stops are a list in visiting order.
+struct ItineraryNode {
+    int floor;
+    ItineraryNode *next;
+};
+
+struct Car {
+    int position;
+    bool busy;
+    ItineraryNode *stops;       // remaining destination stops, in order
+    int timer;                  // seconds left at the current stop
+};
+
+// Reused by every board() call of a run, so boarding allocates only while they grow.
+struct BoardingScratch {
+    std::vector<Passenger> boarding;
+    std::vector<ElevatorMessage> calls;
+    CallGrouping grouping;
+    std::vector<bool> taken;
+};
+
+struct Result {
+    double meanWait;
+    double stopsPerTrip;
+    double passengersPerTrip;
+    int delivered;
+};
+
+// Poisson arrivals at the lobby with uniformly distributed upper-floor destinations.
+static Arrivals makeArrivals(double perFiveMinutes, unsigned seed, SimArena &arena) {
+    std::mt19937 gen(seed);
+    std::exponential_distribution<double> gap(perFiveMinutes / 300.0);
+    std::uniform_int_distribution<int> dest(LOBBY + 1, MAX_FLOOR);
+    Arrivals arrivals((ArenaAllocator<Passenger>(arena)));
+    arrivals.reserve(static_cast<size_t>(perFiveMinutes * RUN_SECONDS / 300.0 * 1.2));
+    for (double t = gap(gen); t < RUN_SECONDS; t += gap(gen)) {
+        Passenger p;
+        p.arrival = static_cast<int>(t);
+        p.destination = dest(gen);
+        arrivals.push_back(p);
+    }
+    return arrivals;
+}
+
+// Add a stop to a car's itinerary, keeping it sorted and without repeats.
+// Returns false if the car already stops there.
+static bool addStop(ItineraryNode *&stops, int floor, ObjectPool<ItineraryNode> &pool) {
+    ItineraryNode **link = &stops;
+    while (*link != nullptr && (*link)->floor < floor)
+        link = &(*link)->next;
+    if (*link != nullptr && (*link)->floor == floor)
+        return false;
+    ItineraryNode *node = pool.create();
+    node->floor = floor;
+    node->next = *link;
+    *link = node;
+    return true;
+}
+
+// Pick who boards a car waiting at the lobby into scratch.boarding, removing them from the queue.
+static void board(WaitingQueue &waiting, bool destinationMode, BoardingScratch &scratch) {
+    std::vector<Passenger> &boarding = scratch.boarding;
+    boarding.clear();
+    if (!destinationMode) {
+        // Conventional: everyone behind the up call boards until the car is full.
+        while (!waiting.empty() && static_cast<int>(boarding.size()) < RATED_PERSONS) {
+            boarding.push_back(waiting.front());
+            waiting.pop_front();
+        }
+        return;
+    }
+
+    // Destination dispatch: group the queue and send the group of the longest-waiting passenger.
+    scratch.calls.clear();
+    for (const auto &p : waiting) {
+        ElevatorMessage call(LOBBY, p.destination, true, -1, p.arrival);
+        scratch.calls.push_back(call);
+    }
+    groupCalls(scratch.calls, GROUP_DESTINATION_SPAN, RATED_PERSONS, scratch.grouping);
+    for (size_t g = 0; g < scratch.grouping.count; g++) {
+        const TripGroup &group = scratch.grouping.groups[g];
+        if (std::find(group.members.begin(), group.members.end(), 0) == group.members.end()) continue;
+        scratch.taken.assign(waiting.size(), false);
+        for (int index : group.members) {
+            boarding.push_back(waiting[index]);
+            scratch.taken[index] = true;
+        }
+        // Close the gaps left by the boarded passengers, keeping the queue in order.
+        size_t kept = 0;
+        for (size_t i = 0; i < waiting.size(); i++) {
+            if (!scratch.taken[i]) waiting[kept++] = waiting[i];
+        }
+        waiting.resize(kept);
+        break;
+    }
+}
+
+static Result run(const Arrivals &arrivals, bool destinationMode, SimArena &arena) {
+    ObjectPool<ItineraryNode> itinerary(arena);
+    std::vector<Car> cars(NUM_CARS);
+    for (auto &car : cars) {
+        car.position = LOBBY;
+        car.busy = false;
+        car.stops = nullptr;
+        car.timer = 0;
+    }
+    WaitingQueue waiting((ArenaAllocator<Passenger>(arena)));
+    BoardingScratch scratch;
+    size_t next = 0;
+    long long totalWait = 0;
+    int boarded = 0, trips = 0, stops = 0;
+
+    for (int now = 0; now < RUN_SECONDS; now++) {
+        while (next < arrivals.size() && arrivals[next].arrival == now) waiting.push_back(arrivals[next++]);
+
+        for (auto &car : cars) {
+            if (!car.busy) {
+                if (car.position != LOBBY) {
+                    car.position--;     // express return to the lobby
+                    continue;
+                }
+                board(waiting, destinationMode, scratch);
+                const std::vector<Passenger> &load = scratch.boarding;
+                if (load.empty()) continue;
+                for (const auto &p : load) {
+                    totalWait += now - p.arrival;
+                    if (addStop(car.stops, p.destination, itinerary)) stops++;
+                }
+                boarded += static_cast<int>(load.size());
+                trips++;
+                car.busy = true;
+                car.timer = STOP_TIME;  // lobby door cycle
+                continue;
+            }
+            if (car.timer > 0) {
+                car.timer--;
+            } else if (car.position != car.stops->floor) {
+                car.position++;
+            } else {
+                ItineraryNode *done = car.stops;
+                car.stops = done->next;
+                itinerary.destroy(done);
+                car.timer = STOP_TIME;
+                if (car.stops == nullptr) car.busy = false;
+            }
+        }
+    }
+
+    // Passengers still queued at the end count with their wait so far.
+    for (const auto &p : waiting) totalWait += RUN_SECONDS - p.arrival;
+    size_t everyone = boarded + waiting.size();
+
+    Result r;
+    r.meanWait = everyone ? static_cast<double>(totalWait) / everyone : 0.0;
+    r.stopsPerTrip = trips ? static_cast<double>(stops) / trips : 0.0;
+    r.passengersPerTrip = trips ? static_cast<double>(boarded) / trips : 0.0;
+    r.delivered = boarded;
+    return r;
+}
+
+int main() {
+    std::cout << "=== Up-peak handling capacity (" << NUM_CARS << " cars, floors " << LOBBY << "-" << MAX_FLOOR
+              << ", " << RATED_PERSONS << " persons/car, group span " << GROUP_DESTINATION_SPAN << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(10) << "per 5 min" << " | " << std::setw(28) << "conventional wait/stops/load"
+              << " | " << std::setw(28) << "destination wait/stops/load" << std::endl;
+
+    SimArena arena;
+    int capacityConventional = 0, capacityDestination = 0;
+    for (int rate = 20; rate <= 400; rate += 20) {
+        Result c, d;
+        {
+            Arrivals arrivals = makeArrivals(rate, 3303 + rate, arena);
+            c = run(arrivals, false, arena);
+            d = run(arrivals, true, arena);
+        }
+        arena.reset();
+        std::cout << std::setw(10) << rate << " | "
+                  << std::setw(12) << c.meanWait << " s " << std::setw(5) << c.stopsPerTrip << " " << std::setw(6) << c.passengersPerTrip
+                  << " | "
+                  << std::setw(12) << d.meanWait << " s " << std::setw(5) << d.stopsPerTrip << " " << std::setw(6) << d.passengersPerTrip
+                  << std::endl;
+        if (c.meanWait <= MAX_MEAN_WAIT) capacityConventional = rate;
+        if (d.meanWait <= MAX_MEAN_WAIT) capacityDestination = rate;
+    }
+    std::cout << "Handling capacity (mean wait <= " << MAX_MEAN_WAIT << " s): conventional "
+              << capacityConventional << ", destination " << capacityDestination << " persons per 5 min" << std::endl;
+    return 0;
+}
@@ -1,6 +1,9 @@
 /* elevator.cpp */
 #include "message.hpp"
 #include "time_manager.hpp"
+#include "load_model.hpp"
+#include "event_trace.hpp"
+#include "elevator.hpp"
 #include <iostream>
 #include <cstring>
 #include <arpa/inet.h>
@@ -9,17 +12,18 @@
 #include <chrono>
 #include <mutex>
 #include <cstdlib>
-#include <errno.h>
-#include <sys/time.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 extern std::atomic<int> currentTime;
 extern std::mutex printMutex;
-extern bool systemActive;
 
 #define ELEVATOR_PORT_BASE 9100
 #define SCHEDULER_IP "127.0.0.1"
 #define SCHEDULER_PORT 8100
 #define FLOOR_TRAVEL_TIME 1  // seconds per floor
+#define GROUP_WAIT_MS 1000   // Stop collecting a destination group after this long without a member
 #define MIN_FLOOR 1
 
 // Fault codes
@@ -27,168 +31,348 @@ extern bool systemActive;
 #define DOOR_FAULT 1
 #define STUCK_FAULT 2
 
-void elevatorFunction(int elevatorId) {
-    ElevatorState elevatorState = IDLE;
+ElevatorActor::ElevatorActor(int elevatorId, int sockfd)
+    : elevatorId_(elevatorId), sockfd_(sockfd), car_(makeCar(MIN_FLOOR)), stopName_(""), announceWait_(true),
+      onboardPersons_(0), onboardKg_(0), next_(0), stopFloor_(MIN_FLOOR) {
+    memset(&schedulerAddr_, 0, sizeof(schedulerAddr_));
+    schedulerAddr_.sin_family = AF_INET;
+    schedulerAddr_.sin_port = htons(SCHEDULER_PORT);
+    inet_pton(AF_INET, SCHEDULER_IP, &schedulerAddr_.sin_addr);
+}
 
-    int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
-    if (sockfd < 0) {
-        std::cerr << "Error creating socket\n";
-        return;
-    }
+ElevatorActor::~ElevatorActor() {
+    if (sockfd_ >= 0)
+        close(sockfd_);
+}
 
-    // Set a timeout of 1 second on recvfrom.
-    struct timeval tv;
-    tv.tv_sec = 1;
-    tv.tv_usec = 0;
-    setsockopt(sockfd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
+void ElevatorActor::send(const ElevatorMessage &msg) {
+    if (sockfd_ >= 0)
+        sendto(sockfd_, &msg, sizeof(msg), 0, (struct sockaddr*)&schedulerAddr_, sizeof(schedulerAddr_));
+}
 
-    struct sockaddr_in elevatorAddr, schedulerAddr;
-    memset(&elevatorAddr, 0, sizeof(elevatorAddr));
-    memset(&schedulerAddr, 0, sizeof(schedulerAddr));
+// Report what a state machine step did: an intermediate update (msgType = 3) for
+// each floor moved, trace events and log lines for the doors.
+void ElevatorActor::reportStep(const CarStep &step) {
+    switch (step.action) {
+    case ACTION_MOVE:
+    case ACTION_MOVE_AND_OPEN:
+    case ACTION_MOVE_AND_PARK: {
+        updateTime(currentTime.load() + 1);
 
-    elevatorAddr.sin_family = AF_INET;
-    elevatorAddr.sin_addr.s_addr = INADDR_ANY;
-    elevatorAddr.sin_port = htons(ELEVATOR_PORT_BASE + elevatorId);
+        // Increment movement counter for each floor change.
+        totalMovements.fetch_add(1);
+        traceEvent(TRACE_FLOOR_PASS, elevatorId_, car_.floor, car_.target);
 
-    if (bind(sockfd, (struct sockaddr*)&elevatorAddr, sizeof(elevatorAddr)) < 0) {
-        std::cerr << "Bind failed\n";
-        return;
+        ElevatorMessage updateMsg;
+        updateMsg.floorNumber = car_.floor;
+        updateMsg.destination = car_.target;
+        updateMsg.assignedElevator = elevatorId_;
+        updateMsg.msgType = 3;
+        updateMsg.timestamp = currentTime.load();
+        send(updateMsg);
+
+        {
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::cout << "[ELEVATOR " << elevatorId_ << "] Intermediate update: now at Floor " << car_.floor
+                      << " (time " << currentTime.load() << ")\n";
+        }
+        break;
+    }
+    case ACTION_CLOSE_DOORS: {
+        traceEvent(TRACE_DOOR_CLOSE, elevatorId_, car_.floor, car_.floor);
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[ELEVATOR " << elevatorId_ << "] Doors closing...\n";
+        break;
+    }
+    default:
+        break;
+    }
+    if (step.action == ACTION_MOVE_AND_OPEN || step.action == ACTION_OPEN_DOORS) {
+        traceEvent(TRACE_DOOR_OPEN, elevatorId_, car_.floor, car_.floor);
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[ELEVATOR " << elevatorId_ << "] Arrived at " << stopName_ << " Floor " << car_.floor << ". Doors opening...\n";
     }
+}
+
+// Head for floor to stop there; runUntilIdle() then drives the trip.
+void ElevatorActor::depart(int floor, const char *stopName) {
+    stopName_ = stopName;
+    car_.target = static_cast<int16_t>(floor);
+    reportStep(carStep(car_, CAR_GO));
+}
+
+// Awaitable: one tick per FLOOR_TRAVEL_TIME until the car is idle. A parking move
+// stops early if a new message is waiting.
+bool ElevatorActor::runUntilIdle() {
+    while (car_.state != IDLE) {
+        if ((car_.flags & CAR_PARKING) && hasMessage()) {
+            carStep(car_, CAR_STOP);
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::cout << "[ELEVATOR " << elevatorId_ << "] Parking interrupted at Floor " << car_.floor << "\n";
+            return true;
+        }
+        if (!sleepFor(FLOOR_TRAVEL_TIME * 1000))
+            return false;
+        reportStep(carStep(car_, CAR_TICK));
+    }
+    return true;
+}
 
-    schedulerAddr.sin_family = AF_INET;
-    schedulerAddr.sin_port = htons(SCHEDULER_PORT);
-    inet_pton(AF_INET, SCHEDULER_IP, &schedulerAddr.sin_addr);
+// Fail every call in the trip back to the scheduler (msgType = 2).
+void ElevatorActor::reportFault(int status, int faultCode) {
+    for (auto &member : trip_) {
+        member.status = status;
+        member.msgType = 2;
+        member.timestamp = currentTime.load();
+        send(member);
+        traceEvent(TRACE_FAULT, elevatorId_, member.floorNumber, member.destination, member.passengers, faultCode);
+    }
+}
 
+// Kept across ACTOR_AWAIT, as members: request_, member_, trip_, deferred_, next_ and
+// stopFloor_ for the calls being served; car_, stopName_, onboardPersons_, onboardKg_
+// and announceWait_ for the car; schedulerAddr_ for replies. The block-scoped
+// locals below (status, boardMsg, member) are used and dropped between waits.
+void ElevatorActor::run() {
+    ACTOR_BEGIN;
     {
         std::lock_guard<std::mutex> lock(printMutex);
-        std::cout << "[ELEVATOR " << elevatorId << "] Listening for assignments...\n";
+        std::cout << "[ELEVATOR " << elevatorId_ << "] Listening for assignments...\n";
     }
 
-    ElevatorMessage request;
-    socklen_t addrLen = sizeof(schedulerAddr);
-    int currentFloor = MIN_FLOOR;
-    bool isIdle = true;
-
-    while (systemActive) {
-        if (isIdle) {
+    while (!stopping()) {
+        if (announceWait_) {
             std::lock_guard<std::mutex> lock(printMutex);
-            std::cout << "[ELEVATOR " << elevatorId << "] Waiting for next assignment...\n";
+            std::cout << "[ELEVATOR " << elevatorId_ << "] Waiting for next assignment...\n";
+            announceWait_ = false;
         }
 
-        memset(&request, 0, sizeof(request));
-        int recvResult = recvfrom(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&schedulerAddr, &addrLen);
-        if (recvResult < 0) {
-            if (errno == EWOULDBLOCK || errno == EAGAIN) {
+        // Assignments that arrived while a group was being collected go first.
+        if (!deferred_.empty()) {
+            request_ = deferred_.front();
+            deferred_.erase(deferred_.begin());
+        } else {
+            ACTOR_AWAIT(message());
+            if (!takeMessage(request_, &schedulerAddr_))
                 continue;
-            }
         }
-        updateTime(request.timestamp);
+        updateTime(request_.timestamp);
+        announceWait_ = true;
 
-        // Check for fault injection.
-        if (request.faultCode == DOOR_FAULT) {
+        // Parking move (msgType = 5): reposition while idle, doors stay closed.
+        if (request_.msgType == 5) {
             {
                 std::lock_guard<std::mutex> lock(printMutex);
-                std::cout << "[ELEVATOR " << elevatorId << "] Simulating DOOR FAULT at floor " << request.floorNumber << "\n";
+                std::cout << "[ELEVATOR " << elevatorId_ << "] Parking: moving from Floor " << car_.floor
+                          << " to Floor " << request_.destination << "\n";
             }
-            elevatorState = DOOR_OPEN;
-            std::this_thread::sleep_for(std::chrono::milliseconds(5000));
-            request.status = -1;
-            request.msgType = 2; // fault
-            request.timestamp = currentTime.load();
-            sendto(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&schedulerAddr, addrLen);
+            stopName_ = "Parking";
+            car_.target = static_cast<int16_t>(request_.destination);
+            carStep(car_, CAR_PARK);
+            ACTOR_AWAIT(runUntilIdle());
             continue;
-        } else if (request.faultCode == STUCK_FAULT) {
+        }
+
+        // Status query (msgType = 7) from a restarted scheduler: report where the car is
+        // and what it carries (msgType = 8) so the recovered state can be reconciled.
+        if (request_.msgType == 7) {
+            ElevatorMessage status(car_.floor, car_.floor, true, elevatorId_, currentTime.load());
+            status.msgType = 8;
+            status.passengers = 0;
+            status.carLoad = onboardPersons_;
+            status.carLoadKg = onboardKg_;
+            send(status);
             {
                 std::lock_guard<std::mutex> lock(printMutex);
-                std::cout << "[ELEVATOR " << elevatorId << "] Simulating STUCK FAULT while moving...\n";
+                std::cout << "[ELEVATOR " << elevatorId_ << "] Registered with scheduler at Floor " << car_.floor
+                          << " (load " << onboardPersons_ << "/" << RATED_PERSONS << ")\n";
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10000));
-            request.status = -2;
-            request.msgType = 2;
-            request.timestamp = currentTime.load();
-            sendto(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&schedulerAddr, addrLen);
             continue;
         }
 
-
-        if (request.floorNumber == request.destination) {
-            std::lock_guard<std::mutex> lock(printMutex);
-            std::cout << "[ELEVATOR " << elevatorId << "] Ignoring same-floor request: Floor " << request.floorNumber << "\n";
-            continue;
+        // A destination-dispatch group arrives as groupSize back-to-back assignments
+        // sharing one pickup floor; collect the whole group before moving.
+        trip_.assign(1, request_);
+        while (static_cast<int>(trip_.size()) < request_.groupSize && !stopping()) {
+            ACTOR_AWAIT(messageOrTimeout(GROUP_WAIT_MS));
+            if (!takeMessage(member_, &schedulerAddr_))
+                break;
+            if (member_.groupId != request_.groupId) {
+                deferred_.push_back(member_);
+                continue;
+            }
+            trip_.push_back(member_);
         }
 
-        // Go to pickup floor if not already there.
-        if (currentFloor != request.floorNumber) {
-            elevatorState = DOOR_OPEN;
+        // Check for fault injection.
+        if (request_.faultCode == DOOR_FAULT) {
             {
                 std::lock_guard<std::mutex> lock(printMutex);
-                std::cout << "[ELEVATOR " << elevatorId << "] Arrived at Pickup Floor " << request.floorNumber << ". Doors opening...\n";
+                std::cout << "[ELEVATOR " << elevatorId_ << "] Simulating DOOR FAULT at floor " << request_.floorNumber << "\n";
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-            elevatorState = DOOR_CLOSED;
+            stopName_ = "Fault";
+            carStep(car_, CAR_DOOR_FAULT);
+            ACTOR_AWAIT(runUntilIdle());
+            reportFault(-1, DOOR_FAULT);
+            continue;
+        } else if (request_.faultCode == STUCK_FAULT) {
             {
                 std::lock_guard<std::mutex> lock(printMutex);
-                std::cout << "[ELEVATOR " << elevatorId << "] Doors closing...\n";
+                std::cout << "[ELEVATOR " << elevatorId_ << "] Simulating STUCK FAULT while moving...\n";
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-            currentFloor = request.floorNumber;
+            stopName_ = "Fault";
+            carStep(car_, CAR_STUCK_FAULT);
+            ACTOR_AWAIT(runUntilIdle());
+            reportFault(-2, STUCK_FAULT);
+            continue;
         }
 
-        // Move floor-by-floor to destination.
-        elevatorState = MOVING;
-        {
+
+        if (request_.floorNumber == request_.destination) {
             std::lock_guard<std::mutex> lock(printMutex);
-            std::cout << "[ELEVATOR " << elevatorId << "] Moving from Floor " << currentFloor
-                      << " to Floor " << request.destination << "\n";
+            std::cout << "[ELEVATOR " << elevatorId_ << "] Ignoring same-floor request: Floor " << request_.floorNumber << "\n";
+            continue;
         }
-        int step = (request.destination > currentFloor) ? 1 : -1;
-        while (currentFloor != request.destination) {
-            std::this_thread::sleep_for(std::chrono::seconds(FLOOR_TRAVEL_TIME));
-            updateTime(currentTime.load() + 1);
-
-            // Increment movement counter for each floor change.
-            totalMovements.fetch_add(1);
-
-            currentFloor += step;
-            
-            // Send intermediate update (msgType = 3).
-            ElevatorMessage updateMsg;
-            updateMsg.floorNumber = currentFloor;
-            updateMsg.destination = request.destination;
-            updateMsg.assignedElevator = elevatorId;
-            updateMsg.msgType = 3;
-            updateMsg.timestamp = currentTime.load();
-            sendto(sockfd, &updateMsg, sizeof(updateMsg), 0, (struct sockaddr*)&schedulerAddr, addrLen);
 
+        // Go to pickup floor if not already there.
+        if (car_.floor != request_.floorNumber) {
+            depart(request_.floorNumber, "Pickup");
+            ACTOR_AWAIT(runUntilIdle());
+        }
+
+        // Board passengers at the pickup floor and report the new car load.
+        for (auto &member : trip_) {
+            onboardPersons_ += member.passengers;
+            onboardKg_ += passengerWeightKg(member.passengers);
+            ElevatorMessage boardMsg = member;
+            boardMsg.msgType = 4;
+            boardMsg.carLoad = onboardPersons_;
+            boardMsg.carLoadKg = onboardKg_;
+            boardMsg.timestamp = currentTime.load();
+            send(boardMsg);
+            traceEvent(TRACE_BOARDING, elevatorId_, member.floorNumber, member.destination, member.passengers, onboardPersons_);
             {
                 std::lock_guard<std::mutex> lock(printMutex);
-                std::cout << "[ELEVATOR " << elevatorId << "] Intermediate update: now at Floor " << currentFloor 
-                          << " (time " << currentTime.load() << ")\n";
+                std::cout << "[ELEVATOR " << elevatorId_ << "] Boarded " << member.passengers
+                          << " passenger(s) at Floor " << car_.floor << ". Load: " << onboardPersons_
+                          << "/" << RATED_PERSONS << " persons, " << onboardKg_ << "/" << RATED_LOAD_KG << " kg\n";
             }
         }
 
-        // At destination: open and close doors.
-        elevatorState = DOOR_OPEN;
-        {
-            std::lock_guard<std::mutex> lock(printMutex);
-            std::cout << "[ELEVATOR " << elevatorId << "] Arrived at Destination Floor " << currentFloor << ". Doors opening...\n";
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        // Group members are already in visiting order; stop once per distinct destination.
+        next_ = 0;
+        while (next_ < trip_.size()) {
+            stopFloor_ = trip_[next_].destination;
 
-        elevatorState = DOOR_CLOSED;
-        {
-            std::lock_guard<std::mutex> lock(printMutex);
-            std::cout << "[ELEVATOR " << elevatorId << "] Doors closing...\n";
+            // Move floor-by-floor to destination, then open and close doors.
+            {
+                std::lock_guard<std::mutex> lock(printMutex);
+                std::cout << "[ELEVATOR " << elevatorId_ << "] Moving from Floor " << car_.floor
+                          << " to Floor " << stopFloor_ << "\n";
+            }
+            depart(stopFloor_, "Destination");
+            ACTOR_AWAIT(runUntilIdle());
+
+            for (; next_ < trip_.size() && trip_[next_].destination == stopFloor_; next_++) {
+                ElevatorMessage &member = trip_[next_];
+
+                // Passengers of this request alight at the destination.
+                onboardPersons_ -= member.passengers;
+                onboardKg_ -= passengerWeightKg(member.passengers);
+                if (onboardPersons_ < 0) onboardPersons_ = 0;
+                if (onboardKg_ < 0) onboardKg_ = 0;
+
+                // Send final completion response (msgType = 1).
+                member.status = 1;
+                member.msgType = 1;
+                member.carLoad = onboardPersons_;
+                member.carLoadKg = onboardKg_;
+                member.timestamp = currentTime.load();
+                send(member);
+                traceEvent(TRACE_COMPLETION, elevatorId_, member.floorNumber, member.destination, member.passengers, onboardPersons_);
+            }
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    }
+    ACTOR_END;
+}
 
-        // Send final completion response (msgType = 1).
-        request.status = 1;
-        request.msgType = 1;
-        request.timestamp = currentTime.load();
-        sendto(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&schedulerAddr, addrLen);
+// Car sockets listen on ELEVATOR_PORT_BASE + id.
+static int openElevatorSocket(int elevatorId) {
+    int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sockfd < 0) {
+        std::cerr << "Error creating socket\n";
+        return -1;
+    }
 
-        isIdle = true;
+    struct sockaddr_in elevatorAddr;
+    memset(&elevatorAddr, 0, sizeof(elevatorAddr));
+    elevatorAddr.sin_family = AF_INET;
+    elevatorAddr.sin_addr.s_addr = INADDR_ANY;
+    elevatorAddr.sin_port = htons(ELEVATOR_PORT_BASE + elevatorId);
+
+    if (bind(sockfd, (struct sockaddr*)&elevatorAddr, sizeof(elevatorAddr)) < 0) {
+        std::cerr << "Bind failed\n";
+        close(sockfd);
+        return -1;
+    }
+    return sockfd;
+}
+
+// Executors started by runElevators(), so stopElevators() can reach them from
+// another thread. stopRequested covers a stop that comes before they exist.
+static std::mutex executorsMutex;
+static std::vector<ActorExecutor*> runningExecutors;
+static bool stopRequested = false;
+
+void stopElevators() {
+    std::lock_guard<std::mutex> lock(executorsMutex);
+    stopRequested = true;
+    for (ActorExecutor *executor : runningExecutors)
+        executor->shutdown();
+}
+
+void runElevators(const std::vector<int> &elevatorIds, int threads) {
+    std::vector<std::unique_ptr<ElevatorActor>> cars;
+    for (int id : elevatorIds) {
+        int sockfd = openElevatorSocket(id);
+        if (sockfd >= 0)
+            cars.emplace_back(new ElevatorActor(id, sockfd));
     }
-    close(sockfd);
+    if (cars.empty())
+        return;
+    threads = std::max(1, std::min(threads, static_cast<int>(cars.size())));
+
+    // Cars are dealt round-robin; each executor only ever touches its own.
+    std::vector<std::unique_ptr<ActorExecutor>> executors;
+    for (int i = 0; i < threads; i++)
+        executors.emplace_back(new ActorExecutor());
+    for (size_t i = 0; i < cars.size(); i++) {
+        ActorExecutor &executor = *executors[i % threads];
+        executor.spawn(*cars[i]);
+        executor.watch(*cars[i], cars[i]->socket());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(executorsMutex);
+        for (auto &executor : executors) {
+            runningExecutors.push_back(executor.get());
+            if (stopRequested)
+                executor->shutdown();
+        }
+    }
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++)
+        pool.emplace_back(&ActorExecutor::run, executors[i].get());
+    executors[0]->run();
+    for (auto &thread : pool)
+        thread.join();
+
+    std::lock_guard<std::mutex> lock(executorsMutex);
+    for (auto &executor : executors)
+        runningExecutors.erase(std::find(runningExecutors.begin(), runningExecutors.end(), executor.get()));
+}
+
+void elevatorFunction(int elevatorId) {
+    runElevators(std::vector<int>(1, elevatorId), 1);
 }
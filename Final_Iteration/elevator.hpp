@@ -2,10 +2,61 @@
 #define ELEVATOR_HPP
 
 #include "message.hpp"
+#include "actor.hpp"
+#include "car_state_machine.hpp"
 #include <vector>
+#include <netinet/in.h>
 
 extern std::vector<bool> elevatorBusy; // Declare as extern
 
+// One car as an actor: waits for assignments on its socket (or mailbox), serves
+// them and reports to the scheduler. sockfd may be -1 for in-process simulation,
+// in which case nothing is sent.
+class ElevatorActor : public Actor {
+public:
+    ElevatorActor(int elevatorId, int sockfd);
+    ~ElevatorActor();
+
+    ElevatorActor(const ElevatorActor &) = delete;
+    ElevatorActor &operator=(const ElevatorActor &) = delete;
+
+    void run() override;
+
+    int socket() const { return sockfd_; }
+    const CarMotion &car() const { return car_; }
+
+private:
+    void send(const ElevatorMessage &msg);
+    void reportStep(const CarStep &step);
+    void depart(int floor, const char *stopName);
+    bool runUntilIdle();
+    void reportFault(int status, int faultCode);
+
+    int elevatorId_;
+    int sockfd_;
+    struct sockaddr_in schedulerAddr_;   // Replies go to whoever sent the last assignment
+    CarMotion car_;
+    const char *stopName_;
+    bool announceWait_;
+    int onboardPersons_;
+    int onboardKg_;
+    ElevatorMessage request_;
+    ElevatorMessage member_;
+    std::vector<ElevatorMessage> trip_;
+    std::vector<ElevatorMessage> deferred_;
+    size_t next_;
+    int stopFloor_;
+};
+
+// Run the cars as actors on `threads` executor threads (the calling thread is one
+// of them) until stopElevators() is called.
+void runElevators(const std::vector<int> &elevatorIds, int threads);
+
+// Shut down every executor runElevators() is running; each car finishes the trip
+// it is on and returns. Safe from any thread, also before runElevators() starts.
+void stopElevators();
+
+// A single car on the calling thread.
 void elevatorFunction(int elevatorId);
 
 #endif // ELEVATOR_HPP
\ No newline at end of file
@@ -0,0 +1,53 @@
+// elevator_node.cpp
+// Runs elevator cars as their own process. Each car listens on
+// 9100 + id, so cars can be split across processes (one per car, or a
+// noisy car kept away from the rest) as long as each id runs once.
+//
+// Usage: ./elevator_node [--cpu LIST] [--nice N] [--rt-priority N] [car id ...]
+//        (all four cars when no id is given)
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include "elevator.hpp"
+#include "time_manager.hpp"
+#include "process_options.hpp"
+
+#define NUM_CARS 4
+
+bool systemActive = true;
+
+int main(int argc, char *argv[]) {
+    ProcessOptions options;
+    std::vector<int> cars;
+    for (int i = 1; i < argc; i++) {
+        if (parseProcessOption(argc, argv, i, options))
+            continue;
+        char *end;
+        long id = strtol(argv[i], &end, 10);
+        if (*end != '\0' || id < 0 || id >= NUM_CARS) {
+            std::cerr << "Usage: " << argv[0] << " " PROCESS_OPTIONS_USAGE " [car id 0-" << NUM_CARS - 1 << " ...]\n";
+            return 1;
+        }
+        cars.push_back(static_cast<int>(id));
+    }
+    if (cars.empty()) {
+        for (int id = 0; id < NUM_CARS; id++) cars.push_back(id);
+    }
+    applyProcessOptions(options, "ELEVATOR");
+
+    // Every car runs as an actor on one executor thread.
+    std::thread elevatorThread(runElevators, cars, 1);
+
+    std::cout << "Press Enter to stop the elevators and output performance metrics..." << std::endl;
+    std::cin.get();
+    systemActive = false;
+    stopElevators();
+    elevatorThread.join();
+
+    std::cout << "\n=== Performance Metrics ===" << std::endl;
+    std::cout << "Total simulation time: " << currentTime.load() << " seconds" << std::endl;
+    std::cout << "Total floor movements: " << totalMovements.load() << std::endl;
+    std::cout << "===========================" << std::endl;
+    return 0;
+}
@@ -0,0 +1,144 @@
+/* event_trace.cpp */
+#include "event_trace.hpp"
+#include "time_manager.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+static std::mutex traceMutex;
+static std::atomic<bool> traceOpen(false);
+static FILE *traceFile = nullptr;
+static std::vector<TraceRecord> traceBuffer;
+static std::chrono::steady_clock::time_point traceStart;
+static uint64_t lastFlushNs = 0;
+
+// Write buffered records through to the file, so a killed run keeps what it recorded.
+static void flushTrace() {
+    if (!traceBuffer.empty()) {
+        fwrite(traceBuffer.data(), sizeof(TraceRecord), traceBuffer.size(), traceFile);
+        traceBuffer.clear();
+    }
+    fflush(traceFile);
+}
+
+bool openTrace(const std::string &path) {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (traceFile != nullptr) return false;
+    traceFile = fopen(path.c_str(), "wb");
+    if (traceFile == nullptr) return false;
+
+    TraceHeader header;
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    header.startUnixMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    fwrite(&header, sizeof(header), 1, traceFile);
+    fflush(traceFile);
+
+    traceBuffer.reserve(TRACE_BUFFER_RECORDS);
+    traceStart = std::chrono::steady_clock::now();
+    lastFlushNs = 0;
+    traceOpen = true;
+    return true;
+}
+
+void traceEvent(TraceEventType type, int elevator, int floor, int destination, int passengers, int detail) {
+    if (!traceOpen) return;
+
+    TraceRecord record;
+    record.simTime = currentTime.load();
+    record.type = static_cast<uint16_t>(type);
+    record.elevator = static_cast<int16_t>(elevator);
+    record.floor = static_cast<int16_t>(floor);
+    record.destination = static_cast<int16_t>(destination);
+    record.passengers = static_cast<int16_t>(passengers);
+    record.detail = static_cast<int16_t>(detail);
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (traceFile == nullptr) return;
+    // Stamped under the lock so records are in time order in the file.
+    record.wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - traceStart).count();
+    traceBuffer.push_back(record);
+    if (traceBuffer.size() >= TRACE_BUFFER_RECORDS ||
+        record.wallNs - lastFlushNs >= TRACE_FLUSH_MS * 1000000ULL) {
+        flushTrace();
+        lastFlushNs = record.wallNs;
+    }
+}
+
+void closeTrace() {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    traceOpen = false;
+    if (traceFile == nullptr) return;
+    flushTrace();
+    fclose(traceFile);
+    traceFile = nullptr;
+}
+
+const char *traceEventName(int type) {
+    static const char *names[TRACE_EVENT_TYPES] = {
+        "REQUEST_ARRIVAL", "ASSIGNMENT", "DOOR_OPEN", "DOOR_CLOSE", "FLOOR_PASS",
+        "FAULT", "BOARDING", "COMPLETION", "PARKING"
+    };
+    if (type < 0 || type >= TRACE_EVENT_TYPES) return "UNKNOWN";
+    return names[type];
+}
+
+TraceReader::TraceReader() : file_(nullptr), position_(0), count_(0), recordCount_(0) {
+    memset(&header_, 0, sizeof(header_));
+}
+
+TraceReader::~TraceReader() {
+    close();
+}
+
+bool TraceReader::open(const std::string &path) {
+    close();
+    file_ = fopen(path.c_str(), "rb");
+    if (file_ == nullptr) return false;
+    if (fread(&header_, sizeof(header_), 1, file_) != 1 ||
+        memcmp(header_.magic, TRACE_MAGIC, sizeof(header_.magic)) != 0 ||
+        header_.version != TRACE_VERSION ||
+        header_.recordSize != sizeof(TraceRecord)) {
+        close();
+        return false;
+    }
+    fseeko(file_, 0, SEEK_END);
+    recordCount_ = (static_cast<uint64_t>(ftello(file_)) - sizeof(TraceHeader)) / sizeof(TraceRecord);
+    fseeko(file_, sizeof(TraceHeader), SEEK_SET);
+    buffer_.resize(TRACE_BUFFER_RECORDS);
+    position_ = 0;
+    count_ = 0;
+    return true;
+}
+
+bool TraceReader::seek(uint64_t index) {
+    if (file_ == nullptr || index > recordCount_) return false;
+    position_ = 0;
+    count_ = 0;
+    return fseeko(file_, sizeof(TraceHeader) + index * sizeof(TraceRecord), SEEK_SET) == 0;
+}
+
+bool TraceReader::next(TraceRecord &record) {
+    if (position_ == count_) {
+        if (file_ == nullptr) return false;
+        count_ = fread(buffer_.data(), sizeof(TraceRecord), buffer_.size(), file_);
+        position_ = 0;
+        if (count_ == 0) return false;
+    }
+    record = buffer_[position_++];
+    return true;
+}
+
+void TraceReader::close() {
+    if (file_ != nullptr) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+    position_ = 0;
+    count_ = 0;
+    recordCount_ = 0;
+}
@@ -0,0 +1,97 @@
+#ifndef EVENT_TRACE_HPP
+#define EVENT_TRACE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#define TRACE_MAGIC "ELVTRACE"       // First 8 bytes of every trace file
+#define TRACE_VERSION 1
+#define TRACE_BUFFER_RECORDS 4096    // Records buffered per write / read
+#define TRACE_FLUSH_MS 1000          // Buffered records reach the file at least this often
+
+// Simulation state transitions recorded in the trace.
+enum TraceEventType {
+    TRACE_REQUEST_ARRIVAL,   // Scheduler received a hall call
+    TRACE_ASSIGNMENT,        // Hall call given to a car (detail: destination group id)
+    TRACE_DOOR_OPEN,
+    TRACE_DOOR_CLOSE,
+    TRACE_FLOOR_PASS,        // Car reached the next floor on its way to destination
+    TRACE_FAULT,             // detail: fault code
+    TRACE_BOARDING,          // Passengers of a hall call boarded (detail: persons on board)
+    TRACE_COMPLETION,        // Passengers of a hall call alighted (detail: persons on board)
+    TRACE_PARKING,           // Idle car sent from floor to park at destination
+    TRACE_EVENT_TYPES
+};
+
+// File header, written once at the start of the trace.
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;     // sizeof(TraceRecord) when written
+    int64_t startUnixMs;     // Wall clock when the trace was opened
+};
+
+// One fixed-size event. floor and destination identify the hall call for
+// request events; for car events floor is where the car is.
+struct TraceRecord {
+    uint64_t wallNs;         // Nanoseconds since the trace was opened
+    int32_t simTime;         // Simulated time (currentTime)
+    uint16_t type;           // TraceEventType
+    int16_t elevator;        // -1 when no car is involved
+    int16_t floor;
+    int16_t destination;
+    int16_t passengers;
+    int16_t detail;
+};
+
+static_assert(sizeof(TraceHeader) == 24, "trace header layout changed");
+static_assert(sizeof(TraceRecord) == 24, "trace record layout changed");
+
+// Start recording to path, replacing any existing file. Returns false if it cannot be created.
+bool openTrace(const std::string &path);
+
+// Append one event; does nothing while no trace is open. Safe to call from any thread.
+void traceEvent(TraceEventType type, int elevator, int floor, int destination,
+                int passengers = 0, int detail = 0);
+
+// Flush buffered events and close the trace.
+void closeTrace();
+
+// Short upper-case name of an event type, e.g. "DOOR_OPEN".
+const char *traceEventName(int type);
+
+// Streams the records of a trace file in order, TRACE_BUFFER_RECORDS at a time.
+class TraceReader {
+public:
+    TraceReader();
+    ~TraceReader();
+
+    // Returns false if the file is missing or is not a trace this reader understands.
+    bool open(const std::string &path);
+
+    // Next record, or false at the end of the trace.
+    bool next(TraceRecord &record);
+
+    // Number of records in the file.
+    uint64_t recordCount() const { return recordCount_; }
+
+    // Continue reading at record index (0 is the first record). Lets several
+    // readers each stream their own slice of one trace.
+    bool seek(uint64_t index);
+
+    const TraceHeader &header() const { return header_; }
+
+    void close();
+
+private:
+    FILE *file_;
+    TraceHeader header_;
+    std::vector<TraceRecord> buffer_;
+    size_t position_;
+    size_t count_;
+    uint64_t recordCount_;
+};
+
+#endif // EVENT_TRACE_HPP
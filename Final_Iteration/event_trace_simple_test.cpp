@@ -0,0 +1,129 @@
+// event_trace_simple_test.cpp
+#include <iostream>
+#include <cstdio>
+#include <chrono>
+#include "event_trace.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+#define TEST_TRACE "event_trace_test.bin"
+
+// Test that recorded events read back unchanged and in order
+int testRoundTrip() {
+    std::cout << "\n=== Testing Trace Round Trip ===" << std::endl;
+
+    std::cout << "  Test Case 1: Header is written" << std::endl;
+    TEST_ASSERT(openTrace(TEST_TRACE), "Trace file should be created");
+    traceEvent(TRACE_REQUEST_ARRIVAL, -1, 3, 9, 2);
+    traceEvent(TRACE_ASSIGNMENT, 1, 3, 9, 2, 7);
+    traceEvent(TRACE_DOOR_OPEN, 1, 3, 3);
+    closeTrace();
+
+    TraceReader reader;
+    TEST_ASSERT(reader.open(TEST_TRACE), "Reader should accept the trace");
+    TEST_ASSERT(reader.header().version == TRACE_VERSION, "Header should carry the trace version");
+
+    std::cout << "  Test Case 2: Records keep their fields and order" << std::endl;
+    TraceRecord record;
+    TEST_ASSERT(reader.next(record) && record.type == TRACE_REQUEST_ARRIVAL && record.elevator == -1 &&
+                record.floor == 3 && record.destination == 9 && record.passengers == 2,
+                "First record should be the request arrival");
+    TEST_ASSERT(reader.next(record) && record.type == TRACE_ASSIGNMENT && record.elevator == 1 && record.detail == 7,
+                "Second record should be the assignment with its group id");
+    uint64_t assignedAt = record.wallNs;
+    TEST_ASSERT(reader.next(record) && record.type == TRACE_DOOR_OPEN && record.wallNs >= assignedAt,
+                "Third record should be the door opening, not earlier than the assignment");
+    TEST_ASSERT(!reader.next(record), "Reader should stop at the end of the trace");
+
+    std::cout << "Trace Round Trip: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test that events are dropped while no trace is open
+int testClosedTrace() {
+    std::cout << "\n=== Testing Closed Trace ===" << std::endl;
+
+    std::cout << "  Test Case 1: Events after close are ignored" << std::endl;
+    TEST_ASSERT(openTrace(TEST_TRACE), "Trace file should be created");
+    traceEvent(TRACE_FLOOR_PASS, 0, 2, 5);
+    closeTrace();
+    traceEvent(TRACE_FLOOR_PASS, 0, 3, 5);
+
+    TraceReader reader;
+    TraceRecord record;
+    int count = 0;
+    TEST_ASSERT(reader.open(TEST_TRACE), "Reader should accept the trace");
+    while (reader.next(record)) count++;
+    TEST_ASSERT(count == 1, "Only the event recorded while open should be in the trace");
+
+    std::cout << "  Test Case 2: Non-trace file is rejected" << std::endl;
+    FILE *file = fopen(TEST_TRACE, "wb");
+    fputs("[ELEVATOR 0] Doors closing...\n", file);
+    fclose(file);
+    TEST_ASSERT(!reader.open(TEST_TRACE), "Text log should not be read as a trace");
+
+    std::cout << "Closed Trace: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test streaming a trace far larger than one read buffer
+int testLargeTrace() {
+    std::cout << "\n=== Testing Large Trace ===" << std::endl;
+    const int events = 1000000;
+
+    std::cout << "  Test Case 1: One million events stream back in order" << std::endl;
+    TEST_ASSERT(openTrace(TEST_TRACE), "Trace file should be created");
+    for (int i = 0; i < events; i++)
+        traceEvent(TRACE_FLOOR_PASS, i % 4, 1 + i % 22, 22, 0, static_cast<int16_t>(i));
+    closeTrace();
+
+    auto start = std::chrono::steady_clock::now();
+    TraceReader reader;
+    TraceRecord record;
+    int count = 0;
+    bool ordered = true;
+    TEST_ASSERT(reader.open(TEST_TRACE), "Reader should accept the trace");
+    while (reader.next(record)) {
+        if (record.detail != static_cast<int16_t>(count)) ordered = false;
+        count++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT(count == events, "Every event should be read back");
+    TEST_ASSERT(ordered, "Events should come back in recording order");
+    std::cout << "  Read " << count << " events in " << seconds << " s" << std::endl;
+
+    std::cout << "Large Trace: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING EVENT TRACE TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testRoundTrip();
+    failures += testClosedTrace();
+    failures += testLargeTrace();
+    remove(TEST_TRACE);
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " EVENT TRACE TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " EVENT TRACE TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
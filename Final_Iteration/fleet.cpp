@@ -0,0 +1,386 @@
+/* fleet.cpp */
+#include "fleet.hpp"
+#include "load_model.hpp"
+#include "batch_dispatch.hpp"
+#include <cstdlib>
+#include <algorithm>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Bits of mask word w that belong to real cars rather than padding.
+static uint64_t laneMask(int cars, int w) {
+    int left = cars - w * FLEET_WORD_BITS;
+    return left >= FLEET_WORD_BITS ? ~uint64_t(0) : (uint64_t(1) << left) - 1;
+}
+
+int FleetMask::first() const {
+    for (size_t w = 0; w < words.size(); w++) {
+        if (words[w] != 0)
+            return static_cast<int>(w) * FLEET_WORD_BITS + __builtin_ctzll(words[w]);
+    }
+    return -1;
+}
+
+Fleet::Fleet(int firstId, int count, int floor) : firstId(firstId), cars(count) {
+    int padded = (count + FLEET_WORD_BITS - 1) / FLEET_WORD_BITS * FLEET_WORD_BITS;
+    position.assign(padded, floor);
+    passengerCount.assign(padded, 0);
+    loadKg.assign(padded, 0);
+    reservedPersons.assign(padded, 0);
+    queuedTrips.assign(padded, 0);
+    tripEndFloor.assign(padded, floor);
+    parkingFloor.assign(padded, -1);
+    idle.resize(count);
+    moving.resize(count);
+    goingUp.resize(count);
+    faulted.resize(count);
+    awaitingRegistration.resize(count);
+    for (int car = 0; car < count; car++) {
+        idle.set(car, true);
+        goingUp.set(car, true);
+    }
+}
+
+void Fleet::copyCar(const Fleet &from, int car) {
+    position[car] = from.position[car];
+    passengerCount[car] = from.passengerCount[car];
+    loadKg[car] = from.loadKg[car];
+    reservedPersons[car] = from.reservedPersons[car];
+    queuedTrips[car] = from.queuedTrips[car];
+    tripEndFloor[car] = from.tripEndFloor[car];
+    parkingFloor[car] = from.parkingFloor[car];
+    idle.set(car, from.idle.test(car));
+    moving.set(car, from.moving.test(car));
+    goingUp.set(car, from.goingUp.test(car));
+    faulted.set(car, from.faulted.test(car));
+    awaitingRegistration.set(car, from.awaitingRegistration.test(car));
+}
+
+// The per-car limits eligible() compares against, for a group of passengers.
+struct LoadLimits {
+    int persons;
+    int kg;
+};
+
+static LoadLimits loadLimits(int passengers) {
+    // shouldBypass() without its divisions: loadPercent() truncates, so a load reaches
+    // BYPASS_LOAD_PERCENT exactly when persons * 100 >= BYPASS_LOAD_PERCENT * RATED_PERSONS.
+    const int bypassPersons = (BYPASS_LOAD_PERCENT * RATED_PERSONS + 99) / 100;
+    const int bypassKg = (BYPASS_LOAD_PERCENT * RATED_LOAD_KG + 99) / 100;
+    // canBoard(): the group still fits within both ratings.
+    const int roomPersons = RATED_PERSONS - passengers + 1;
+    const int roomKg = RATED_LOAD_KG - passengerWeightKg(passengers) + 1;
+    LoadLimits limits;
+    limits.persons = bypassPersons < roomPersons ? bypassPersons : roomPersons;
+    limits.kg = bypassKg < roomKg ? bypassKg : roomKg;
+    return limits;
+}
+
+// The eligible cars of mask word w. With SSE2 that is eight cars per compare and
+// sixteen per movemask; otherwise a plain loop per bit.
+static uint64_t eligibleWord(const Fleet &fleet, const LoadLimits &limits, size_t w) {
+    const int base = static_cast<int>(w) * FLEET_WORD_BITS;
+    uint64_t word = 0;
+#ifdef __SSE2__
+    // Projected loads stay far inside int16: reservations only reach cars below the bypass load.
+    const __m128i personMax = _mm_set1_epi16(static_cast<int16_t>(limits.persons));
+    const __m128i kgMax = _mm_set1_epi16(static_cast<int16_t>(limits.kg));
+    const __m128i passengerKg = _mm_set1_epi16(AVG_PASSENGER_KG);
+    for (int j = 0; j < FLEET_WORD_BITS; j += 16) {
+        __m128i ok[2];
+        for (int half = 0; half < 2; half++) {
+            int car = base + j + 8 * half;
+            __m128i reserved = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&fleet.reservedPersons[car]));
+            __m128i persons = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&fleet.passengerCount[car])), reserved);
+            __m128i kg = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&fleet.loadKg[car])),
+                                       _mm_mullo_epi16(reserved, passengerKg));
+            ok[half] = _mm_and_si128(_mm_cmplt_epi16(persons, personMax), _mm_cmplt_epi16(kg, kgMax));
+        }
+        word |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_packs_epi16(ok[0], ok[1]))) << j;
+    }
+#else
+    for (int j = 0; j < FLEET_WORD_BITS; j++) {
+        int car = base + j;
+        int persons = fleet.passengerCount[car] + fleet.reservedPersons[car];
+        int kg = fleet.loadKg[car] + fleet.reservedPersons[car] * AVG_PASSENGER_KG;
+        word |= static_cast<uint64_t>(persons < limits.persons && kg < limits.kg) << j;
+    }
+#endif
+    return word & laneMask(fleet.cars, w) & ~fleet.faulted.words[w] & ~fleet.awaitingRegistration.words[w];
+}
+
+void Fleet::eligible(int passengers, FleetMask &out) const {
+    const LoadLimits limits = loadLimits(passengers);
+    out.resize(cars);
+    for (size_t w = 0; w < out.words.size(); w++)
+        out.words[w] = eligibleWord(*this, limits, w);
+}
+
+// Each SIMD lane tests its own bit of bits: lane k is all ones when bit k is set.
+#if defined(__AVX2__)
+static inline __m256i bitLanes(unsigned bits) {
+    const __m256i select = _mm256_setr_epi16(0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80, 0x100, 0x200, 0x400,
+                                             0x800, 0x1000, 0x2000, 0x4000, static_cast<int16_t>(0x8000));
+    return _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16(static_cast<int16_t>(bits)), select), select);
+}
+#elif defined(__SSE2__)
+static inline __m128i bitLanes(unsigned bits) {
+    const __m128i select = _mm_setr_epi16(0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80);
+    return _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(static_cast<int16_t>(bits)), select), select);
+}
+#endif
+
+// The lowest of a register's int16 lanes.
+#if defined(__SSE2__)
+static inline int lowestLane(__m128i costs) {
+    costs = _mm_min_epi16(costs, _mm_shuffle_epi32(costs, _MM_SHUFFLE(1, 0, 3, 2)));
+    costs = _mm_min_epi16(costs, _mm_shuffle_epi32(costs, _MM_SHUFFLE(2, 3, 0, 1)));
+    costs = _mm_min_epi16(costs, _mm_shufflelo_epi16(costs, _MM_SHUFFLE(2, 3, 0, 1)));
+    return static_cast<int16_t>(_mm_cvtsi128_si32(costs));
+}
+#endif
+#if defined(__AVX2__)
+static inline int lowestLane(__m256i costs) {
+    return lowestLane(_mm_min_epi16(_mm256_castsi256_si128(costs), _mm256_extracti128_si256(costs, 1)));
+}
+#endif
+
+// Cost of the cars in mask word w, padding included, and the lowest of them:
+// AVX2 does 16 cars per step, SSE2 8, else one.
+static int dispatchCosts(const Fleet &fleet, int floor, const FleetMask &eligible, size_t w, int16_t *costs) {
+#if defined(__AVX2__)
+    const int lanes = 16;
+    const __m256i target = _mm256_set1_epi16(static_cast<int16_t>(floor));
+    const __m256i maxDistance = _mm256_set1_epi16(FLEET_COST_TIER - 1);
+    const __m256i tier = _mm256_set1_epi16(FLEET_COST_TIER);
+    const __m256i none = _mm256_set1_epi16(FLEET_COST_NONE);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lowest = none;
+#elif defined(__SSE2__)
+    const int lanes = 8;
+    const __m128i target = _mm_set1_epi16(static_cast<int16_t>(floor));
+    const __m128i maxDistance = _mm_set1_epi16(FLEET_COST_TIER - 1);
+    const __m128i tier = _mm_set1_epi16(FLEET_COST_TIER);
+    const __m128i none = _mm_set1_epi16(FLEET_COST_NONE);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lowest = none;
+#else
+    const int lanes = 1;
+    int lowest = FLEET_COST_NONE;
+#endif
+    const int16_t *position = fleet.position.data() + w * FLEET_WORD_BITS;
+    const uint64_t upWord = fleet.goingUp.words[w];
+    const uint64_t idleWord = eligible.words[w] & fleet.idle.words[w];
+    const uint64_t movingWord = eligible.words[w] & fleet.moving.words[w];
+    for (int j = 0; j < FLEET_WORD_BITS; j += lanes) {
+        unsigned up = static_cast<unsigned>(upWord >> j);
+        unsigned idle = static_cast<unsigned>(idleWord >> j);
+        unsigned moving = static_cast<unsigned>(movingWord >> j);
+#if defined(__AVX2__)
+        __m256i pos = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&position[j]));
+        __m256i distance = _mm256_min_epi16(_mm256_abs_epi16(_mm256_subs_epi16(pos, target)), maxDistance);
+        __m256i goingUp = bitLanes(up);
+        // Heading toward the floor: going up from at or below it, or down from at or above it.
+        __m256i away = _mm256_or_si256(_mm256_and_si256(goingUp, _mm256_cmpgt_epi16(pos, target)),
+                                       _mm256_andnot_si256(goingUp, _mm256_cmpgt_epi16(target, pos)));
+        __m256i toward = _mm256_andnot_si256(away, bitLanes(moving));
+        __m256i cost = _mm256_blendv_epi8(none, _mm256_add_epi16(tier, distance), toward);
+        __m256i idleCost = _mm256_andnot_si256(_mm256_cmpeq_epi16(distance, zero),
+                                               _mm256_add_epi16(_mm256_add_epi16(tier, tier), distance));
+        cost = _mm256_min_epi16(cost, _mm256_blendv_epi8(none, idleCost, bitLanes(idle)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&costs[j]), cost);
+        lowest = _mm256_min_epi16(lowest, cost);
+#elif defined(__SSE2__)
+        __m128i pos = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&position[j]));
+        __m128i diff = _mm_subs_epi16(pos, target);
+        __m128i distance = _mm_min_epi16(_mm_max_epi16(diff, _mm_subs_epi16(zero, diff)), maxDistance);
+        __m128i goingUp = bitLanes(up);
+        // Heading toward the floor: going up from at or below it, or down from at or above it.
+        __m128i away = _mm_or_si128(_mm_and_si128(goingUp, _mm_cmpgt_epi16(pos, target)),
+                                    _mm_andnot_si128(goingUp, _mm_cmplt_epi16(pos, target)));
+        __m128i toward = _mm_andnot_si128(away, bitLanes(moving));
+        __m128i cost = _mm_or_si128(_mm_and_si128(toward, _mm_add_epi16(tier, distance)), _mm_andnot_si128(toward, none));
+        __m128i idleCost = _mm_andnot_si128(_mm_cmpeq_epi16(distance, zero),
+                                            _mm_add_epi16(_mm_add_epi16(tier, tier), distance));
+        __m128i idleLanes = bitLanes(idle);
+        cost = _mm_min_epi16(cost, _mm_or_si128(_mm_and_si128(idleLanes, idleCost), _mm_andnot_si128(idleLanes, none)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&costs[j]), cost);
+        lowest = _mm_min_epi16(lowest, cost);
+#else
+        int pos = position[j];
+        int distance = std::min(std::abs(pos - floor), FLEET_COST_TIER - 1);
+        bool toward = (up & 1) ? pos <= floor : pos >= floor;
+        int cost = FLEET_COST_NONE;
+        if ((moving & 1) && toward)
+            cost = FLEET_COST_TIER + distance;
+        if (idle & 1)
+            cost = std::min(cost, distance == 0 ? 0 : 2 * FLEET_COST_TIER + distance);
+        costs[j] = static_cast<int16_t>(cost);
+        lowest = std::min(lowest, cost);
+#endif
+    }
+#if defined(__SSE2__)
+    return lowestLane(lowest);
+#else
+    return lowest;
+#endif
+}
+
+// The lowest cost in costs[0, count) and the first car with it (-1 if every cost is
+// FLEET_COST_NONE). A vector min across the array, then a compare to find the car.
+static int lowestCost(const int16_t *costs, int count, int &cost) {
+    int lowest = FLEET_COST_NONE;
+#if defined(__AVX2__)
+    __m256i minimum = _mm256_set1_epi16(FLEET_COST_NONE);
+    for (int car = 0; car < count; car += 16)
+        minimum = _mm256_min_epi16(minimum, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&costs[car])));
+    lowest = lowestLane(minimum);
+    const __m256i wanted = _mm256_set1_epi16(static_cast<int16_t>(lowest));
+    for (int car = 0; lowest != FLEET_COST_NONE && car < count; car += 16) {
+        __m256i match = _mm256_cmpeq_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&costs[car])), wanted);
+        unsigned bits = static_cast<unsigned>(_mm256_movemask_epi8(match));
+        if (bits != 0) {
+            cost = lowest;
+            return car + __builtin_ctz(bits) / 2;
+        }
+    }
+#elif defined(__SSE2__)
+    __m128i minimum = _mm_set1_epi16(FLEET_COST_NONE);
+    for (int car = 0; car < count; car += 8)
+        minimum = _mm_min_epi16(minimum, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&costs[car])));
+    lowest = lowestLane(minimum);
+    const __m128i wanted = _mm_set1_epi16(static_cast<int16_t>(lowest));
+    for (int car = 0; lowest != FLEET_COST_NONE && car < count; car += 8) {
+        __m128i match = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&costs[car])), wanted);
+        unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(match));
+        if (bits != 0) {
+            cost = lowest;
+            return car + __builtin_ctz(bits) / 2;
+        }
+    }
+#else
+    int best = -1;
+    for (int car = 0; car < count; car++) {
+        if (costs[car] < lowest) {
+            lowest = costs[car];
+            best = car;
+        }
+    }
+    if (best >= 0) {
+        cost = lowest;
+        return best;
+    }
+#endif
+    cost = FLEET_COST_NONE;
+    return -1;
+}
+
+// Keep car if it ranks first or second so far. Cars are offered in index order,
+// so a tie stays with the car already held.
+static void offer(FleetChoice &choice, int car, int cost) {
+    if (cost < choice.bestCost) {
+        choice.runnerUp = choice.best;
+        choice.runnerUpCost = choice.bestCost;
+        choice.best = car;
+        choice.bestCost = cost;
+    } else if (cost < choice.runnerUpCost) {
+        choice.runnerUp = car;
+        choice.runnerUpCost = cost;
+    }
+}
+
+// One mask word at a time, filter and costs together, so a word can be skipped or end
+// the search. A word that beats the runner-up so far gives up its two cheapest cars.
+FleetChoice Fleet::cheapest(int floor, int passengers, FleetMask &eligible, std::vector<int16_t> &costs) const {
+    const LoadLimits limits = loadLimits(passengers);
+    eligible.resize(cars);
+    costs.resize(eligible.words.size() * FLEET_WORD_BITS);
+    FleetChoice choice = {-1, FLEET_COST_NONE, -1, FLEET_COST_NONE};
+    for (size_t w = 0; w < eligible.words.size(); w++) {
+        const int base = static_cast<int>(w) * FLEET_WORD_BITS;
+        eligible.words[w] = eligibleWord(*this, limits, w);
+        int16_t *wordCosts = &costs[base];
+        // Only an eligible idle or moving car has a cost.
+        if ((eligible.words[w] & (idle.words[w] | moving.words[w])) == 0) {
+            std::fill(wordCosts, wordCosts + FLEET_WORD_BITS, static_cast<int16_t>(FLEET_COST_NONE));
+            continue;
+        }
+        if (dispatchCosts(*this, floor, eligible, w, wordCosts) >= choice.runnerUpCost)
+            continue;
+        int cost, nextCost;
+        int car = lowestCost(wordCosts, FLEET_WORD_BITS, cost);
+        // Hide the word's winner for a second search, then put its cost back.
+        wordCosts[car] = FLEET_COST_NONE;
+        int next = lowestCost(wordCosts, FLEET_WORD_BITS, nextCost);
+        wordCosts[car] = static_cast<int16_t>(cost);
+        offer(choice, base + car, cost);
+        if (next >= 0)
+            offer(choice, base + next, nextCost);
+        // Two idle cars at the floor: nothing later can come first or second.
+        if (choice.runnerUpCost == 0)
+            break;
+    }
+    return choice;
+}
+
+// estimateEta() per car, lane by lane. Distances stay in int16 (floors are small);
+// _mm_madd_epi16 then weighs distance and queued trips into one int32 ETA per car,
+// four cars per register. AVX2 builds use the same path: its unpacks work within
+// 128-bit halves, so the wider form would need a permute per step.
+void Fleet::etas(int floor, const FleetMask &eligible, std::vector<int> &etas) const {
+    etas.resize(eligible.words.size() * FLEET_WORD_BITS);
+#ifdef __SSE2__
+    const __m128i target = _mm_set1_epi16(static_cast<int16_t>(floor));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weights = _mm_set1_epi32((ETA_SECONDS_PER_TRIP << 16) | ETA_SECONDS_PER_FLOOR);
+    const __m128i unreachable = _mm_set1_epi32(ETA_UNREACHABLE);
+    const __m128i select = _mm_setr_epi32(0x1, 0x2, 0x4, 0x8);
+#endif
+    for (size_t w = 0; w < eligible.words.size(); w++) {
+        const int base = static_cast<int>(w) * FLEET_WORD_BITS;
+        const uint64_t word = eligible.words[w];
+        if (word == 0) {
+            std::fill(&etas[base], &etas[base] + FLEET_WORD_BITS, ETA_UNREACHABLE);
+            continue;
+        }
+#ifdef __SSE2__
+        for (int j = 0; j < FLEET_WORD_BITS; j += 8) {
+            int car = base + j;
+            __m128i pos = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&position[car]));
+            __m128i end = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&tripEndFloor[car]));
+            __m128i trips = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&queuedTrips[car]));
+            __m128i direct = _mm_sub_epi16(_mm_max_epi16(pos, target), _mm_min_epi16(pos, target));
+            // Busy: finish the queued trips, then travel from the last drop-off.
+            __m128i viaEnd = _mm_add_epi16(_mm_sub_epi16(_mm_max_epi16(pos, end), _mm_min_epi16(pos, end)),
+                                           _mm_sub_epi16(_mm_max_epi16(end, target), _mm_min_epi16(end, target)));
+            __m128i noTrips = _mm_cmpeq_epi16(trips, zero);
+            __m128i distance = _mm_or_si128(_mm_and_si128(noTrips, direct), _mm_andnot_si128(noTrips, viaEnd));
+            unsigned bits = static_cast<unsigned>(word >> j);
+            for (int half = 0; half < 2; half++) {
+                __m128i pairs = half ? _mm_unpackhi_epi16(distance, trips) : _mm_unpacklo_epi16(distance, trips);
+                __m128i eta = _mm_madd_epi16(pairs, weights);
+                __m128i ok = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(bits >> (4 * half)), select), select);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(&etas[car + 4 * half]),
+                                 _mm_or_si128(_mm_and_si128(ok, eta), _mm_andnot_si128(ok, unreachable)));
+            }
+        }
+#else
+        for (int j = 0; j < FLEET_WORD_BITS; j++) {
+            int car = base + j;
+            int eta = ETA_UNREACHABLE;
+            if ((word >> j) & 1) {
+                if (queuedTrips[car] == 0)
+                    eta = std::abs(position[car] - floor) * ETA_SECONDS_PER_FLOOR;
+                else
+                    eta = (std::abs(position[car] - tripEndFloor[car]) + std::abs(tripEndFloor[car] - floor)) *
+                              ETA_SECONDS_PER_FLOOR + queuedTrips[car] * ETA_SECONDS_PER_TRIP;
+            }
+            etas[car] = eta;
+        }
+#endif
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef FLEET_HPP
+#define FLEET_HPP
+
+#include <cstdint>
+#include <vector>
+
+#define FLEET_WORD_BITS 64   // Cars per mask word
+#define FLEET_COST_TIER 4096 // Gap between dispatch passes in a car's cost; more than any distance
+#define FLEET_COST_NONE 32767 // Cost of a car no pass would choose (INT16_MAX)
+
+// One bit per car, FLEET_WORD_BITS cars to a word. Bits past the fleet size stay clear.
+struct FleetMask {
+    std::vector<uint64_t> words;
+
+    void resize(int cars) { words.assign((cars + FLEET_WORD_BITS - 1) / FLEET_WORD_BITS, 0); }
+    bool test(int car) const { return (words[car / FLEET_WORD_BITS] >> (car % FLEET_WORD_BITS)) & 1; }
+    void set(int car, bool value) {
+        uint64_t bit = uint64_t(1) << (car % FLEET_WORD_BITS);
+        uint64_t &word = words[car / FLEET_WORD_BITS];
+        word = value ? (word | bit) : (word & ~bit);
+    }
+    // Lowest set car, or -1.
+    int first() const;
+};
+
+// The two cheapest cars for a call; -1 where there is no such car.
+struct FleetChoice {
+    int best;
+    int bestCost;
+    int runnerUp;
+    int runnerUpCost;
+};
+
+// The scheduler's view of one bank's cars, as a structure of arrays: one array per
+// field, indexed by car (elevator id firstId + car), so a dispatch pass streams only
+// the fields it reads. Flags are FleetMasks. Car addresses are not here; they are
+// only needed to send, and live with the shard.
+//
+// The arrays are padded to whole mask words so the filters below run in full SIMD
+// lanes with no tail loop; entries past size() are never read for their values.
+struct Fleet {
+    int firstId;
+    int cars;
+    std::vector<int16_t> position;
+    std::vector<int16_t> passengerCount;   // Persons on board, as last reported by the car
+    std::vector<int16_t> loadKg;           // Weight on board, as last reported by the car
+    std::vector<int16_t> reservedPersons;  // Persons assigned to the car who have not boarded yet
+    std::vector<int16_t> queuedTrips;      // Trips assigned to the car and not yet completed
+    std::vector<int16_t> tripEndFloor;     // Destination of the last trip assigned to the car
+    std::vector<int16_t> parkingFloor;     // Floor the idle car was last sent to park at (-1 if none)
+    FleetMask idle;
+    FleetMask moving;
+    FleetMask goingUp;
+    FleetMask faulted;                // No longer set automatically on timeout
+    FleetMask awaitingRegistration;   // Recovered state not yet confirmed by the car (msgType 8)
+
+    Fleet() : firstId(0), cars(0) {}
+    // count idle cars at floor, ids firstId onwards.
+    Fleet(int firstId, int count, int floor);
+
+    int size() const { return cars; }
+    int id(int car) const { return firstId + car; }
+
+    // Copy one car's state from another fleet of the same layout.
+    void copyCar(const Fleet &from, int car);
+
+    // Cars that could take a call for `passengers` more persons: not faulted, registered,
+    // below the bypass load and with room for the group (see load_model.hpp).
+    void eligible(int passengers, FleetMask &out) const;
+
+    // Cost of each car eligible for a call by `passengers` at floor, written to costs (one
+    // entry per padded car), and the two cheapest; eligible receives the mask. The cost ranks
+    // cars the way the greedy dispatcher's passes do: an idle car at the floor (0), then a
+    // moving car heading toward the floor (FLEET_COST_TIER + distance), then any idle car
+    // (2 * FLEET_COST_TIER + distance). Everything else costs FLEET_COST_NONE. Ties go to
+    // the lowest index.
+    // The search stops after the mask word holding the second car of cost 0, since no later
+    // car can displace either: mask words past it stay clear and costs past it are left as
+    // they were. A search that finds no car always covers the whole fleet.
+    FleetChoice cheapest(int floor, int passengers, FleetMask &eligible, std::vector<int16_t> &costs) const;
+
+    // Seconds for each car to reach floor, as estimateEta() in the scheduler works it out
+    // one car at a time, written to etas (one entry per padded car). Cars outside eligible
+    // get ETA_UNREACHABLE.
+    void etas(int floor, const FleetMask &eligible, std::vector<int> &etas) const;
+};
+
+#endif // FLEET_HPP
@@ -0,0 +1,191 @@
+// fleet_simple_test.cpp
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include "fleet.hpp"
+#include "load_model.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+// Test the eligibility mask against the scalar load model
+int testEligible() {
+    std::cout << "\n=== Testing Fleet Eligibility ===" << std::endl;
+
+    std::cout << "  Test Case 1: Every load and group size agrees with shouldBypass/canBoard" << std::endl;
+    // One car per (persons, kg, reserved) combination, across several mask words.
+    Fleet fleet(0, (RATED_PERSONS + 1) * 12 * 4, 1);
+    int car = 0;
+    for (int persons = 0; persons <= RATED_PERSONS; persons++) {
+        for (int step = 0; step < 12; step++) {
+            for (int reserved = 0; reserved < 4; reserved++, car++) {
+                fleet.passengerCount[car] = persons;
+                fleet.loadKg[car] = step * 100;
+                fleet.reservedPersons[car] = reserved;
+            }
+        }
+    }
+    bool agrees = true;
+    FleetMask mask;
+    for (int group = 1; group <= RATED_PERSONS + 1; group++) {
+        fleet.eligible(group, mask);
+        for (car = 0; car < fleet.size(); car++) {
+            int persons = fleet.passengerCount[car] + fleet.reservedPersons[car];
+            int kg = fleet.loadKg[car] + passengerWeightKg(fleet.reservedPersons[car]);
+            bool expected = !shouldBypass(persons, kg) && canBoard(persons, kg, group);
+            if (mask.test(car) != expected)
+                agrees = false;
+        }
+    }
+    TEST_ASSERT(agrees, "Mask should match the scalar checks for every car");
+
+    std::cout << "  Test Case 2: Faulted and unregistered cars are never eligible" << std::endl;
+    Fleet small(0, 3, 1);
+    small.faulted.set(0, true);
+    small.awaitingRegistration.set(2, true);
+    small.eligible(1, mask);
+    TEST_ASSERT(!mask.test(0) && mask.test(1) && !mask.test(2), "Only car 1 should be eligible");
+
+    std::cout << "  Test Case 3: Bits past the fleet size stay clear" << std::endl;
+    Fleet partial(0, 70, 1);
+    partial.eligible(1, mask);
+    TEST_ASSERT(mask.words.size() == 2 && mask.words[1] == (uint64_t(1) << 6) - 1,
+                "Second word should hold exactly 6 cars");
+
+    std::cout << "Fleet Eligibility: All tests passed" << std::endl;
+    return 0;
+}
+
+// The greedy dispatcher's passes, one car at a time.
+static int referenceCost(const Fleet &fleet, const FleetMask &eligible, int car, int floor) {
+    if (!eligible.test(car))
+        return FLEET_COST_NONE;
+    int distance = std::abs(fleet.position[car] - floor);
+    if (fleet.idle.test(car) && distance == 0)
+        return 0;
+    bool up = fleet.goingUp.test(car);
+    if (fleet.moving.test(car) && ((up && floor >= fleet.position[car]) || (!up && floor <= fleet.position[car])))
+        return FLEET_COST_TIER + distance;
+    if (fleet.idle.test(car))
+        return 2 * FLEET_COST_TIER + distance;
+    return FLEET_COST_NONE;
+}
+
+// Test the dispatch cost kernel
+int testCheapest() {
+    std::cout << "\n=== Testing Fleet Dispatch Costs ===" << std::endl;
+
+    std::cout << "  Test Case 1: Passes are ranked like the greedy dispatcher" << std::endl;
+    Fleet fleet(0, 4, 1);
+    FleetMask eligible, full;
+    std::vector<int16_t> costs;
+    fleet.position[0] = 3;                               // Idle, 3 floors from 6
+    fleet.idle.set(1, false); fleet.moving.set(1, true);
+    fleet.position[1] = 10; fleet.goingUp.set(1, false); // Moving down toward 6
+    fleet.idle.set(2, false); fleet.moving.set(2, true);
+    fleet.position[2] = 8;                               // Moving up, away from 6
+    fleet.position[3] = 6; fleet.faulted.set(3, true);   // At the floor but faulted
+    FleetChoice choice = fleet.cheapest(6, 1, eligible, costs);
+    TEST_ASSERT(choice.best == 1 && choice.bestCost == FLEET_COST_TIER + 4,
+                "Car moving toward the floor should beat a nearer idle car");
+    TEST_ASSERT(choice.runnerUp == 0 && choice.runnerUpCost == 2 * FLEET_COST_TIER + 3, "Idle car should be runner-up");
+    TEST_ASSERT(costs[2] == FLEET_COST_NONE && costs[3] == FLEET_COST_NONE, "Car moving away and faulted car are never chosen");
+
+    std::cout << "  Test Case 2: An idle car at the floor wins outright" << std::endl;
+    fleet.faulted.set(3, false);
+    choice = fleet.cheapest(6, 1, eligible, costs);
+    TEST_ASSERT(choice.best == 3 && choice.bestCost == 0 && choice.runnerUp == 1, "Car 3 first, car 1 second");
+
+    std::cout << "  Test Case 3: Random fleets match the scalar passes, lowest index on ties" << std::endl;
+    bool agrees = true;
+    unsigned seed = 12345;
+    for (int trial = 0; trial < 200 && agrees; trial++) {
+        seed = seed * 1103515245 + 12345;
+        Fleet random(0, 1 + (seed >> 16) % 300, 1);
+        for (int car = 0; car < random.size(); car++) {
+            seed = seed * 1103515245 + 12345;
+            unsigned r = seed >> 8;
+            bool idle = r & 1;
+            random.idle.set(car, idle);
+            random.moving.set(car, !idle && (r & 2));
+            random.goingUp.set(car, r & 4);
+            random.faulted.set(car, (r & 0xf0) == 0);
+            random.position[car] = 1 + (r >> 8) % 22;
+            random.passengerCount[car] = (r >> 16) % (RATED_PERSONS + 1);
+            random.loadKg[car] = passengerWeightKg(random.passengerCount[car]);
+        }
+        int floor = 1 + (seed >> 20) % 22;
+        choice = random.cheapest(floor, 2, eligible, costs);
+        // Mask and costs are only written up to the word where a second car at cost 0 ends the search.
+        int searched = choice.runnerUpCost == 0 ? (choice.runnerUp / FLEET_WORD_BITS + 1) * FLEET_WORD_BITS
+                                                : random.size();
+        random.eligible(2, full);
+        int best = -1, bestCost = FLEET_COST_NONE, second = -1, secondCost = FLEET_COST_NONE;
+        for (int car = 0; car < random.size(); car++) {
+            int cost = referenceCost(random, full, car, floor);
+            if (car < searched && (cost != costs[car] || eligible.test(car) != full.test(car)))
+                agrees = false;
+            if (cost < bestCost) {
+                second = best; secondCost = bestCost;
+                best = car; bestCost = cost;
+            } else if (cost < secondCost) {
+                second = car; secondCost = cost;
+            }
+        }
+        if (choice.best != best || choice.runnerUp != second ||
+            (best >= 0 && choice.bestCost != bestCost) || (second >= 0 && choice.runnerUpCost != secondCost))
+            agrees = false;
+    }
+    TEST_ASSERT(agrees, "Mask, costs, best and runner-up should match the reference for every fleet");
+
+    std::cout << "  Test Case 4: No eligible car" << std::endl;
+    choice = fleet.cheapest(6, RATED_PERSONS + 1, eligible, costs);
+    TEST_ASSERT(choice.best == -1 && choice.runnerUp == -1, "A group larger than any car should give -1 for both");
+    TEST_ASSERT(eligible.first() == -1, "Empty mask should be returned");
+
+    std::cout << "  Test Case 5: Words with no candidate are skipped; two idle cars at the floor end the search" << std::endl;
+    Fleet large(0, 3 * FLEET_WORD_BITS, 1);
+    for (int car = 0; car < FLEET_WORD_BITS; car++)
+        large.faulted.set(car, true);                   // First word: nobody eligible
+    large.position[FLEET_WORD_BITS + 5] = 6;
+    large.position[FLEET_WORD_BITS + 9] = 6;
+    large.position[2 * FLEET_WORD_BITS] = 6;            // Idle at the floor, but later
+    costs.assign(3 * FLEET_WORD_BITS, -1);
+    choice = large.cheapest(6, 1, eligible, costs);
+    TEST_ASSERT(choice.best == FLEET_WORD_BITS + 5 && choice.runnerUp == FLEET_WORD_BITS + 9 &&
+                choice.bestCost == 0 && choice.runnerUpCost == 0, "First two idle cars at the floor should be chosen");
+    TEST_ASSERT(costs[0] == FLEET_COST_NONE && costs[2 * FLEET_WORD_BITS] == -1 && !eligible.test(2 * FLEET_WORD_BITS),
+                "Skipped word should cost FLEET_COST_NONE; the word after the stop is not searched");
+
+    std::cout << "Fleet Dispatch Costs: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING FLEET TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testEligible();
+    failures += testCheapest();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " FLEET TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " FLEET TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
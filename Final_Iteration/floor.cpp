@@ -1,5 +1,7 @@
 /* floor.cpp */
 #include "message.hpp"
+#include "load_model.hpp"
+#include "floor.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -7,7 +9,6 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <mutex>
-#include <thread>
 #include <random>
 
 #define SCHEDULER_IP "127.0.0.1"
@@ -15,100 +16,159 @@
 #define INPUT_FILE "input.txt"
 #define MIN_FLOOR 1
 #define MAX_FLOOR 22 
+#define REQUEST_INTERVAL_MS 4000  // Gap between hall calls
 
 extern std::mutex printMutex;
 
-void floorFunction() {
-    int timer = 0;
-    std::ifstream infile(INPUT_FILE);
-    if (!infile.is_open()) {
-        std::cerr << "[FLOOR] Error opening input file: " << INPUT_FILE << "\n";
-        return;
+// Print every car assignment notice (msgType = 6) the scheduler has sent back.
+static void reportAssignments(int sockfd) {
+    ElevatorMessage notice;
+    while (recv(sockfd, &notice, sizeof(notice), MSG_DONTWAIT) == sizeof(notice)) {
+        if (notice.msgType != 6) continue;
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[FLOOR] Passenger(s) at Floor " << notice.floorNumber << " going to Floor "
+                  << notice.destination << ": please board Elevator " << notice.assignedElevator << "\n";
     }
+}
 
-    int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
-    if (sockfd < 0) {
-        std::cerr << "[FLOOR] Error creating socket\n";
-        return;
+bool parseHallCall(const std::string &line, HallCall &call) {
+    if (line.empty()) return false;
+    // Expected format: pickup_floor, direction [, faultCode [, passengers]]
+    std::istringstream iss(line);
+    std::string floorStr, directionStr, faultStr, passengerStr;
+    if (!std::getline(iss, floorStr, ',')) return false;
+    if (!std::getline(iss, directionStr, ',')) return false;
+
+    std::getline(iss, faultStr, ',');
+    std::getline(iss, passengerStr, ',');
+
+
+    floorStr.erase(0, floorStr.find_first_not_of(" \t"));
+    floorStr.erase(floorStr.find_last_not_of(" \t") + 1);
+    directionStr.erase(0, directionStr.find_first_not_of(" \t"));
+    directionStr.erase(directionStr.find_last_not_of(" \t") + 1);
+    faultStr.erase(0, faultStr.find_first_not_of(" \t"));
+    faultStr.erase(faultStr.find_last_not_of(" \t") + 1);
+    passengerStr.erase(0, passengerStr.find_first_not_of(" \t"));
+    passengerStr.erase(passengerStr.find_last_not_of(" \t") + 1);
+
+    call.pickupFloor = std::stoi(floorStr);
+    call.directionUp = (directionStr == "UP" || directionStr == "up");
+
+    // Determine fault code.
+    call.faultCode = 0;
+    if (!faultStr.empty()) {
+        call.faultCode = std::stoi(faultStr);
     }
 
-    struct sockaddr_in schedulerAddr;
-    memset(&schedulerAddr, 0, sizeof(schedulerAddr));
-    schedulerAddr.sin_family = AF_INET;
-    schedulerAddr.sin_port = htons(SCHEDULER_PORT);
-    inet_pton(AF_INET, SCHEDULER_IP, &schedulerAddr.sin_addr);
+    // Number of passengers waiting behind this hall call (default 1).
+    call.passengers = 1;
+    if (!passengerStr.empty()) {
+        call.passengers = std::stoi(passengerStr);
+        if (call.passengers < 1) call.passengers = 1;
+        if (call.passengers > RATED_PERSONS) call.passengers = RATED_PERSONS;
+    }
+    return true;
+}
+
+FloorActor::FloorActor() : sockfd_(-1), timer_(0) {
+    memset(&schedulerAddr_, 0, sizeof(schedulerAddr_));
+    schedulerAddr_.sin_family = AF_INET;
+    schedulerAddr_.sin_port = htons(SCHEDULER_PORT);
+    inet_pton(AF_INET, SCHEDULER_IP, &schedulerAddr_.sin_addr);
 
     // Set up random number generator for destination floor.
     std::random_device rd;
-    std::mt19937 gen(rd());
-
-    std::string line;
-    while (std::getline(infile, line)) {
-        if (line.empty()) continue;
-        // Expected format: pickup_floor, direction [, faultCode]
-        std::istringstream iss(line);
-        std::string floorStr, directionStr, faultStr;
-        if (!std::getline(iss, floorStr, ',')) continue;
-        if (!std::getline(iss, directionStr, ',')) continue;
-    
-        std::getline(iss, faultStr, ',');
-
-
-        floorStr.erase(0, floorStr.find_first_not_of(" \t"));
-        floorStr.erase(floorStr.find_last_not_of(" \t") + 1);
-        directionStr.erase(0, directionStr.find_first_not_of(" \t"));
-        directionStr.erase(directionStr.find_last_not_of(" \t") + 1);
-        faultStr.erase(0, faultStr.find_first_not_of(" \t"));
-        faultStr.erase(faultStr.find_last_not_of(" \t") + 1);
-
-        int pickupFloor = std::stoi(floorStr);
-        bool directionUp = (directionStr == "UP" || directionStr == "up");
-
-        // If at boundary, flip direction.
-        if (pickupFloor == MIN_FLOOR && !directionUp) {
-            std::lock_guard<std::mutex> lock(printMutex);
-            std::cout << "[FLOOR] Request at MIN floor " << pickupFloor << " with DOWN, flipping to UP\n";
-            directionUp = true;
-        }
-        if (pickupFloor == MAX_FLOOR && directionUp) {
-            std::lock_guard<std::mutex> lock(printMutex);
-            std::cout << "[FLOOR] Request at MAX floor " << pickupFloor << " with UP, flipping to DOWN\n";
-            directionUp = false;
-        }
-
-        // Generate destination floor based on direction.
-        int destination = pickupFloor;
-        if (directionUp) {
-            std::uniform_int_distribution<int> dist(pickupFloor + 1, MAX_FLOOR);
-            destination = dist(gen);
-        } else {
-            std::uniform_int_distribution<int> dist(MIN_FLOOR, pickupFloor - 1);
-            destination = dist(gen);
-        }
-        
-        // Determine fault code.
-        int faultCode = 0;
-        if (!faultStr.empty()) {
-            faultCode = std::stoi(faultStr);
-        }
-
-        // Create and send the request message.
-        ElevatorMessage msg(pickupFloor, destination, directionUp, -1, timer);
-        msg.msgType = 0; 
-        msg.faultCode = faultCode;
-        sendto(sockfd, &msg, sizeof(msg), 0, (struct sockaddr*)&schedulerAddr, sizeof(schedulerAddr));
-
-        {
-            std::lock_guard<std::mutex> lock(printMutex);
-            std::cout << "[FLOOR] Sent request: Pickup Floor " << pickupFloor 
-                      << ", Direction " << (directionUp ? "UP" : "DOWN")
-                      << ", Generated Destination " << destination 
-                      << ", FaultCode " << faultCode 
-                      << " at time " << timer << "\n";
-        }
-        timer += 4;
-        std::this_thread::sleep_for(std::chrono::seconds(4));
+    gen_.seed(rd());
+}
+
+FloorActor::~FloorActor() {
+    if (sockfd_ >= 0)
+        close(sockfd_);
+}
+
+bool FloorActor::open() {
+    infile_.open(INPUT_FILE);
+    if (!infile_.is_open()) {
+        std::cerr << "[FLOOR] Error opening input file: " << INPUT_FILE << "\n";
+        return false;
     }
-    infile.close();
-    close(sockfd);
+
+    sockfd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sockfd_ < 0) {
+        std::cerr << "[FLOOR] Error creating socket\n";
+        return false;
+    }
+    return true;
+}
+
+void FloorActor::sendRequest() {
+    int pickupFloor = call_.pickupFloor;
+    bool directionUp = call_.directionUp;
+
+    // If at boundary, flip direction.
+    if (pickupFloor == MIN_FLOOR && !directionUp) {
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[FLOOR] Request at MIN floor " << pickupFloor << " with DOWN, flipping to UP\n";
+        directionUp = true;
+    }
+    if (pickupFloor == MAX_FLOOR && directionUp) {
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[FLOOR] Request at MAX floor " << pickupFloor << " with UP, flipping to DOWN\n";
+        directionUp = false;
+    }
+
+    // Generate destination floor based on direction.
+    int destination = pickupFloor;
+    if (directionUp) {
+        std::uniform_int_distribution<int> dist(pickupFloor + 1, MAX_FLOOR);
+        destination = dist(gen_);
+    } else {
+        std::uniform_int_distribution<int> dist(MIN_FLOOR, pickupFloor - 1);
+        destination = dist(gen_);
+    }
+
+    int faultCode = call_.faultCode;
+    int passengers = call_.passengers;
+
+    // Create and send the request message.
+    ElevatorMessage msg(pickupFloor, destination, directionUp, -1, timer_);
+    msg.msgType = 0;
+    msg.faultCode = faultCode;
+    msg.passengers = passengers;
+    sendto(sockfd_, &msg, sizeof(msg), 0, (struct sockaddr*)&schedulerAddr_, sizeof(schedulerAddr_));
+
+    {
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[FLOOR] Sent request: Pickup Floor " << pickupFloor
+                  << ", Direction " << (directionUp ? "UP" : "DOWN")
+                  << ", Generated Destination " << destination
+                  << ", FaultCode " << faultCode
+                  << ", Passengers " << passengers
+                  << " at time " << timer_ << "\n";
+    }
+}
+
+// Kept across ACTOR_AWAIT, as members: infile_ and line_ for the position in the
+// input, call_ for the call just sent, timer_ and sockfd_.
+void FloorActor::run() {
+    ACTOR_BEGIN;
+    while (std::getline(infile_, line_)) {
+        if (!parseHallCall(line_, call_)) continue;
+        sendRequest();
+        timer_ += REQUEST_INTERVAL_MS / 1000;
+        ACTOR_AWAIT(sleepFor(REQUEST_INTERVAL_MS));
+        reportAssignments(sockfd_);
+    }
+    reportAssignments(sockfd_);
+    infile_.close();
+    ACTOR_END;
+}
+
+void floorFunction() {
+    FloorActor floor;
+    if (!floor.open()) return;
+    ActorExecutor executor;
+    executor.spawn(floor);
+    executor.run();
 }
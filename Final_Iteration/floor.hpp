@@ -1,6 +1,50 @@
 #ifndef FLOOR_HPP
 #define FLOOR_HPP
 
+#include "actor.hpp"
+#include <fstream>
+#include <random>
+#include <string>
+#include <netinet/in.h>
+
+// One hall call as read from the input file, before a destination is chosen.
+struct HallCall {
+    int pickupFloor;
+    bool directionUp;
+    int faultCode;
+    int passengers;
+};
+
+// Parse "pickup_floor, direction [, faultCode [, passengers]]".
+// Returns false for lines that do not hold a request.
+bool parseHallCall(const std::string &line, HallCall &call);
+
+// Replays the input file as hall calls, one every REQUEST_INTERVAL_MS.
+class FloorActor : public Actor {
+public:
+    FloorActor();
+    ~FloorActor();
+
+    FloorActor(const FloorActor &) = delete;
+    FloorActor &operator=(const FloorActor &) = delete;
+
+    // Open the input file and the socket; false (with a message) if either fails.
+    bool open();
+
+    void run() override;
+
+private:
+    void sendRequest();
+
+    std::ifstream infile_;
+    int sockfd_;
+    struct sockaddr_in schedulerAddr_;
+    std::mt19937 gen_;
+    std::string line_;
+    HallCall call_;
+    int timer_;
+};
+
 void floorFunction();
 
 #endif
@@ -0,0 +1,22 @@
+// floor_node.cpp
+// Runs the floor subsystem as its own process: replays input.txt as hall
+// calls to the scheduler and exits when the file is done.
+//
+// Usage: ./floor_node [--cpu LIST] [--nice N] [--rt-priority N]
+#include <iostream>
+#include "floor.hpp"
+#include "process_options.hpp"
+
+int main(int argc, char *argv[]) {
+    ProcessOptions options;
+    for (int i = 1; i < argc; i++) {
+        if (!parseProcessOption(argc, argv, i, options)) {
+            std::cerr << "Usage: " << argv[0] << " " PROCESS_OPTIONS_USAGE "\n";
+            return 1;
+        }
+    }
+    applyProcessOptions(options, "FLOOR");
+
+    floorFunction();
+    return 0;
+}
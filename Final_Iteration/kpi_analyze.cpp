@@ -0,0 +1,133 @@
+// kpi_analyze.cpp
+// Rebuilds every hall call's lifecycle from event traces and reports wait,
+// travel and utilisation KPIs per floor, per car and per simulated hour.
+//
+// Usage: ./kpi_analyze [-j threads] trace.bin [more.bin ...]
+//        ./kpi_analyze [-j threads] --diff baseline.bin candidate.bin
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <thread>
+#include "kpi_analyzer.hpp"
+
+static bool load(const std::vector<std::string> &paths, int threads, RunKpi &run, double &seconds) {
+    auto start = std::chrono::steady_clock::now();
+    if (!analyzeTraces(paths, threads, run)) {
+        std::cerr << "[KPI] Could not read the traces; each must be written by the simulation\n";
+        return false;
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+static void printRun(RunKpi &run) {
+    std::cout << "Requests: " << run.requests << " (" << run.completed << " completed, "
+              << run.faults << " faults) from " << run.events << " events" << std::endl;
+    std::cout << "Wait   mean/p50/p95: " << run.wait.mean() << " / " << run.wait.percentile(50)
+              << " / " << run.wait.percentile(95) << " s" << std::endl;
+    std::cout << "Travel mean/p50/p95: " << run.travel.mean() << " / " << run.travel.percentile(50)
+              << " / " << run.travel.percentile(95) << " s" << std::endl;
+
+    std::cout << "\n--- Per floor (pickup) ---\nfloor   calls  mean wait  p95 wait" << std::endl;
+    for (auto &entry : run.floors) {
+        std::cout << std::setw(5) << entry.first << std::setw(8) << entry.second.calls
+                  << std::setw(11) << entry.second.wait.mean()
+                  << std::setw(10) << entry.second.wait.percentile(95) << std::endl;
+    }
+
+    std::cout << "\n--- Per car ---\ncar   trips  passengers  floors  doors  faults  utilisation %" << std::endl;
+    for (auto &entry : run.cars) {
+        const CarKpi &car = entry.second;
+        std::cout << std::setw(3) << entry.first << std::setw(8) << car.trips << std::setw(12) << car.passengers
+                  << std::setw(8) << car.floorsTravelled << std::setw(7) << car.doorCycles
+                  << std::setw(8) << car.faults << std::setw(15) << run.utilisation(entry.first) << std::endl;
+    }
+
+    std::cout << "\n--- Per hour (simulated) ---\nhour   calls  mean wait" << std::endl;
+    for (auto &entry : run.hours) {
+        std::cout << std::setw(4) << entry.first << std::setw(8) << entry.second.calls
+                  << std::setw(11) << entry.second.meanWait() << std::endl;
+    }
+}
+
+static void diffLine(const std::string &label, double baseline, double candidate) {
+    std::cout << std::left << std::setw(22) << label << std::right
+              << std::setw(12) << baseline << std::setw(12) << candidate;
+    if (baseline != 0.0)
+        std::cout << std::setw(10) << (candidate - baseline) * 100.0 / baseline << " %";
+    std::cout << std::endl;
+}
+
+static void diffCount(const std::string &label, long baseline, long candidate) {
+    std::cout << std::left << std::setw(22) << label << std::right
+              << std::setw(12) << baseline << std::setw(12) << candidate;
+    if (baseline != 0)
+        std::cout << std::setw(10) << (candidate - baseline) * 100.0 / baseline << " %";
+    std::cout << std::endl;
+}
+
+static void printDiff(RunKpi &baseline, RunKpi &candidate) {
+    std::cout << std::left << std::setw(22) << "metric" << std::right
+              << std::setw(12) << "baseline" << std::setw(12) << "candidate" << std::setw(12) << "change" << std::endl;
+    diffCount("requests", baseline.requests, candidate.requests);
+    diffCount("completed", baseline.completed, candidate.completed);
+    diffCount("faults", baseline.faults, candidate.faults);
+    diffLine("wait mean s", baseline.wait.mean(), candidate.wait.mean());
+    diffLine("wait p95 s", baseline.wait.percentile(95), candidate.wait.percentile(95));
+    diffLine("travel mean s", baseline.travel.mean(), candidate.travel.mean());
+    diffLine("travel p95 s", baseline.travel.percentile(95), candidate.travel.percentile(95));
+
+    std::set<int> floors;
+    for (auto &entry : baseline.floors) floors.insert(entry.first);
+    for (auto &entry : candidate.floors) floors.insert(entry.first);
+    for (int floor : floors)
+        diffLine("floor " + std::to_string(floor) + " wait mean s",
+                 baseline.floors[floor].wait.mean(), candidate.floors[floor].wait.mean());
+
+    std::set<int> cars;
+    for (auto &entry : baseline.cars) cars.insert(entry.first);
+    for (auto &entry : candidate.cars) cars.insert(entry.first);
+    for (int car : cars)
+        diffLine("car " + std::to_string(car) + " utilisation %", baseline.utilisation(car), candidate.utilisation(car));
+}
+
+int main(int argc, char *argv[]) {
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    bool diff = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = std::atoi(argv[++i]);
+        else if (strcmp(argv[i], "--diff") == 0) diff = true;
+        else paths.push_back(argv[i]);
+    }
+    if (threads < 1) threads = 1;
+    if (paths.empty() || (diff && paths.size() != 2)) {
+        std::cerr << "Usage: " << argv[0] << " [-j threads] trace.bin [more.bin ...]\n"
+                  << "       " << argv[0] << " [-j threads] --diff baseline.bin candidate.bin\n";
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    if (diff) {
+        RunKpi baseline, candidate;
+        double baselineSeconds, candidateSeconds;
+        if (!load(std::vector<std::string>(1, paths[0]), threads, baseline, baselineSeconds) ||
+            !load(std::vector<std::string>(1, paths[1]), threads, candidate, candidateSeconds))
+            return 1;
+        std::cout << "=== KPI Diff: " << paths[0] << " vs " << paths[1] << " (analysed in "
+                  << baselineSeconds + candidateSeconds << " s on " << threads << " threads) ===" << std::endl;
+        printDiff(baseline, candidate);
+        return 0;
+    }
+
+    RunKpi run;
+    double seconds;
+    if (!load(paths, threads, run, seconds)) return 1;
+    std::cout << "=== KPI Report: " << paths.size() << " trace(s), analysed in " << seconds
+              << " s on " << threads << " threads ===" << std::endl;
+    printRun(run);
+    return 0;
+}
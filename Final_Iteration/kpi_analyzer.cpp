@@ -0,0 +1,229 @@
+/* kpi_analyzer.cpp */
+#include "kpi_analyzer.hpp"
+#include "event_trace.hpp"
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <utility>
+
+// The part of a trace record needed to follow a hall call.
+struct LifecycleEvent {
+    uint64_t wallNs;
+    int32_t simTime;
+    uint16_t type;
+    int16_t floor;
+    int16_t destination;
+};
+
+// What one thread learns from its slice of a trace.
+struct ChunkResult {
+    long events = 0;
+    long faults = 0;
+    bool any = false;
+    uint64_t firstNs = 0;
+    uint64_t lastNs = 0;
+    std::map<int, CarKpi> cars;
+    std::vector<std::vector<LifecycleEvent>> partitions;  // Hall-call events by partitionOf
+};
+
+// Hall calls matched within one partition.
+struct PartitionResult {
+    long requests = 0;
+    long completed = 0;
+    DurationStats wait;
+    DurationStats travel;
+    std::map<int, FloorKpi> floors;
+    std::map<int, HourKpi> hours;
+};
+
+void DurationStats::add(double seconds) {
+    samples.push_back(static_cast<float>(seconds));
+    totalSeconds += seconds;
+}
+
+void DurationStats::merge(const DurationStats &other) {
+    samples.insert(samples.end(), other.samples.begin(), other.samples.end());
+    totalSeconds += other.totalSeconds;
+}
+
+double DurationStats::mean() const {
+    return samples.empty() ? 0.0 : totalSeconds / samples.size();
+}
+
+double DurationStats::percentile(int pct) {
+    if (samples.empty()) return 0.0;
+    size_t index = std::min(samples.size() - 1, samples.size() * pct / 100);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+double RunKpi::utilisation(int car) const {
+    std::map<int, CarKpi>::const_iterator it = cars.find(car);
+    if (it == cars.end() || durationSeconds <= 0.0) return 0.0;
+    return std::min(100.0, it->second.busySeconds() * 100.0 / durationSeconds);
+}
+
+// Every event of one hall call lands in the same partition, so partitions
+// can be matched independently.
+static int partitionOf(int floor, int destination) {
+    return static_cast<unsigned>(floor * 131 + destination) % KPI_PARTITIONS;
+}
+
+static void scanChunk(const std::string &path, uint64_t first, uint64_t count, ChunkResult &result) {
+    result.partitions.resize(KPI_PARTITIONS);
+    TraceReader reader;
+    if (!reader.open(path) || !reader.seek(first)) return;
+
+    TraceRecord record;
+    for (uint64_t i = 0; i < count && reader.next(record); i++) {
+        if (!result.any) {
+            result.firstNs = record.wallNs;
+            result.any = true;
+        }
+        result.lastNs = record.wallNs;
+        result.events++;
+
+        switch (record.type) {
+        case TRACE_FLOOR_PASS:
+            result.cars[record.elevator].floorsTravelled++;
+            continue;
+        case TRACE_DOOR_OPEN:
+            result.cars[record.elevator].doorCycles++;
+            continue;
+        case TRACE_FAULT:
+            result.cars[record.elevator].faults++;
+            result.faults++;
+            continue;
+        case TRACE_COMPLETION:
+            result.cars[record.elevator].trips++;
+            result.cars[record.elevator].passengers += record.passengers;
+            break;
+        case TRACE_REQUEST_ARRIVAL:
+        case TRACE_BOARDING:
+            break;
+        default:
+            continue;
+        }
+        LifecycleEvent event = {record.wallNs, record.simTime, record.type, record.floor, record.destination};
+        result.partitions[partitionOf(record.floor, record.destination)].push_back(event);
+    }
+}
+
+// Follow each hall call of one partition from arrival to boarding to completion.
+// Calls with the same floor and destination are served first come, first served.
+static void matchPartition(const std::vector<ChunkResult> &chunks, int partition, PartitionResult &result) {
+    struct Pending {
+        uint64_t sinceNs;
+        int hour;
+    };
+    std::map<std::pair<int, int>, std::deque<Pending>> waiting, riding;
+
+    for (const ChunkResult &chunk : chunks) {
+        for (const LifecycleEvent &event : chunk.partitions[partition]) {
+            std::pair<int, int> call(event.floor, event.destination);
+            if (event.type == TRACE_REQUEST_ARRIVAL) {
+                Pending pending = {event.wallNs, event.simTime / KPI_HOUR_SECONDS};
+                waiting[call].push_back(pending);
+                result.requests++;
+                result.floors[event.floor].calls++;
+                result.hours[pending.hour].calls++;
+            } else if (event.type == TRACE_BOARDING) {
+                std::deque<Pending> &queue = waiting[call];
+                if (queue.empty()) continue;
+                Pending pending = queue.front();
+                queue.pop_front();
+                double seconds = (event.wallNs - pending.sinceNs) / 1e9;
+                result.wait.add(seconds);
+                result.floors[event.floor].wait.add(seconds);
+                HourKpi &hour = result.hours[pending.hour];
+                hour.boarded++;
+                hour.totalWaitSeconds += seconds;
+                pending.sinceNs = event.wallNs;
+                riding[call].push_back(pending);
+            } else {
+                std::deque<Pending> &queue = riding[call];
+                if (queue.empty()) continue;
+                result.travel.add((event.wallNs - queue.front().sinceNs) / 1e9);
+                queue.pop_front();
+                result.completed++;
+            }
+        }
+    }
+}
+
+static bool analyzeTrace(const std::string &path, int threads, RunKpi &run) {
+    TraceReader reader;
+    if (!reader.open(path)) return false;
+    uint64_t records = reader.recordCount();
+    reader.close();
+
+    // Phase 1: each thread scans a contiguous slice of the trace.
+    std::vector<ChunkResult> chunks(threads);
+    std::vector<std::thread> workers;
+    uint64_t perChunk = (records + threads - 1) / threads;
+    for (int t = 0; t < threads; t++) {
+        uint64_t first = std::min(records, t * perChunk);
+        uint64_t count = std::min(perChunk, records - first);
+        workers.emplace_back(scanChunk, path, first, count, std::ref(chunks[t]));
+    }
+    for (auto &worker : workers) worker.join();
+    workers.clear();
+
+    // Phase 2: each thread matches hall calls in its share of the partitions.
+    std::vector<PartitionResult> partitions(KPI_PARTITIONS);
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&chunks, &partitions, t, threads]() {
+            for (int p = t; p < KPI_PARTITIONS; p += threads)
+                matchPartition(chunks, p, partitions[p]);
+        });
+    }
+    for (auto &worker : workers) worker.join();
+
+    uint64_t firstNs = 0, lastNs = 0;
+    bool any = false;
+    for (const ChunkResult &chunk : chunks) {
+        run.events += chunk.events;
+        run.faults += chunk.faults;
+        if (chunk.any) {
+            if (!any) firstNs = chunk.firstNs;
+            lastNs = chunk.lastNs;
+            any = true;
+        }
+        for (const auto &entry : chunk.cars) {
+            CarKpi &car = run.cars[entry.first];
+            car.trips += entry.second.trips;
+            car.passengers += entry.second.passengers;
+            car.floorsTravelled += entry.second.floorsTravelled;
+            car.doorCycles += entry.second.doorCycles;
+            car.faults += entry.second.faults;
+        }
+    }
+    if (any) run.durationSeconds += (lastNs - firstNs) / 1e9;
+
+    for (PartitionResult &partition : partitions) {
+        run.requests += partition.requests;
+        run.completed += partition.completed;
+        run.wait.merge(partition.wait);
+        run.travel.merge(partition.travel);
+        for (auto &entry : partition.floors) {
+            FloorKpi &floor = run.floors[entry.first];
+            floor.calls += entry.second.calls;
+            floor.wait.merge(entry.second.wait);
+        }
+        for (auto &entry : partition.hours) {
+            HourKpi &hour = run.hours[entry.first];
+            hour.calls += entry.second.calls;
+            hour.boarded += entry.second.boarded;
+            hour.totalWaitSeconds += entry.second.totalWaitSeconds;
+        }
+    }
+    return true;
+}
+
+bool analyzeTraces(const std::vector<std::string> &paths, int threads, RunKpi &run) {
+    if (threads < 1) threads = 1;
+    for (const std::string &path : paths) {
+        if (!analyzeTrace(path, threads, run)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+#ifndef KPI_ANALYZER_HPP
+#define KPI_ANALYZER_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+#define KPI_HOUR_SECONDS 3600
+#define KPI_FLOOR_SECONDS 1        // Car travel time per floor (FLOOR_TRAVEL_TIME in elevator.cpp)
+#define KPI_DOOR_CYCLE_SECONDS 2   // Doors open for 1 s, then close for 1 s
+#define KPI_PARTITIONS 64          // Hall-call partitions matched in parallel
+
+// A set of durations, in seconds.
+struct DurationStats {
+    std::vector<float> samples;
+    double totalSeconds = 0.0;
+
+    void add(double seconds);
+    void merge(const DurationStats &other);
+    long count() const { return static_cast<long>(samples.size()); }
+    double mean() const;
+    double percentile(int pct);   // Sorts the samples on first use
+};
+
+struct FloorKpi {
+    long calls = 0;
+    DurationStats wait;           // Hall call placed until its passengers boarded
+};
+
+struct CarKpi {
+    long trips = 0;               // Hall calls completed
+    long passengers = 0;
+    long floorsTravelled = 0;
+    long doorCycles = 0;
+    long faults = 0;
+
+    double busySeconds() const {
+        return floorsTravelled * KPI_FLOOR_SECONDS + doorCycles * KPI_DOOR_CYCLE_SECONDS;
+    }
+};
+
+// Hours only keep totals; percentiles per hour would hold every sample twice.
+struct HourKpi {
+    long calls = 0;
+    long boarded = 0;
+    double totalWaitSeconds = 0.0;
+
+    double meanWait() const { return boarded ? totalWaitSeconds / boarded : 0.0; }
+};
+
+// KPIs of one run, rebuilt from the lifecycle of every hall call in its traces.
+struct RunKpi {
+    long events = 0;
+    long requests = 0;
+    long completed = 0;
+    long faults = 0;
+    double durationSeconds = 0.0;   // Summed over the input traces
+    DurationStats wait;
+    DurationStats travel;           // Boarded until arrived at the destination
+    std::map<int, FloorKpi> floors; // By pickup floor
+    std::map<int, CarKpi> cars;
+    std::map<int, HourKpi> hours;   // By simulated hour of the hall call
+
+    // Share of the run the car spent moving or cycling its doors, in percent.
+    double utilisation(int car) const;
+};
+
+// Analyse the traces at paths as one run, splitting each trace into one
+// chunk per thread. Returns false if any file is not a readable trace.
+bool analyzeTraces(const std::vector<std::string> &paths, int threads, RunKpi &run);
+
+#endif // KPI_ANALYZER_HPP
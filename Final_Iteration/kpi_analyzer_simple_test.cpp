@@ -0,0 +1,175 @@
+// kpi_analyzer_simple_test.cpp
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include "kpi_analyzer.hpp"
+#include "event_trace.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+#define TEST_TRACE "kpi_analyzer_test.bin"
+#define NS_PER_SECOND 1000000000ULL
+
+static TraceRecord makeRecord(double seconds, int type, int car, int floor, int destination, int passengers = 1) {
+    TraceRecord record;
+    memset(&record, 0, sizeof(record));
+    record.wallNs = static_cast<uint64_t>(seconds * NS_PER_SECOND);
+    record.simTime = static_cast<int32_t>(seconds);
+    record.type = static_cast<uint16_t>(type);
+    record.elevator = static_cast<int16_t>(car);
+    record.floor = static_cast<int16_t>(floor);
+    record.destination = static_cast<int16_t>(destination);
+    record.passengers = static_cast<int16_t>(passengers);
+    return record;
+}
+
+// Write records with controlled timestamps, as the simulation would.
+static void writeTrace(const std::vector<TraceRecord> &records) {
+    TraceHeader header;
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    header.startUnixMs = 0;
+    FILE *file = fopen(TEST_TRACE, "wb");
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(records.data(), sizeof(TraceRecord), records.size(), file);
+    fclose(file);
+}
+
+static bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-3;
+}
+
+// Test one hall call followed from arrival to completion
+int testLifecycle() {
+    std::cout << "\n=== Testing Hall Call Lifecycle ===" << std::endl;
+    std::vector<TraceRecord> records;
+    records.push_back(makeRecord(0, TRACE_REQUEST_ARRIVAL, -1, 3, 8, 2));
+    records.push_back(makeRecord(0.3, TRACE_ASSIGNMENT, 1, 3, 8, 2));
+    for (int f = 2; f <= 3; f++) records.push_back(makeRecord(f - 1, TRACE_FLOOR_PASS, 1, f, 3));
+    records.push_back(makeRecord(2, TRACE_DOOR_OPEN, 1, 3, 3));
+    records.push_back(makeRecord(4, TRACE_BOARDING, 1, 3, 8, 2));
+    for (int f = 4; f <= 8; f++) records.push_back(makeRecord(f, TRACE_FLOOR_PASS, 1, f, 8));
+    records.push_back(makeRecord(8, TRACE_DOOR_OPEN, 1, 8, 8));
+    records.push_back(makeRecord(10, TRACE_COMPLETION, 1, 3, 8, 2));
+    writeTrace(records);
+
+    RunKpi run;
+    TEST_ASSERT(analyzeTraces(std::vector<std::string>(1, TEST_TRACE), 1, run), "Trace should be analysed");
+
+    std::cout << "  Test Case 1: Wait and travel times" << std::endl;
+    TEST_ASSERT(run.requests == 1 && run.completed == 1, "One request should be placed and completed");
+    TEST_ASSERT(near(run.wait.mean(), 4.0), "Wait should run from the call to boarding (4 s)");
+    TEST_ASSERT(near(run.travel.mean(), 6.0), "Travel should run from boarding to completion (6 s)");
+    TEST_ASSERT(run.floors[3].calls == 1 && near(run.floors[3].wait.mean(), 4.0), "Wait should count for pickup floor 3");
+
+    std::cout << "  Test Case 2: Car utilisation" << std::endl;
+    const CarKpi &car = run.cars[1];
+    TEST_ASSERT(car.trips == 1 && car.passengers == 2, "Car 1 should have carried one group of 2");
+    TEST_ASSERT(car.floorsTravelled == 7 && car.doorCycles == 2, "Car 1 should have passed 7 floors and cycled doors twice");
+    TEST_ASSERT(near(run.utilisation(1), 100.0), "11 busy seconds over a 10 s run should cap at 100%");
+
+    std::cout << "Hall Call Lifecycle: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test that repeated calls between the same floors are served in order
+int testRepeatedCalls() {
+    std::cout << "\n=== Testing Repeated Calls ===" << std::endl;
+    std::vector<TraceRecord> records;
+    records.push_back(makeRecord(0, TRACE_REQUEST_ARRIVAL, -1, 2, 9));
+    records.push_back(makeRecord(1, TRACE_REQUEST_ARRIVAL, -1, 2, 9));
+    records.push_back(makeRecord(4, TRACE_BOARDING, 0, 2, 9));
+    records.push_back(makeRecord(6, TRACE_BOARDING, 3, 2, 9));
+    records.push_back(makeRecord(7, TRACE_FAULT, 2, 5, 1));
+    writeTrace(records);
+
+    RunKpi run;
+    TEST_ASSERT(analyzeTraces(std::vector<std::string>(1, TEST_TRACE), 1, run), "Trace should be analysed");
+
+    std::cout << "  Test Case 1: First come, first served" << std::endl;
+    TEST_ASSERT(run.wait.count() == 2 && near(run.wait.totalSeconds, 9.0), "Waits should be 4 s and 5 s");
+    TEST_ASSERT(run.completed == 0, "Neither call has arrived yet");
+
+    std::cout << "  Test Case 2: Faults are counted per car" << std::endl;
+    TEST_ASSERT(run.faults == 1 && run.cars[2].faults == 1, "Car 2 should have one fault");
+
+    std::cout << "Repeated Calls: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test that splitting a trace across threads does not change the result
+int testParallelChunks() {
+    std::cout << "\n=== Testing Parallel Chunks ===" << std::endl;
+    std::mt19937 gen(35);
+    std::uniform_int_distribution<int> floorDist(1, 22);
+    std::vector<TraceRecord> records;
+    // Calls overlap, so many lifecycles straddle chunk boundaries.
+    for (int i = 0; i < 20000; i++) {
+        int from = floorDist(gen), to;
+        do { to = floorDist(gen); } while (to == from);
+        double t = i * 0.5;
+        records.push_back(makeRecord(t, TRACE_REQUEST_ARRIVAL, -1, from, to));
+        records.push_back(makeRecord(t + 3 + i % 5, TRACE_BOARDING, i % 4, from, to));
+        records.push_back(makeRecord(t + 20 + i % 7, TRACE_COMPLETION, i % 4, from, to));
+    }
+    std::sort(records.begin(), records.end(),
+              [](const TraceRecord &a, const TraceRecord &b) { return a.wallNs < b.wallNs; });
+    writeTrace(records);
+
+    RunKpi single, parallel;
+    TEST_ASSERT(analyzeTraces(std::vector<std::string>(1, TEST_TRACE), 1, single), "Single-thread analysis should succeed");
+    TEST_ASSERT(analyzeTraces(std::vector<std::string>(1, TEST_TRACE), 7, parallel), "Seven-thread analysis should succeed");
+
+    std::cout << "  Test Case 1: Same totals on 1 and 7 threads" << std::endl;
+    TEST_ASSERT(single.requests == 20000 && parallel.requests == 20000, "Every request should be found");
+    TEST_ASSERT(single.completed == parallel.completed && parallel.completed == 20000, "Every request should complete");
+    TEST_ASSERT(near(single.wait.mean(), parallel.wait.mean()), "Mean wait should not depend on the thread count");
+    TEST_ASSERT(near(single.travel.mean(), parallel.travel.mean()), "Mean travel should not depend on the thread count");
+    TEST_ASSERT(single.cars[2].trips == parallel.cars[2].trips, "Per-car trips should not depend on the thread count");
+
+    std::cout << "  Test Case 2: Non-trace input is rejected" << std::endl;
+    FILE *file = fopen(TEST_TRACE, "wb");
+    fputs("[SCHEDULER] Assigned request\n", file);
+    fclose(file);
+    RunKpi rejected;
+    TEST_ASSERT(!analyzeTraces(std::vector<std::string>(1, TEST_TRACE), 2, rejected), "Text log should be rejected");
+
+    std::cout << "Parallel Chunks: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING KPI ANALYZER TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testLifecycle();
+    failures += testRepeatedCalls();
+    failures += testParallelChunks();
+    remove(TEST_TRACE);
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " KPI ANALYZER TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " KPI ANALYZER TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
@@ -0,0 +1,282 @@
+// load_generator.cpp
+// Drives the scheduler with an open-loop stream of hall calls and measures
+// how many it can absorb. The program plays the floor subsystem on one
+// socket and every elevator on ports ELEVATOR_PORT_BASE + id; the elevators
+// acknowledge each assignment at once (boarded, then arrived), so only the
+// scheduler and the network stack limit throughput.
+//
+// Usage: ./load_generator [--banks N] [calls_per_second ...]   (one phase per rate)
+// --banks N replaces the building's bank layout with N equal zones of
+// CARS_PER_BANK cars each, to see how throughput scales with the shard count.
+#include "message.hpp"
+#include "scheduler.hpp"
+#include "load_model.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+#define CARS_PER_BANK 2        // Cars in each zone with --banks
+#define PHASE_SECONDS 10       // Length of each offered-rate phase
+#define DRAIN_SECONDS 2        // Grace period for late assignments after a phase
+#define SAMPLE_MS 10           // Queue depth sampling interval
+
+bool systemActive = true;
+
+typedef std::chrono::steady_clock Clock;
+
+// Calls sent but not yet assigned, keyed like the scheduler's duplicate check.
+static std::mutex outstandingMutex;
+static std::map<std::pair<int, int>, std::deque<Clock::time_point>> outstanding;
+static int outstandingCount = 0;
+static std::vector<double> latenciesMs;
+
+static std::atomic<bool> peersActive(true);
+
+struct PhaseResult {
+    int offeredRate;
+    int sent;
+    int duplicates;      // Sent while the same call was still waiting; merged by the scheduler
+    int assigned;
+    int lost;            // Never assigned, even after the drain period
+    double meanDepth;
+    int maxDepth;
+    double p50Ms, p90Ms, p99Ms, maxMs;
+    long kernelDrops;
+};
+
+static int bindUdp(int port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port);
+    if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        std::cerr << "[LOAD] Bind failed on port " << port << " (is the simulation running?)\n";
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    struct timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = 100000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
+    return fd;
+}
+
+// UDP receive errors across the host (buffer overflows included), from /proc/net/snmp.
+static long kernelUdpDrops() {
+    std::ifstream snmp("/proc/net/snmp");
+    std::string header, values;
+    while (std::getline(snmp, header)) {
+        if (header.compare(0, 4, "Udp:") != 0 || !std::getline(snmp, values)) continue;
+        std::istringstream names(header), counts(values);
+        std::string name;
+        long count, total = 0;
+        names >> name;
+        counts >> name;
+        while (names >> name && counts >> count) {
+            if (name == "InErrors") total += count;
+        }
+        return total;
+    }
+    return 0;
+}
+
+// An elevator that boards and arrives the moment it is assigned.
+static void elevatorPeer(int fd) {
+    ElevatorMessage msg;
+    struct sockaddr_in schedulerAddr;
+    while (peersActive) {
+        socklen_t len = sizeof(schedulerAddr);
+        if (recvfrom(fd, &msg, sizeof(msg), 0, (struct sockaddr*)&schedulerAddr, &len) != sizeof(msg))
+            continue;
+        if (msg.msgType != 0) continue;  // Parking moves need no reply
+
+        ElevatorMessage reply = msg;
+        reply.msgType = 4;
+        reply.carLoad = msg.passengers;
+        reply.carLoadKg = passengerWeightKg(msg.passengers);
+        sendto(fd, &reply, sizeof(reply), 0, (struct sockaddr*)&schedulerAddr, len);
+        reply.msgType = 1;
+        reply.carLoad = 0;
+        reply.carLoadKg = 0;
+        sendto(fd, &reply, sizeof(reply), 0, (struct sockaddr*)&schedulerAddr, len);
+    }
+    close(fd);
+}
+
+// Match car assignment notices to the calls waiting for them.
+static void floorReceiver(int fd) {
+    ElevatorMessage notice;
+    while (peersActive) {
+        if (recv(fd, &notice, sizeof(notice), 0) != sizeof(notice) || notice.msgType != 6)
+            continue;
+        Clock::time_point now = Clock::now();
+        std::lock_guard<std::mutex> lock(outstandingMutex);
+        auto it = outstanding.find(std::make_pair(notice.floorNumber, notice.destination));
+        if (it == outstanding.end() || it->second.empty()) continue;
+        latenciesMs.push_back(std::chrono::duration<double, std::milli>(now - it->second.front()).count());
+        it->second.pop_front();
+        outstandingCount--;
+    }
+}
+
+static double percentile(const std::vector<double> &sorted, int pct) {
+    if (sorted.empty()) return 0.0;
+    return sorted[std::min(sorted.size() - 1, sorted.size() * pct / 100)];
+}
+
+static PhaseResult runPhase(int fd, const struct sockaddr_in &schedulerAddr, int rate, std::mt19937 &gen) {
+    PhaseResult r;
+    memset(&r, 0, sizeof(r));
+    r.offeredRate = rate;
+    {
+        std::lock_guard<std::mutex> lock(outstandingMutex);
+        outstanding.clear();
+        outstandingCount = 0;
+        latenciesMs.clear();
+    }
+    long dropsBefore = kernelUdpDrops();
+
+    // Sample the backlog while the phase runs.
+    std::atomic<bool> sampling(true);
+    long depthTotal = 0, samples = 0;
+    std::thread sampler([&]() {
+        while (sampling) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SAMPLE_MS));
+            std::lock_guard<std::mutex> lock(outstandingMutex);
+            depthTotal += outstandingCount;
+            samples++;
+            r.maxDepth = std::max(r.maxDepth, outstandingCount);
+        }
+    });
+
+    // Open loop: calls leave on a fixed schedule whether or not earlier ones were served.
+    std::uniform_int_distribution<int> floorDist(MIN_FLOOR, MAX_FLOOR);
+    Clock::time_point start = Clock::now();
+    long total = static_cast<long>(rate) * PHASE_SECONDS;
+    for (long k = 0; k < total; k++) {
+        std::this_thread::sleep_until(start + std::chrono::microseconds(k * 1000000L / rate));
+        int from = floorDist(gen), to;
+        do { to = floorDist(gen); } while (to == from);
+        ElevatorMessage call(from, to, to > from, -1, static_cast<int>(k / rate));
+        call.msgType = 0;
+        {
+            std::lock_guard<std::mutex> lock(outstandingMutex);
+            std::deque<Clock::time_point> &waiting = outstanding[std::make_pair(from, to)];
+            if (waiting.empty()) {
+                waiting.push_back(Clock::now());
+                outstandingCount++;
+            } else {
+                r.duplicates++;
+            }
+        }
+        sendto(fd, &call, sizeof(call), 0, (struct sockaddr*)&schedulerAddr, sizeof(schedulerAddr));
+        r.sent++;
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(DRAIN_SECONDS));
+    sampling = false;
+    sampler.join();
+
+    std::lock_guard<std::mutex> lock(outstandingMutex);
+    std::vector<double> sorted = latenciesMs;
+    std::sort(sorted.begin(), sorted.end());
+    r.assigned = static_cast<int>(sorted.size());
+    r.lost = outstandingCount;
+    r.meanDepth = samples ? static_cast<double>(depthTotal) / samples : 0.0;
+    r.p50Ms = percentile(sorted, 50);
+    r.p90Ms = percentile(sorted, 90);
+    r.p99Ms = percentile(sorted, 99);
+    r.maxMs = sorted.empty() ? 0.0 : sorted.back();
+    r.kernelDrops = kernelUdpDrops() - dropsBefore;
+    return r;
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<int> rates;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--banks") == 0 && i + 1 < argc) {
+            splitIntoBanks(std::atoi(argv[++i]), CARS_PER_BANK);
+            continue;
+        }
+        int rate = std::atoi(argv[i]);
+        if (rate > 0) rates.push_back(rate);
+    }
+    if (rates.empty()) {
+        rates.push_back(10);
+        rates.push_back(50);
+        rates.push_back(200);
+        rates.push_back(1000);
+    }
+
+    int cars = 0;
+    for (const Bank &bank : banks)
+        cars = std::max(cars, bank.firstElevator + bank.numElevators);
+    std::vector<int> carSockets;
+    for (int id = 0; id < cars; id++) {
+        int fd = bindUdp(ELEVATOR_PORT_BASE + id);
+        if (fd < 0) return 1;
+        carSockets.push_back(fd);
+    }
+    int floorSock = bindUdp(0);
+    if (floorSock < 0) return 1;
+
+    // The scheduler logs every message; drop that so only the report is printed.
+    std::streambuf *stdoutBuf = std::cout.rdbuf(nullptr);
+    std::thread schedulerThread(schedulerFunction, false);
+    std::vector<std::thread> peers;
+    for (int fd : carSockets) peers.emplace_back(elevatorPeer, fd);
+    std::thread receiver(floorReceiver, floorSock);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    struct sockaddr_in schedulerAddr;
+    memset(&schedulerAddr, 0, sizeof(schedulerAddr));
+    schedulerAddr.sin_family = AF_INET;
+    schedulerAddr.sin_port = htons(SCHEDULER_PORT);
+    inet_pton(AF_INET, "127.0.0.1", &schedulerAddr.sin_addr);
+
+    std::mt19937 gen(3203);
+    std::vector<PhaseResult> results;
+    for (int rate : rates)
+        results.push_back(runPhase(floorSock, schedulerAddr, rate, gen));
+
+    systemActive = false;
+    peersActive = false;
+    schedulerThread.join();
+    for (auto &peer : peers) peer.join();
+    receiver.join();
+    close(floorSock);
+    std::cout.rdbuf(stdoutBuf);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "=== Scheduler Load Test (" << banks.size() << " banks, " << cars << " cars, floors " << MIN_FLOOR << "-" << MAX_FLOOR
+              << ", " << PHASE_SECONDS << " s per phase, elevators acknowledge immediately) ===" << std::endl;
+    std::cout << "offered/s  achieved/s    sent     dup  lost  depth avg/max  latency ms p50/p90/p99/max  kernel drops" << std::endl;
+    for (const PhaseResult &r : results) {
+        std::cout << std::setw(9) << r.offeredRate
+                  << std::setw(12) << static_cast<double>(r.assigned) / PHASE_SECONDS
+                  << std::setw(8) << r.sent
+                  << std::setw(8) << r.duplicates
+                  << std::setw(6) << r.lost
+                  << std::setw(9) << r.meanDepth << "/" << r.maxDepth
+                  << "  " << r.p50Ms << "/" << r.p90Ms << "/" << r.p99Ms << "/" << r.maxMs
+                  << "  " << r.kernelDrops << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+/* load_model.cpp */
+#include "load_model.hpp"
+
+int passengerWeightKg(int persons) {
+    return persons * AVG_PASSENGER_KG;
+}
+
+int loadPercent(int persons, int kg) {
+    int byPersons = persons * 100 / RATED_PERSONS;
+    int byWeight = kg * 100 / RATED_LOAD_KG;
+    return (byPersons > byWeight) ? byPersons : byWeight;
+}
+
+bool shouldBypass(int persons, int kg) {
+    return loadPercent(persons, kg) >= BYPASS_LOAD_PERCENT;
+}
+
+bool canBoard(int persons, int kg, int extraPersons) {
+    return persons + extraPersons <= RATED_PERSONS &&
+           kg + passengerWeightKg(extraPersons) <= RATED_LOAD_KG;
+}
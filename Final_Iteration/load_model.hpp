@@ -0,0 +1,23 @@
+#ifndef LOAD_MODEL_HPP
+#define LOAD_MODEL_HPP
+
+// Rated load of a single car.
+#define RATED_LOAD_KG 1000
+#define RATED_PERSONS 13
+#define AVG_PASSENGER_KG 75
+// Cars at or above this percentage of rated load skip new hall calls.
+#define BYPASS_LOAD_PERCENT 80
+
+// Estimated weight of a group of passengers.
+int passengerWeightKg(int persons);
+
+// Load as a percentage of rating; the tighter of the person and weight limits wins.
+int loadPercent(int persons, int kg);
+
+// True when the car is loaded enough that it should bypass hall calls.
+bool shouldBypass(int persons, int kg);
+
+// True when a group of extraPersons still fits within the rated load.
+bool canBoard(int persons, int kg, int extraPersons);
+
+#endif // LOAD_MODEL_HPP
@@ -0,0 +1,88 @@
+// load_model_simple_test.cpp
+#include <iostream>
+#include "load_model.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+// Test load percentage against the rated load
+int testLoadPercent() {
+    std::cout << "\n=== Testing Load Percentage ===" << std::endl;
+
+    std::cout << "  Test Case 1: Empty car" << std::endl;
+    TEST_ASSERT(loadPercent(0, 0) == 0, "Empty car should be at 0%");
+
+    std::cout << "  Test Case 2: Person limit dominates" << std::endl;
+    int persons = RATED_PERSONS;
+    TEST_ASSERT(loadPercent(persons, passengerWeightKg(persons)) >= 100,
+               "Car at rated persons should be at least 100%");
+
+    std::cout << "  Test Case 3: Weight limit dominates" << std::endl;
+    TEST_ASSERT(loadPercent(1, RATED_LOAD_KG) == 100,
+               "One very heavy load at rated kg should be 100%");
+
+    std::cout << "Load Percentage: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test the 80% bypass threshold
+int testBypass() {
+    std::cout << "\n=== Testing Bypass Threshold ===" << std::endl;
+
+    std::cout << "  Test Case 1: Lightly loaded car" << std::endl;
+    TEST_ASSERT(!shouldBypass(2, passengerWeightKg(2)), "Car with 2 persons should not bypass");
+
+    std::cout << "  Test Case 2: Car at bypass threshold" << std::endl;
+    int kg = RATED_LOAD_KG * BYPASS_LOAD_PERCENT / 100;
+    TEST_ASSERT(shouldBypass(1, kg), "Car at 80% of rated kg should bypass");
+
+    std::cout << "Bypass Threshold: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test boarding capacity checks
+int testCanBoard() {
+    std::cout << "\n=== Testing Boarding Capacity ===" << std::endl;
+
+    std::cout << "  Test Case 1: Group fits in empty car" << std::endl;
+    TEST_ASSERT(canBoard(0, 0, 4), "4 passengers should fit in an empty car");
+
+    std::cout << "  Test Case 2: Group exceeds rated persons" << std::endl;
+    TEST_ASSERT(!canBoard(RATED_PERSONS - 1, 0, 2), "Group should not exceed rated persons");
+
+    std::cout << "  Test Case 3: Group exceeds rated weight" << std::endl;
+    TEST_ASSERT(!canBoard(1, RATED_LOAD_KG - AVG_PASSENGER_KG + 1, 1), "Group should not exceed rated kg");
+
+    std::cout << "Boarding Capacity: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING LOAD MODEL TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testLoadPercent();
+    failures += testBypass();
+    failures += testCanBoard();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " LOAD MODEL TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " LOAD MODEL TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
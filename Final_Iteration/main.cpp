@@ -3,35 +3,58 @@
 #include "scheduler.hpp"
 #include "elevator.hpp"
 #include "time_manager.hpp"
+#include "event_trace.hpp"
 #include <thread>
 #include <vector>
 #include <iostream>
+#include <cstring>
+
+#define TRACE_FILE "simulation_trace.bin"
 
 bool systemActive = true;
 
-int main() {
+// Usage: ./elevator_sim [--recover] [--external-scheduler]
+// --recover rebuilds the scheduler from its journal after a crash instead of starting empty.
+// --external-scheduler runs only the floor and elevators, for use with scheduler_node.
+int main(int argc, char *argv[]) {
+    bool recover = false;
+    bool externalScheduler = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--recover") == 0) recover = true;
+        else if (strcmp(argv[i], "--external-scheduler") == 0) externalScheduler = true;
+    }
+
+    // Record every state transition for post-run analysis (see trace_dump).
+    if (!openTrace(TRACE_FILE)) {
+        std::cerr << "Could not create trace file " << TRACE_FILE << "\n";
+    }
+
     std::thread floorThread(floorFunction);
-    std::thread schedulerThread(schedulerFunction);
-    
-    // Launch dashboard thread from the scheduler to show a consolidated status.
-    std::thread dashboardThread(displayDashboard);
-
-    // Launch elevator threads (as defined by MAX_ELEVATORS in scheduler.cpp).
-    std::vector<std::thread> elevatorThreads;
-    for (int i = 0; i < 4; i++) { 
-        elevatorThreads.emplace_back(elevatorFunction, i);
+    std::thread schedulerThread, dashboardThread;
+    if (!externalScheduler) {
+        schedulerThread = std::thread(schedulerFunction, recover);
+
+        // Launch dashboard thread from the scheduler to show a consolidated status.
+        dashboardThread = std::thread(displayDashboard);
+    }
+
+    // All cars (as defined by MAX_ELEVATORS in scheduler.cpp) share one executor thread.
+    std::vector<int> elevatorIds;
+    for (int i = 0; i < 4; i++) {
+        elevatorIds.push_back(i);
     }
+    std::thread elevatorThread(runElevators, elevatorIds, 1);
 
     std::cout << "Press Enter to stop simulation and output performance metrics..." << std::endl;
     std::cin.get();  // Wait for Enter key.
     systemActive = false; // Signal threads to stop.
+    stopElevators();
 
     floorThread.join();
-    schedulerThread.join();
-    dashboardThread.join();
-    for (auto &thread : elevatorThreads) {
-        thread.join();
-    }
+    if (schedulerThread.joinable()) schedulerThread.join();
+    if (dashboardThread.joinable()) dashboardThread.join();
+    elevatorThread.join();
+    closeTrace();
 
     // Output  metrics.
     std::cout << "\n=== Performance Metrics ===" << std::endl;
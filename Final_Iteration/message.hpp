@@ -22,17 +22,24 @@ struct ElevatorMessage {
     bool directionUp;        // true for UP request; false for DOWN
     int assignedElevator;    // Elevator id assigned (-1 if not yet assigned)
     int status;              // 1 for success, negative for faults
-    int msgType;             // 0: new request/assignment, 1: normal completion, 2: fault, 3: intermediate update
+    int msgType;             // 0: new request/assignment, 1: normal completion, 2: fault, 3: intermediate update, 4: boarding update, 5: parking move, 6: car assignment notice to floor, 7: status query, 8: status report
     int faultCode;           // 0: no fault, 1: door fault, 2: elevator stuck fault
     int timestamp;           // Simulated time when the message is sent
+    int passengers;          // Number of passengers travelling on this request
+    int carLoad;             // Persons on board after this stop (set by the elevator)
+    int carLoadKg;           // Weight on board after this stop (set by the elevator)
+    int groupId;             // Destination-dispatch group this assignment belongs to (0 if none)
+    int groupSize;           // Number of assignments in the group, sent back-to-back
 
     ElevatorMessage() 
         : floorNumber(0), destination(0), directionUp(true), assignedElevator(-1),
-          status(0), msgType(0), faultCode(0), timestamp(0) {}
+          status(0), msgType(0), faultCode(0), timestamp(0),
+          passengers(1), carLoad(0), carLoadKg(0), groupId(0), groupSize(1) {}
 
     ElevatorMessage(int floor, int dest, bool up, int assigned, int ts) 
         : floorNumber(floor), destination(dest), directionUp(up), assignedElevator(assigned),
-          status(0), msgType(0), faultCode(0), timestamp(ts) {}
+          status(0), msgType(0), faultCode(0), timestamp(ts),
+          passengers(1), carLoad(0), carLoadKg(0), groupId(0), groupSize(1) {}
 };
 
 #endif // MESSAGE_HPP
@@ -0,0 +1,540 @@
+// microbench.cpp
+// Times the scheduler, parser and transport hot paths and prints one JSON
+// object per benchmark. Given a previous run's output, it also reports any
+// benchmark that got more than REGRESSION_PERCENT slower and exits non-zero.
+#include "scheduler.hpp"
+#include "load_model.hpp"
+#include "time_manager.hpp"
+#include "floor.hpp"
+#include "car_state_machine.hpp"
+#include "elevator.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#define MIN_BENCH_SECONDS 0.2  // Each benchmark repeats until it has run at least this long
+#define BEST_OF 3              // Timed runs per benchmark; the fastest is reported
+#define ROUND_TRIPS 2000       // Samples per UDP round-trip benchmark
+#define REGRESSION_PERCENT 25  // Slowdown against the baseline that fails the run
+
+bool systemActive = true;
+
+struct BenchResult {
+    std::string name;
+    int fleet;           // Cars in the shard (0 when not applicable)
+    long iterations;
+    double nsPerOp;
+    double p50Us;        // Latency percentiles, round-trip benchmarks only
+    double p99Us;
+};
+
+static std::vector<BenchResult> results;
+static volatile long sink;  // Keeps the optimiser from dropping measured work
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Run op(n) with growing n until the run takes MIN_BENCH_SECONDS, then keep
+// the fastest of BEST_OF runs at that size; op runs n operations.
+template <typename Op>
+static void runBench(const std::string &name, int fleet, Op op) {
+    long n = 1;
+    for (;;) {
+        auto start = std::chrono::steady_clock::now();
+        op(n);
+        double elapsed = secondsSince(start);
+        if (elapsed >= MIN_BENCH_SECONDS || n >= (1L << 30)) {
+            for (int run = 1; run < BEST_OF; run++) {
+                start = std::chrono::steady_clock::now();
+                op(n);
+                elapsed = std::min(elapsed, secondsSince(start));
+            }
+            BenchResult r = {name, fleet, n, elapsed * 1e9 / n, 0, 0};
+            results.push_back(r);
+            return;
+        }
+        n *= (elapsed < MIN_BENCH_SECONDS / 16) ? 8 : 2;
+    }
+}
+
+// A fleet spread over the building, some idle and some moving, with light loads.
+static Fleet makeFleet(const Bank &bank, std::mt19937 &gen) {
+    Fleet fleet(bank.firstElevator, bank.numElevators, MIN_FLOOR);
+    std::uniform_int_distribution<int> floorDist(MIN_FLOOR, MAX_FLOOR);
+    std::uniform_int_distribution<int> loadDist(0, RATED_PERSONS / 2);
+    for (int car = 0; car < fleet.size(); car++) {
+        bool idle = (gen() % 2) == 0;
+        fleet.position[car] = floorDist(gen);
+        fleet.idle.set(car, idle);
+        fleet.moving.set(car, !idle);
+        fleet.goingUp.set(car, (gen() % 2) == 0);
+        fleet.passengerCount[car] = idle ? 0 : loadDist(gen);
+        fleet.loadKg[car] = passengerWeightKg(fleet.passengerCount[car]);
+        fleet.queuedTrips[car] = idle ? 0 : 1;
+        fleet.tripEndFloor[car] = floorDist(gen);
+    }
+    return fleet;
+}
+
+static std::vector<ElevatorMessage> makeCalls(int count, std::mt19937 &gen) {
+    std::uniform_int_distribution<int> floorDist(MIN_FLOOR, MAX_FLOOR);
+    std::vector<ElevatorMessage> calls;
+    for (int i = 0; i < count; i++) {
+        int from = floorDist(gen), to;
+        do { to = floorDist(gen); } while (to == from);
+        ElevatorMessage call(from, to, to > from, -1, 0);
+        call.passengers = 1 + static_cast<int>(gen() % 3);
+        calls.push_back(call);
+    }
+    return calls;
+}
+
+// Greedy single-call assignment. The shard has no socket, so sendto fails
+// immediately and only the decision is timed; UDP cost is measured below.
+static void benchAssignElevator(int fleet) {
+    std::mt19937 gen(fleet);
+    Bank bank = {"BENCH", MIN_FLOOR, MAX_FLOOR, 0, fleet};
+    SchedulerShard shard(bank);
+    shard.fleet = makeFleet(bank, gen);
+    const Fleet initial = shard.fleet;
+    std::vector<ElevatorMessage> calls = makeCalls(1024, gen);
+
+    runBench("assign_elevator", fleet, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            const ElevatorMessage &call = calls[i & 1023];
+            shard.pendingRequests.push(call);
+            assignElevator(shard);
+            // Undo the assignment so every call sees the same fleet.
+            shard.processedRequests.clear();
+            if (!shard.inProgressRequests.empty()) {
+                int car = shard.inProgressRequests.back().elevatorId - initial.firstId;
+                shard.fleet.copyCar(initial, car);
+                shard.inProgressRequests.clear();
+            }
+        }
+    });
+}
+
+// Joint assignment of one call per car, including destination grouping.
+static void benchAssignBatch(int fleet) {
+    std::mt19937 gen(fleet);
+    Bank bank = {"BENCH", MIN_FLOOR, MAX_FLOOR, 0, fleet};
+    SchedulerShard shard(bank);
+    shard.fleet = makeFleet(bank, gen);
+    const Fleet initial = shard.fleet;
+    std::vector<ElevatorMessage> calls = makeCalls(fleet * 16, gen);
+
+    runBench("assign_batch", fleet, [&](long n) {
+        for (long i = 0; i < n; i++) {
+            long base = (i % 16) * fleet;
+            for (int k = 0; k < fleet; k++)
+                shard.pendingRequests.push(calls[base + k]);
+            assignBatch(shard);
+            shard.processedRequests.clear();
+            shard.inProgressRequests.clear();
+            shard.unservedCalls.clear();
+            shard.fleet = initial;
+        }
+    });
+}
+
+// The first three passes of assignElevator() as it ran before Fleet::cheapest():
+// per-car branches over canServe(), distance and direction.
+static int scalarDispatch(const Fleet &fleet, const ElevatorMessage &request) {
+    int best = -1;
+    int minDistance = std::numeric_limits<int>::max();
+    for (int car = 0; car < fleet.size(); car++) {
+        if (canServe(fleet, car, request) && fleet.idle.test(car) && fleet.position[car] == request.floorNumber)
+            return car;
+    }
+    for (int car = 0; car < fleet.size(); car++) {
+        if (!canServe(fleet, car, request) || !fleet.moving.test(car))
+            continue;
+        int position = fleet.position[car];
+        if ((fleet.goingUp.test(car) && request.floorNumber >= position) ||
+            (!fleet.goingUp.test(car) && request.floorNumber <= position)) {
+            int distance = std::abs(position - request.floorNumber);
+            if (distance < minDistance) {
+                minDistance = distance;
+                best = car;
+            }
+        }
+    }
+    if (best >= 0)
+        return best;
+    for (int car = 0; car < fleet.size(); car++) {
+        if (!canServe(fleet, car, request) || !fleet.idle.test(car))
+            continue;
+        int distance = std::abs(fleet.position[car] - request.floorNumber);
+        if (distance < minDistance) {
+            minDistance = distance;
+            best = car;
+        }
+    }
+    return best;
+}
+
+// Choosing a car for one call, the scalar passes against the vector cost kernel
+// (eligibility mask, costs, best and runner-up).
+static void benchDispatch(int cars) {
+    std::mt19937 gen(cars);
+    Bank bank = {"BENCH", MIN_FLOOR, MAX_FLOOR, 0, cars};
+    Fleet fleet = makeFleet(bank, gen);
+    std::vector<ElevatorMessage> calls = makeCalls(1024, gen);
+    FleetMask eligible;
+    std::vector<int16_t> costs;
+
+    runBench("dispatch_scalar", cars, [&](long n) {
+        long chosen = 0;
+        for (long i = 0; i < n; i++)
+            chosen += scalarDispatch(fleet, calls[i & 1023]);
+        sink = chosen;
+    });
+    runBench("dispatch_simd", cars, [&](long n) {
+        long chosen = 0;
+        for (long i = 0; i < n; i++) {
+            const ElevatorMessage &call = calls[i & 1023];
+            chosen += fleet.cheapest(call.floorNumber, call.passengers, eligible, costs).best;
+        }
+        sink = chosen;
+    });
+}
+
+// One row of assignBatch()'s cost matrix: estimateEta() car by car, as the batch
+// dispatcher ran it before the fleet kernels, against one mask and one ETA pass.
+static void benchBatchEta(int cars) {
+    std::mt19937 gen(cars);
+    Bank bank = {"BENCH", MIN_FLOOR, MAX_FLOOR, 0, cars};
+    Fleet fleet = makeFleet(bank, gen);
+    std::vector<ElevatorMessage> calls = makeCalls(1024, gen);
+    FleetMask eligible;
+    std::vector<int> etas(cars);
+
+    runBench("batch_eta_scalar", cars, [&](long n) {
+        long total = 0;
+        for (long i = 0; i < n; i++) {
+            const ElevatorMessage &call = calls[i & 1023];
+            for (int car = 0; car < fleet.size(); car++)
+                etas[car] = estimateEta(fleet, car, call);
+            total += etas[i % cars];
+        }
+        sink = total;
+    });
+    runBench("batch_eta_simd", cars, [&](long n) {
+        long total = 0;
+        for (long i = 0; i < n; i++) {
+            const ElevatorMessage &call = calls[i & 1023];
+            fleet.eligible(call.passengers, eligible);
+            fleet.etas(call.floorNumber, eligible, etas);
+            total += etas[i % cars];
+        }
+        sink = total;
+    });
+}
+
+static void benchParse() {
+    std::vector<std::string> lines;
+    std::ifstream infile("input.txt");
+    std::string line;
+    while (std::getline(infile, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) lines.push_back(line);
+    }
+    if (lines.empty()) {
+        // Same shapes as input.txt when run from another directory.
+        lines.push_back("1, UP, 0, 3");
+        lines.push_back("2, UP, 0");
+        lines.push_back("1, DOWN, 0");
+        lines.push_back("2, DOWN, 0");
+    }
+
+    runBench("parse_hall_call", 0, [&](long n) {
+        HallCall call;
+        long total = 0;
+        for (long i = 0; i < n; i++) {
+            if (parseHallCall(lines[i % lines.size()], call))
+                total += call.pickupFloor + call.passengers;
+        }
+        sink = total;
+    });
+}
+
+// Messages go on the wire as raw struct bytes, so encode/decode is a copy each way.
+static void benchCodec() {
+    ElevatorMessage msg(3, 17, true, 2, 40);
+    msg.passengers = 4;
+    char buffer[sizeof(ElevatorMessage)];
+
+    runBench("message_encode_decode", 0, [&](long n) {
+        long total = 0;
+        for (long i = 0; i < n; i++) {
+            msg.timestamp = static_cast<int>(i);
+            memcpy(buffer, &msg, sizeof(msg));
+            asm volatile("" : : "r"(buffer) : "memory");
+            ElevatorMessage decoded;
+            memcpy(&decoded, buffer, sizeof(decoded));
+            total += decoded.timestamp;
+        }
+        sink = total;
+    });
+}
+
+// The scheduler's pending-call queue with a typical backlog.
+static void benchQueue() {
+    CallQueue queue;
+    ElevatorMessage msg(3, 17, true, -1, 0);
+    for (int i = 0; i < 64; i++) queue.push(msg);  // Typical backlog depth
+
+    runBench("queue_push_pop", 0, [&](long n) {
+        long total = 0;
+        for (long i = 0; i < n; i++) {
+            msg.timestamp = static_cast<int>(i);
+            queue.push(msg);
+            total += queue.front().timestamp;
+            queue.pop();
+        }
+        sink = total;
+    });
+}
+
+// One state machine step per car per tick; an idle car is sent to its next stop.
+// Reported per car step, so 1000 / ns_per_op is cars stepped per microsecond.
+static void benchCarStep(int fleet) {
+    std::mt19937 gen(fleet);
+    std::uniform_int_distribution<int> floorDist(MIN_FLOOR, MAX_FLOOR);
+    std::vector<CarMotion> cars;
+    for (int i = 0; i < fleet; i++) {
+        cars.push_back(makeCar(floorDist(gen)));
+        cars.back().target = static_cast<int16_t>(floorDist(gen));
+        carStep(cars.back(), CAR_GO);
+    }
+    std::vector<int16_t> stops(4096);
+    for (auto &stop : stops) stop = static_cast<int16_t>(floorDist(gen));
+
+    runBench("car_step", fleet, [&](long n) {
+        long total = 0;
+        size_t nextStop = 0;
+        for (long done = 0; done < n;) {
+            for (int i = 0; i < fleet && done < n; i++, done++) {
+                CarMotion &car = cars[i];
+                if (carStep(car, CAR_TICK).to == IDLE) {
+                    car.target = stops[nextStop++ & (stops.size() - 1)];
+                    carStep(car, CAR_GO);
+                }
+                total += car.floor;
+            }
+        }
+        sink = total;
+    });
+}
+
+// A fleet of elevator actors on one simulated-time executor, fed in-process. One
+// op is one trip (pickup and destination, doors at both), about 20 resumes.
+static void benchActorFleet(int fleet) {
+    std::mt19937 gen(fleet);
+    std::uniform_int_distribution<int> floorDist(MIN_FLOOR, MAX_FLOOR);
+    ActorExecutor executor(true);
+    std::vector<std::unique_ptr<ElevatorActor>> cars;
+    for (int i = 0; i < fleet; i++) {
+        cars.emplace_back(new ElevatorActor(i, -1));
+        executor.spawn(*cars.back());
+    }
+    std::vector<ElevatorMessage> trips(4096);
+    for (auto &trip : trips) {
+        trip.floorNumber = floorDist(gen);
+        do trip.destination = floorDist(gen); while (trip.destination == trip.floorNumber);
+        trip.directionUp = trip.destination > trip.floorNumber;
+    }
+
+    runBench("actor_fleet", fleet, [&](long n) {
+        size_t nextTrip = 0;
+        for (long done = 0; done < n;) {
+            for (int i = 0; i < fleet && done < n; i++, done++)
+                executor.post(*cars[i], trips[nextTrip++ & (trips.size() - 1)]);
+            // Longest trip: two full-height runs and two door cycles.
+            executor.runFor(1000 * (2 * (MAX_FLOOR - MIN_FLOOR) + 2 * (DOOR_OPEN_TICKS + DOOR_CLOSE_TICKS) + 2));
+        }
+        sink = executor.resumes();
+    });
+}
+
+static int bindLoopback(struct sockaddr_in &addr) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+    socklen_t len = sizeof(addr);
+    getsockname(fd, (struct sockaddr*)&addr, &len);
+
+    struct timeval tv;
+    tv.tv_sec = 1;
+    tv.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
+    return fd;
+}
+
+// Send ROUND_TRIPS messages to target and time each reply on fd.
+static void recordRoundTrips(const std::string &name, int fd, const struct sockaddr_in &target, ElevatorMessage msg) {
+    std::vector<double> samples;
+    ElevatorMessage reply;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUND_TRIPS; i++) {
+        msg.timestamp = i;
+        auto sent = std::chrono::steady_clock::now();
+        sendto(fd, &msg, sizeof(msg), 0, (struct sockaddr*)&target, sizeof(target));
+        if (recv(fd, &reply, sizeof(reply), 0) != sizeof(reply))
+            continue;
+        samples.push_back(secondsSince(sent) * 1e6);
+    }
+    double elapsed = secondsSince(start);
+    if (samples.empty()) {
+        std::cerr << "[BENCH] " << name << ": no replies, skipped\n";
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    BenchResult r = {name, 0, static_cast<long>(samples.size()), elapsed * 1e9 / samples.size(),
+                     samples[samples.size() / 2], samples[samples.size() * 99 / 100]};
+    results.push_back(r);
+}
+
+// Loopback ping-pong between two sockets: the floor of any UDP hop.
+static void benchUdpLoopback() {
+    struct sockaddr_in clientAddr, echoAddr;
+    int client = bindLoopback(clientAddr);
+    int echo = bindLoopback(echoAddr);
+
+    std::thread echoThread([&]() {
+        ElevatorMessage msg;
+        struct sockaddr_in from;
+        for (int i = 0; i < ROUND_TRIPS; i++) {
+            socklen_t len = sizeof(from);
+            if (recvfrom(echo, &msg, sizeof(msg), 0, (struct sockaddr*)&from, &len) != sizeof(msg))
+                break;
+            sendto(echo, &msg, sizeof(msg), 0, (struct sockaddr*)&from, len);
+        }
+    });
+    recordRoundTrips("udp_loopback_round_trip", client, echoAddr, ElevatorMessage());
+    echoThread.join();
+    close(client);
+    close(echo);
+}
+
+// Through the running scheduler: the router relays car assignment notices
+// (msgType 6) back to the floor, so each notice sent to port 8100 comes back.
+static void benchUdpScheduler() {
+    struct sockaddr_in floorAddr, routerAddr;
+    int floorSock = bindLoopback(floorAddr);
+    memset(&routerAddr, 0, sizeof(routerAddr));
+    routerAddr.sin_family = AF_INET;
+    routerAddr.sin_port = htons(SCHEDULER_PORT);
+    inet_pton(AF_INET, "127.0.0.1", &routerAddr.sin_addr);
+
+    std::thread schedulerThread(schedulerFunction, false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    // A hall call registers this socket as the floor; drain the notice it produces.
+    ElevatorMessage call(2, 5, true, -1, 0);
+    sendto(floorSock, &call, sizeof(call), 0, (struct sockaddr*)&routerAddr, sizeof(routerAddr));
+    ElevatorMessage reply;
+    recv(floorSock, &reply, sizeof(reply), 0);
+
+    ElevatorMessage notice(2, 5, true, 0, 0);
+    notice.msgType = 6;
+    recordRoundTrips("udp_scheduler_round_trip", floorSock, routerAddr, notice);
+
+    systemActive = false;
+    schedulerThread.join();
+    close(floorSock);
+}
+
+static void printResults(std::ostream &out) {
+    out << "{\"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        char line[256];
+        snprintf(line, sizeof(line),
+                 "  {\"name\": \"%s\", \"fleet\": %d, \"iterations\": %ld, \"ns_per_op\": %.1f, "
+                 "\"ops_per_sec\": %.0f, \"p50_us\": %.2f, \"p99_us\": %.2f}%s\n",
+                 r.name.c_str(), r.fleet, r.iterations, r.nsPerOp, 1e9 / r.nsPerOp,
+                 r.p50Us, r.p99Us, (i + 1 < results.size()) ? "," : "");
+        out << line;
+    }
+    out << "]}\n";
+}
+
+// Compare against a previous run; each benchmark is on its own line there.
+static int compareBaseline(const char *path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "[BENCH] Cannot open baseline " << path << "\n";
+        return 1;
+    }
+    int regressions = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        char name[64];
+        int fleet;
+        double nsPerOp;
+        size_t at = line.find("{\"name\"");
+        if (at == std::string::npos ||
+            sscanf(line.c_str() + at, "{\"name\": \"%63[^\"]\", \"fleet\": %d, \"iterations\": %*d, \"ns_per_op\": %lf",
+                   name, &fleet, &nsPerOp) != 3)
+            continue;
+        for (const BenchResult &r : results) {
+            if (r.name != name || r.fleet != fleet) continue;
+            double change = (r.nsPerOp - nsPerOp) * 100.0 / nsPerOp;
+            if (change > REGRESSION_PERCENT) {
+                std::cerr << "[BENCH] REGRESSION: " << name << " (fleet " << fleet << ") "
+                          << nsPerOp << " -> " << r.nsPerOp << " ns/op (+" << static_cast<int>(change) << "%)\n";
+                regressions++;
+            }
+        }
+    }
+    return regressions > 0 ? 1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+    // The dispatch code logs every assignment; discard that so only the JSON is printed.
+    std::streambuf *stdoutBuf = std::cout.rdbuf(nullptr);
+    std::streambuf *stderrBuf = std::cerr.rdbuf(nullptr);
+
+    const int fleets[] = {4, 8, 16, 32, 64};
+    for (int fleet : fleets) benchAssignElevator(fleet);
+    for (int fleet : fleets) benchAssignBatch(fleet);
+    benchDispatch(64);
+    benchDispatch(1024);
+    benchBatchEta(64);
+    benchBatchEta(1024);
+    benchParse();
+    benchCodec();
+    benchQueue();
+    benchCarStep(1000);
+    benchCarStep(10000);
+    benchActorFleet(10000);
+
+    std::cerr.rdbuf(stderrBuf);
+    benchUdpLoopback();
+    std::cerr.rdbuf(nullptr);
+    benchUdpScheduler();
+
+    std::cout.rdbuf(stdoutBuf);
+    std::cerr.rdbuf(stderrBuf);
+    printResults(std::cout);
+
+    if (argc > 1)
+        return compareBaseline(argv[1]);
+    return 0;
+}
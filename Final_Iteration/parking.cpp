@@ -0,0 +1,80 @@
+/* parking.cpp */
+#include "parking.hpp"
+#include <algorithm>
+#include <cmath>
+
+DemandModel::DemandModel(int minFloor, int maxFloor)
+    : minFloor_(minFloor), maxFloor_(maxFloor),
+      counters_((maxFloor - minFloor + 1) * DEMAND_SLOTS, Counter{0.0, 0}) {}
+
+static int slotOf(int timestamp) {
+    int secondOfDay = timestamp % SECONDS_PER_DAY;
+    if (secondOfDay < 0) secondOfDay += SECONDS_PER_DAY;
+    return secondOfDay / DEMAND_SLOT_SECONDS;
+}
+
+static double decayed(double value, int from, int to) {
+    if (to <= from) return value;
+    return value * std::exp2(-static_cast<double>(to - from) / DEMAND_HALF_LIFE);
+}
+
+DemandModel::Counter &DemandModel::counter(int floor, int timestamp) {
+    return counters_[(floor - minFloor_) * DEMAND_SLOTS + slotOf(timestamp)];
+}
+
+const DemandModel::Counter &DemandModel::counter(int floor, int timestamp) const {
+    return counters_[(floor - minFloor_) * DEMAND_SLOTS + slotOf(timestamp)];
+}
+
+void DemandModel::recordArrival(int floor, int timestamp) {
+    if (floor < minFloor_ || floor > maxFloor_) return;
+    Counter &c = counter(floor, timestamp);
+    c.value = decayed(c.value, c.lastUpdate, timestamp) + 1.0;
+    c.lastUpdate = timestamp;
+}
+
+double DemandModel::rate(int floor, int timestamp) const {
+    if (floor < minFloor_ || floor > maxFloor_) return 0.0;
+    const Counter &c = counter(floor, timestamp);
+    return decayed(c.value, c.lastUpdate, timestamp);
+}
+
+std::vector<int> chooseParkingFloors(const DemandModel &model, int numCars, int timestamp) {
+    std::vector<int> floors;
+    if (numCars <= 0) return floors;
+
+    // Look one slot ahead so cars are in place before a peak starts.
+    std::vector<double> weight;
+    double total = 0.0;
+    for (int f = model.minFloor(); f <= model.maxFloor(); f++) {
+        double w = model.rate(f, timestamp) + model.rate(f, timestamp + DEMAND_SLOT_SECONDS);
+        weight.push_back(w);
+        total += w;
+    }
+    if (total <= 0.0) return floors;
+
+    // Car z parks where cumulative demand first reaches (z + 0.5) / numCars of the total.
+    double cumulative = 0.0;
+    int z = 0;
+    for (size_t i = 0; i < weight.size() && z < numCars; i++) {
+        cumulative += weight[i];
+        while (z < numCars && cumulative >= (z + 0.5) * total / numCars) {
+            floors.push_back(model.minFloor() + static_cast<int>(i));
+            z++;
+        }
+    }
+    while (z++ < numCars) floors.push_back(model.maxFloor());
+    return floors;
+}
+
+std::vector<int> matchParkingFloors(const std::vector<int> &positions, std::vector<int> floors) {
+    // On a line, pairing cars and floors in sorted order minimises total distance.
+    std::vector<size_t> order(positions.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return positions[a] < positions[b]; });
+    std::sort(floors.begin(), floors.end());
+
+    std::vector<int> targets(positions.size());
+    for (size_t i = 0; i < order.size(); i++) targets[order[i]] = floors[i];
+    return targets;
+}
@@ -0,0 +1,50 @@
+#ifndef PARKING_HPP
+#define PARKING_HPP
+
+#include <vector>
+
+#define SECONDS_PER_DAY 86400
+#define DEMAND_SLOT_SECONDS 900                                // 15-minute time-of-day slots
+#define DEMAND_SLOTS (SECONDS_PER_DAY / DEMAND_SLOT_SECONDS)
+#define DEMAND_HALF_LIFE (7 * SECONDS_PER_DAY)                 // Older observations fade over a week
+
+// Learned hall-call arrival rates per floor and per time-of-day slot.
+// Each counter decays exponentially, so recent days outweigh old ones.
+class DemandModel {
+public:
+    DemandModel(int minFloor, int maxFloor);
+
+    // Record one hall call from the given floor at simulated time timestamp.
+    void recordArrival(int floor, int timestamp);
+
+    // Decayed arrival count for a floor in the time-of-day slot containing timestamp.
+    double rate(int floor, int timestamp) const;
+
+    int minFloor() const { return minFloor_; }
+    int maxFloor() const { return maxFloor_; }
+
+private:
+    struct Counter {
+        double value;
+        int lastUpdate;
+    };
+
+    Counter &counter(int floor, int timestamp);
+    const Counter &counter(int floor, int timestamp) const;
+
+    int minFloor_;
+    int maxFloor_;
+    std::vector<Counter> counters_; // (floor - minFloor) * DEMAND_SLOTS + slot
+};
+
+// Parking floors for numCars idle cars, one per demand zone. The floors are
+// split into contiguous zones of equal expected demand over the current and
+// next slot, and each car parks at its zone's weighted median floor.
+// Returns an empty vector when nothing has been learned yet.
+std::vector<int> chooseParkingFloors(const DemandModel &model, int numCars, int timestamp);
+
+// Pair each car position with a parking floor so total travel is minimal.
+// Both vectors have the same length; result[i] is the target for positions[i].
+std::vector<int> matchParkingFloors(const std::vector<int> &positions, std::vector<int> floors);
+
+#endif // PARKING_HPP
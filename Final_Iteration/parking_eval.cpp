@@ -0,0 +1,176 @@
+// parking_eval.cpp
+// Replays one synthetic multi-day trace twice, once with the current reactive
+// dispatch and once with demand-based parking, and compares hall-call wait.
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include "parking.hpp"
+#include "car_state_machine.hpp"
+
+#define MIN_FLOOR 1
+#define MAX_FLOOR 22
+#define NUM_CARS 4
+#define TRAIN_DAYS 5    // days used only for learning before the measured day
+
+struct Call {
+    int time;
+    int floor;
+    int destination;
+};
+
+// Motion is stepped by the same state machine as elevator.cpp; the replay adds the call being served.
+struct Car {
+    CarMotion motion;
+    bool serving;        // Carrying out call (pickup, then destination)
+    bool toDestination;  // Pickup done; the current stop is the destination
+    Call call;
+};
+
+// Free for a new call: idle, or only driving to a parking floor.
+static bool available(const Car &car) {
+    return !car.serving && (car.motion.state == IDLE || (car.motion.flags & CAR_PARKING));
+}
+
+// Arrivals for one day: lobby up-peak, lunch, evening down-peak and light interfloor traffic.
+static void generateDay(int day, std::mt19937 &gen, std::vector<Call> &calls) {
+    std::uniform_int_distribution<int> upper(MIN_FLOOR + 1, MAX_FLOOR);
+    std::uniform_int_distribution<int> anyFloor(MIN_FLOOR, MAX_FLOOR);
+    int base = day * SECONDS_PER_DAY;
+    auto poisson = [&](int from, int to, double meanGap, int kind) {
+        std::exponential_distribution<double> gap(1.0 / meanGap);
+        for (double t = from + gap(gen); t < to; t += gap(gen)) {
+            Call c;
+            c.time = base + static_cast<int>(t);
+            if (kind == 0) {            // up-peak: lobby to upper floors
+                c.floor = MIN_FLOOR;
+                c.destination = upper(gen);
+            } else if (kind == 1) {     // down-peak: upper floors to lobby
+                c.floor = upper(gen);
+                c.destination = MIN_FLOOR;
+            } else {                    // interfloor
+                c.floor = anyFloor(gen);
+                do { c.destination = anyFloor(gen); } while (c.destination == c.floor);
+            }
+            calls.push_back(c);
+        }
+    };
+    poisson(7 * 3600 + 45 * 60, 9 * 3600 + 15 * 60, 45.0, 0);
+    poisson(12 * 3600, 13 * 3600 + 30 * 60, 120.0, 2);
+    poisson(16 * 3600 + 30 * 60, 18 * 3600, 45.0, 1);
+    poisson(7 * 3600, 19 * 3600, 300.0, 2);
+}
+
+// Time-stepped replay (1 s per floor, as in elevator.cpp): the discrete-event
+// runtime for car_state_machine.hpp. Returns the mean wait in seconds of calls
+// placed on the measured (last) day.
+static double replay(const std::vector<Call> &trace, bool parking, int measureFrom) {
+    DemandModel model(MIN_FLOOR, MAX_FLOOR);
+    std::vector<Car> cars(NUM_CARS);
+    for (auto &car : cars) {
+        car.motion = makeCar(MIN_FLOOR);
+        car.serving = false;
+        car.toDestination = false;
+    }
+
+    std::deque<Call> queue;
+    size_t next = 0;
+    long long totalWait = 0;
+    int measured = 0;
+    int end = trace.back().time + 3600;
+
+    for (int now = 0; now < end; now++) {
+        while (next < trace.size() && trace[next].time == now) queue.push_back(trace[next++]);
+
+        // Reactive dispatch: hand queued calls, oldest first, to the nearest idle car.
+        while (!queue.empty()) {
+            int best = -1;
+            int bestDistance = std::numeric_limits<int>::max();
+            for (int i = 0; i < NUM_CARS; i++) {
+                if (!available(cars[i])) continue;
+                int distance = std::abs(cars[i].motion.floor - queue.front().floor);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = i;
+                }
+            }
+            if (best == -1) break;
+            Car &car = cars[best];
+            carStep(car.motion, CAR_STOP);
+            car.call = queue.front();
+            car.serving = true;
+            car.toDestination = false;
+            car.motion.target = static_cast<int16_t>(car.call.floor);
+            if (carStep(car.motion, CAR_GO).action == ACTION_OPEN_DOORS && car.call.time >= measureFrom) {
+                totalWait += now - car.call.time;  // Already at the pickup floor
+                measured++;
+            }
+            queue.pop_front();
+        }
+
+        // Park idle cars while nothing is waiting.
+        if (parking && queue.empty()) {
+            std::vector<int> ids, positions;
+            for (int i = 0; i < NUM_CARS; i++) {
+                if (available(cars[i])) {
+                    ids.push_back(i);
+                    positions.push_back(cars[i].motion.floor);
+                }
+            }
+            std::vector<int> floors = chooseParkingFloors(model, static_cast<int>(ids.size()), now);
+            if (!floors.empty()) {
+                std::vector<int> targets = matchParkingFloors(positions, floors);
+                for (size_t i = 0; i < ids.size(); i++) {
+                    CarMotion &motion = cars[ids[i]].motion;
+                    if (motion.target == targets[i] && motion.state == MOVING) continue;
+                    carStep(motion, CAR_STOP);
+                    motion.target = static_cast<int16_t>(targets[i]);
+                    carStep(motion, CAR_PARK);
+                }
+            }
+        }
+
+        for (auto &car : cars) {
+            CarStep step = carStep(car.motion, CAR_TICK);
+            if (!car.serving) continue;
+            if (step.action == ACTION_MOVE_AND_OPEN && !car.toDestination && car.call.time >= measureFrom) {
+                totalWait += now - car.call.time;
+                measured++;
+            }
+            if (step.action != ACTION_FINISH_STOP) continue;
+            if (!car.toDestination) {
+                car.toDestination = true;
+                car.motion.target = static_cast<int16_t>(car.call.destination);
+                carStep(car.motion, CAR_GO);
+            } else {
+                model.recordArrival(car.call.floor, car.call.time);
+                car.serving = false;
+            }
+        }
+    }
+    return measured ? static_cast<double>(totalWait) / measured : 0.0;
+}
+
+int main() {
+    std::mt19937 gen(3303);
+    std::vector<Call> trace;
+    for (int day = 0; day <= TRAIN_DAYS; day++) generateDay(day, gen, trace);
+    std::sort(trace.begin(), trace.end(), [](const Call &a, const Call &b) { return a.time < b.time; });
+
+    int measureFrom = TRAIN_DAYS * SECONDS_PER_DAY;
+    double reactive = replay(trace, false, measureFrom);
+    double parked = replay(trace, true, measureFrom);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "=== Parking Evaluation (" << NUM_CARS << " cars, floors " << MIN_FLOOR << "-" << MAX_FLOOR
+              << ", " << trace.size() << " calls, day " << TRAIN_DAYS + 1 << " measured) ===" << std::endl;
+    std::cout << "Reactive average wait: " << reactive << " s" << std::endl;
+    std::cout << "Parking  average wait: " << parked << " s" << std::endl;
+    if (reactive > 0.0)
+        std::cout << "Change: " << (parked - reactive) / reactive * 100.0 << " %" << std::endl;
+    return 0;
+}
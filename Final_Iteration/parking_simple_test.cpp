@@ -0,0 +1,82 @@
+// parking_simple_test.cpp
+#include <iostream>
+#include <vector>
+#include "parking.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+// Test decayed demand counters
+int testDemandModel() {
+    std::cout << "\n=== Testing Demand Model ===" << std::endl;
+    DemandModel model(1, 10);
+
+    std::cout << "  Test Case 1: No demand learned" << std::endl;
+    TEST_ASSERT(model.rate(1, 0) == 0.0, "Rate should start at zero");
+    TEST_ASSERT(chooseParkingFloors(model, 2, 0).empty(), "No parking floors without demand");
+
+    std::cout << "  Test Case 2: Arrivals counted in their time-of-day slot" << std::endl;
+    int morning = 8 * 3600;
+    model.recordArrival(1, morning);
+    model.recordArrival(1, morning + 60);
+    TEST_ASSERT(model.rate(1, morning + 60) > 1.99, "Two arrivals should be counted");
+    TEST_ASSERT(model.rate(1, 14 * 3600) == 0.0, "Afternoon slot should stay empty");
+
+    std::cout << "  Test Case 3: Same slot on the next day still remembers demand" << std::endl;
+    double nextDay = model.rate(1, morning + SECONDS_PER_DAY);
+    TEST_ASSERT(nextDay > 1.5 && nextDay < 2.0, "Demand should decay but not vanish after a day");
+
+    std::cout << "Demand Model: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test zoning and car-to-floor matching
+int testParkingFloors() {
+    std::cout << "\n=== Testing Parking Floors ===" << std::endl;
+    DemandModel model(1, 10);
+    int morning = 8 * 3600;
+    for (int i = 0; i < 9; i++) model.recordArrival(1, morning);
+    model.recordArrival(9, morning);
+
+    std::cout << "  Test Case 1: Lobby-heavy demand" << std::endl;
+    std::vector<int> floors = chooseParkingFloors(model, 2, morning);
+    TEST_ASSERT(floors.size() == 2, "One parking floor per idle car");
+    TEST_ASSERT(floors[0] == 1 && floors[1] == 1, "Both cars should park at the lobby");
+
+    std::cout << "  Test Case 2: Matching keeps travel short" << std::endl;
+    std::vector<int> positions = {9, 2};
+    std::vector<int> targets = matchParkingFloors(positions, {1, 8});
+    TEST_ASSERT(targets[0] == 8 && targets[1] == 1, "Car at 9 should take floor 8, car at 2 floor 1");
+
+    std::cout << "Parking Floors: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING PARKING TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testDemandModel();
+    failures += testParkingFloors();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " PARKING TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " PARKING TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
@@ -0,0 +1,73 @@
+/* process_options.cpp */
+#include "process_options.hpp"
+#include "time_manager.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <sched.h>
+#include <sys/resource.h>
+
+bool parseProcessOption(int argc, char *argv[], int &i, ProcessOptions &options) {
+    if (i + 1 >= argc)
+        return false;
+    if (strcmp(argv[i], "--cpu") == 0) {
+        options.cpuList = argv[++i];
+    } else if (strcmp(argv[i], "--nice") == 0) {
+        options.niceValue = std::atoi(argv[++i]);
+        options.setNice = true;
+    } else if (strcmp(argv[i], "--rt-priority") == 0) {
+        options.rtPriority = std::atoi(argv[++i]);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Parse "0-2,5" into a CPU set. Returns false if no CPU was named.
+static bool parseCpuList(const char *list, cpu_set_t &set) {
+    CPU_ZERO(&set);
+    const char *p = list;
+    while (*p) {
+        char *end;
+        long first = strtol(p, &end, 10);
+        if (end == p) return false;
+        long last = first;
+        if (*end == '-') {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p) return false;
+        }
+        for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+            if (cpu >= 0) CPU_SET(cpu, &set);
+        }
+        p = (*end == ',') ? end + 1 : end;
+        if (*end != ',' && *end != '\0') return false;
+    }
+    return CPU_COUNT(&set) > 0;
+}
+
+void applyProcessOptions(const ProcessOptions &options, const char *name) {
+    std::lock_guard<std::mutex> lock(printMutex);
+    if (options.cpuList != nullptr) {
+        cpu_set_t set;
+        if (!parseCpuList(options.cpuList, set) || sched_setaffinity(0, sizeof(set), &set) != 0)
+            std::cerr << "[" << name << "] Could not pin to CPUs " << options.cpuList << "\n";
+        else
+            std::cout << "[" << name << "] Pinned to CPUs " << options.cpuList << "\n";
+    }
+    if (options.setNice) {
+        if (setpriority(PRIO_PROCESS, 0, options.niceValue) != 0)
+            std::cerr << "[" << name << "] Could not set nice " << options.niceValue << "\n";
+        else
+            std::cout << "[" << name << "] Running at nice " << options.niceValue << "\n";
+    }
+    if (options.rtPriority > 0) {
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = options.rtPriority;
+        if (sched_setscheduler(0, SCHED_FIFO, &param) != 0)
+            std::cerr << "[" << name << "] Could not set real-time priority " << options.rtPriority << "\n";
+        else
+            std::cout << "[" << name << "] Running SCHED_FIFO at priority " << options.rtPriority << "\n";
+    }
+}
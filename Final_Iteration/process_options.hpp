@@ -0,0 +1,25 @@
+#ifndef PROCESS_OPTIONS_HPP
+#define PROCESS_OPTIONS_HPP
+
+#define PROCESS_OPTIONS_USAGE "[--cpu LIST] [--nice N] [--rt-priority N]"
+
+// Placement and priority for one subsystem process.
+struct ProcessOptions {
+    const char *cpuList;  // e.g. "2" or "2-3,6"; nullptr leaves affinity alone
+    int niceValue;        // Applied when setNice is true
+    bool setNice;
+    int rtPriority;       // SCHED_FIFO priority; 0 keeps the normal scheduler
+
+    ProcessOptions() : cpuList(nullptr), niceValue(0), setNice(false), rtPriority(0) {}
+};
+
+// If argv[i] is a process option, consume it (and its value) and return true.
+bool parseProcessOption(int argc, char *argv[], int &i, ProcessOptions &options);
+
+// Apply the options to the calling thread before any other thread starts, so
+// every thread of the process inherits them. Failures (an empty CPU list, or
+// no permission for a negative nice or real-time priority) are reported and
+// the process carries on with its defaults.
+void applyProcessOptions(const ProcessOptions &options, const char *name);
+
+#endif // PROCESS_OPTIONS_HPP
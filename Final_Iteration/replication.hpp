@@ -0,0 +1,33 @@
+#ifndef REPLICATION_HPP
+#define REPLICATION_HPP
+
+#include "scheduler_journal.hpp"
+#include <cstdint>
+
+#define REPLICATION_PORT 8200       // Hot-standby scheduler listens here
+#define HEARTBEAT_MS 100            // Primary shards announce themselves this often
+#define FAILOVER_TIMEOUT_MS 500     // Standby takes over after this long without a word
+#define REPLICATION_MAX_BYTES 65000 // Largest datagram (a shard snapshot) on the stream
+
+// Primary -> standby, except REPL_SYNC_REQUEST which goes back to the shard.
+enum ReplicationKind {
+    REPL_HEARTBEAT,
+    REPL_RECORD,        // One journal record, applied by the standby as it arrives
+    REPL_SYNC_REQUEST,  // Standby is behind (just started, or saw a gap) and wants a snapshot
+    REPL_SNAPSHOT       // Whole shard state, followed by records after `sequence`
+};
+
+struct ReplicationHeader {
+    uint32_t kind;      // ReplicationKind
+    uint32_t bank;
+    uint64_t sequence;  // Record number; for a snapshot, the last record it covers
+};
+
+struct ReplicationRecord {
+    ReplicationHeader header;
+    uint32_t type;      // JournalEventType
+    uint32_t reserved;
+    ElevatorMessage msg;
+};
+
+#endif // REPLICATION_HPP
@@ -2,330 +2,1167 @@
 #include "message.hpp"
 #include "time_manager.hpp"
 #include "scheduler.hpp"
+#include "load_model.hpp"
+#include "parking.hpp"
+#include "batch_dispatch.hpp"
+#include "destination_dispatch.hpp"
+#include "event_trace.hpp"
+#include "scheduler_journal.hpp"
+#include "replication.hpp"
+#include "fleet.hpp"
 #include <iostream>
 #include <cstring>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <vector>
 #include <limits>
-#include <set>
-#include <queue>
+#include <algorithm>
 #include <mutex>
 #include <thread>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/time.h>
 #include <chrono>
+#include <cstdint>
+#include <pthread.h>
+#include <sched.h>
 
-#define SCHEDULER_PORT 8100
-#define ELEVATOR_PORT_BASE 9100
-#define MAX_ELEVATORS 4      
-#define MIN_FLOOR 1  
-#define RESPONSE_TIMEOUT 10  
-#define MAX_CAPACITY 4       
+#define MAX_ELEVATORS 4
+#define LOBBY_FLOOR 1        // Served by every bank
+#define PARKING_ENABLED 1    // 0 restores purely reactive dispatch (cars wait where they finish)
+#define BATCH_DISPATCH 1     // 0 restores greedy one-call-at-a-time assignment
+#define DESTINATION_DISPATCH 1 // Group same-origin calls with nearby destinations (needs BATCH_DISPATCH)
+#define RESPONSE_TIMEOUT 10
+#define JOURNAL_BASE "scheduler_bank" // Bank b journals to scheduler_bank<b>.journal / .snapshot
+#define REGISTRATION_RETRY_MS 2000    // Re-query cars that have not answered after a recovery
+#define DASHBOARD_PUBLISH_MS 500      // How often each shard copies its fleet for the dashboard
+#define MAX_BANKS 8                   // Zones splitIntoBanks() can name
 
 extern bool systemActive;
 
-std::mutex printMutex;
-std::mutex pendingMutex;
-std::queue<ElevatorMessage> pendingRequests;
-std::set<std::pair<int, int>> processedRequests;
-
-int sockfd;
-
-SchedulerState schedulerState = IDLE_SCHEDULER;
-
-// Elevator structure updated with fault flag.
-struct Elevator {
-    int id;
-    int position;
-    bool isMoving;
-    bool isIdle;
-    bool goingUp;
-    int passengerCount;
-    bool isFaulted; // This flag is no longer set automatically on timeout.
-    struct sockaddr_in address;
+std::vector<Bank> banks = {
+    {"LOW-RISE",  2, 11, 0, 2},
+    {"HIGH-RISE", 12, MAX_FLOOR, 2, 2},
 };
 
-std::vector<Elevator> elevators(MAX_ELEVATORS);
+SchedulerShard::SchedulerShard(const Bank &b)
+    : bank(&b), sockfd(-1), state(IDLE_SCHEDULER),
+      fleet(b.firstElevator, b.numElevators, MIN_FLOOR), addresses(b.numElevators),
+      demandModel(MIN_FLOOR, MAX_FLOOR), batchWindowOpen(false), nextGroupId(1),
+      replfd(-1), replicationSequence(0) {
+    for (int i = 0; i < b.numElevators; i++) {
+        memset(&addresses[i], 0, sizeof(addresses[i]));
+        addresses[i].sin_family = AF_INET;
+        addresses[i].sin_port = htons(ELEVATOR_PORT_BASE + fleet.id(i));
+        inet_pton(AF_INET, "127.0.0.1", &addresses[i].sin_addr);
+    }
+    memset(&routerAddress, 0, sizeof(routerAddress));
+    routerAddress.sin_family = AF_INET;
+    routerAddress.sin_port = htons(SCHEDULER_PORT);
+    inet_pton(AF_INET, "127.0.0.1", &routerAddress.sin_addr);
+}
+
+static std::vector<SchedulerShard> makeShards() {
+    std::vector<SchedulerShard> result;
+    for (const Bank &bank : banks)
+        result.push_back(SchedulerShard(bank));
+    return result;
+}
+
+// Built before any thread starts and never resized.
+std::vector<SchedulerShard> shards = makeShards();
 
-// Structure to track in-progress assignments.
-struct InProgressRequest {
-    ElevatorMessage msg;
-    int assignedTime;
-    int elevatorId;
+// What the dashboard shows of one bank: a copy of its fleet, published by the
+// thread that owns the shard, so the dashboard never reads a fleet mid-update.
+struct DashboardView {
+    std::mutex mutex;
+    Fleet fleet;
 };
 
-std::mutex inProgressMutex;
-std::vector<InProgressRequest> inProgressRequests;
+static std::vector<DashboardView> dashboardViews(banks.size());
 
+void splitIntoBanks(int count, int carsPerBank) {
+    static const char *const names[MAX_BANKS] = {"ZONE-A", "ZONE-B", "ZONE-C", "ZONE-D",
+                                                 "ZONE-E", "ZONE-F", "ZONE-G", "ZONE-H"};
+    count = std::max(1, std::min(count, MAX_BANKS));
+    int lowest = LOBBY_FLOOR + 1;
+    int floors = MAX_FLOOR - lowest + 1;
+    banks.clear();
+    for (int b = 0; b < count; b++) {
+        Bank bank = {names[b], lowest + floors * b / count, lowest + floors * (b + 1) / count - 1,
+                     b * carsPerBank, carsPerBank};
+        banks.push_back(bank);
+    }
+    shards = makeShards();
+    dashboardViews = std::vector<DashboardView>(banks.size());
+}
 
+// Set when a standby has taken over with state replicated from the primary.
+static bool tookOverFromPrimary = false;
+
+// Index of the car with this id if it belongs to the shard's bank, otherwise -1.
+static int findCar(const SchedulerShard &shard, int id) {
+    int car = id - shard.fleet.firstId;
+    if (car < 0 || car >= shard.fleet.size())
+        return -1;
+    return car;
+}
 
+static bool inZone(const Bank &bank, int floor) {
+    return floor >= bank.lowestFloor && floor <= bank.highestFloor;
+}
+
+// Lobby calls go to the bank serving the destination; all others to the bank
+// serving the pickup floor. Floors outside every zone fall back to bank 0.
+static int routeToBank(const ElevatorMessage &request) {
+    int floor = (request.floorNumber == LOBBY_FLOOR) ? request.destination : request.floorNumber;
+    for (size_t b = 0; b < banks.size(); b++) {
+        if (inZone(banks[b], floor))
+            return static_cast<int>(b);
+    }
+    return 0;
+}
+
+// Load the car will carry once everyone assigned to it has boarded.
+static int projectedPersons(const Fleet &fleet, int car) {
+    return fleet.passengerCount[car] + fleet.reservedPersons[car];
+}
+
+static int projectedKg(const Fleet &fleet, int car) {
+    return fleet.loadKg[car] + passengerWeightKg(fleet.reservedPersons[car]);
+}
 
-// The displayDashboard function is unchanged.
+// A car can take a hall call if it is healthy, below the bypass threshold,
+// and has room for the whole group waiting at the floor. Fleet::eligible()
+// answers the same question for the whole fleet at once.
+bool canServe(const Fleet &fleet, int car, const ElevatorMessage &request) {
+    if (fleet.faulted.test(car) || fleet.awaitingRegistration.test(car))
+        return false;
+    if (shouldBypass(projectedPersons(fleet, car), projectedKg(fleet, car)))
+        return false;
+    return canBoard(projectedPersons(fleet, car), projectedKg(fleet, car), request.passengers);
+}
+
+// Copy the shard's fleet for the dashboard, at most every DASHBOARD_PUBLISH_MS.
+// Only the thread that owns the shard calls this.
+static void publishDashboard(SchedulerShard &shard) {
+    auto now = std::chrono::steady_clock::now();
+    if (now - shard.lastDashboardPublish < std::chrono::milliseconds(DASHBOARD_PUBLISH_MS))
+        return;
+    DashboardView &view = dashboardViews[shard.bank - banks.data()];
+    std::lock_guard<std::mutex> lock(view.mutex);
+    view.fleet = shard.fleet;
+    shard.lastDashboardPublish = now;
+}
+
+// Prints the fleets the shards last published; it never touches a live shard.
 void displayDashboard() {
+    Fleet fleet;
     while(systemActive) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
         std::lock_guard<std::mutex> lock(printMutex);
         std::cout << "\n===== Elevator Dashboard =====\n";
-        for (const auto &elevator : elevators) {
-            std::cout << "Elevator " << elevator.id 
-                      << " | Floor: " << elevator.position 
-                      << " | Status: " << (elevator.isFaulted ? "FAULTED" : 
-                                           (!elevator.isIdle ? "BUSY" : "IDLE"))
-                      << " | Passengers: " << elevator.passengerCount 
-                      << std::endl;
+        for (size_t b = 0; b < dashboardViews.size(); b++) {
+            {
+                std::lock_guard<std::mutex> viewLock(dashboardViews[b].mutex);
+                fleet = dashboardViews[b].fleet;
+            }
+            for (int car = 0; car < fleet.size(); car++) {
+                std::cout << "Elevator " << fleet.id(car)
+                          << " [" << banks[b].name << "]"
+                          << " | Floor: " << fleet.position[car]
+                          << " | Status: " << (fleet.faulted.test(car) ? "FAULTED" :
+                                               (!fleet.idle.test(car) ? "BUSY" : "IDLE"))
+                          << " | Load: " << fleet.passengerCount[car] << "/" << RATED_PERSONS
+                          << " (" << fleet.loadKg[car] << " kg, "
+                          << loadPercent(fleet.passengerCount[car], fleet.loadKg[car]) << "%)"
+                          << " | Reserved: " << fleet.reservedPersons[car]
+                          << std::endl;
+            }
         }
         std::cout << "==============================" << std::endl;
     }
 }
 
-void assignElevator() {
-    schedulerState = ASSIGNING;
-    
-    pendingMutex.lock();
-    if (pendingRequests.empty()) {
-        pendingMutex.unlock();
-        return;
-    }
-    ElevatorMessage request = pendingRequests.front();
-    pendingRequests.pop();
-    pendingMutex.unlock();
-
-    if (request.floorNumber == request.destination || request.destination < MIN_FLOOR) {
+// Reject calls that are not a trip between two floors of the building.
+static bool isValidCall(const SchedulerShard &shard, const ElevatorMessage &request) {
+    if (request.floorNumber == request.destination ||
+        !CallTable::inRange(std::make_pair(request.floorNumber, request.destination))) {
         std::lock_guard<std::mutex> lock(printMutex);
-        std::cout << "[SCHEDULER] Ignoring invalid request: From " << request.floorNumber 
+        std::cout << "[SCHEDULER " << shard.bank->name << "] Ignoring invalid request: From " << request.floorNumber
                   << " to " << request.destination << "\n";
-        return;
+        return false;
     }
+    return true;
+}
 
-    std::pair<int, int> requestPair = {request.floorNumber, request.destination};
-    if (processedRequests.count(requestPair)) {
-        return;
-    }
-    processedRequests.insert(requestPair);
+// Reject invalid and already-processed requests.
+bool isAcceptable(SchedulerShard &shard, const ElevatorMessage &request) {
+    return isValidCall(shard, request) &&
+           shard.processedRequests.count(std::make_pair(request.floorNumber, request.destination)) == 0;
+}
 
-    int bestElevator = -1;
-    int minDistance = std::numeric_limits<int>::max();
-    int minStops = std::numeric_limits<int>::max();
+// How the front queued call enters dispatch. A repeat of an accepted call is
+// more people making the same trip, so it is merged rather than dropped.
+static JournalEventType admission(const SchedulerShard &shard, const ElevatorMessage &request) {
+    if (!isValidCall(shard, request))
+        return JOURNAL_REJECTED;
+    if (shard.processedRequests.count(std::make_pair(request.floorNumber, request.destination)) == 0)
+        return JOURNAL_ACCEPTED;
+    return JOURNAL_MERGED;
+}
 
-    // First, try to choose an idle elevator at the pickup floor that is not full.
-    for (auto &elevator : elevators) {
-        if (elevator.isFaulted || elevator.passengerCount >= MAX_CAPACITY)
-            continue;
-        if (elevator.isIdle && elevator.position == request.floorNumber) {
-            bestElevator = elevator.id;
-            break;
+// The waiting call a repeat of msg joins: same trip, not yet given to a car,
+// and with room left for the extra passengers. Null if there is none.
+static ElevatorMessage *mergeTarget(SchedulerShard &shard, const ElevatorMessage &msg) {
+    for (ElevatorMessage &waiting : shard.unservedCalls) {
+        if (waiting.floorNumber == msg.floorNumber && waiting.destination == msg.destination &&
+            waiting.passengers + msg.passengers <= RATED_PERSONS)
+            return &waiting;
+    }
+    return nullptr;
+}
+
+static void eraseUnserved(SchedulerShard &shard, const ElevatorMessage &msg) {
+    for (auto it = shard.unservedCalls.begin(); it != shard.unservedCalls.end(); ++it) {
+        if (it->floorNumber == msg.floorNumber && it->destination == msg.destination) {
+            shard.unservedCalls.erase(it);
+            return;
         }
     }
-    if (bestElevator == -1) {
-        // Next, try to choose a moving elevator heading toward the pickup floor.
-        for (auto &elevator : elevators) {
-            if (elevator.isFaulted || elevator.passengerCount >= MAX_CAPACITY)
-                continue;
-            if (elevator.isMoving && 
-               ((elevator.goingUp && request.floorNumber >= elevator.position) ||
-                (!elevator.goingUp && request.floorNumber <= elevator.position))) {
-                int distance = std::abs(elevator.position - request.floorNumber);
-                if (distance < minDistance) {
-                    minDistance = distance;
-                    bestElevator = elevator.id;
-                }
-            }
+}
+
+static void eraseInProgress(SchedulerShard &shard, const ElevatorMessage &msg, int elevatorId, bool learnDemand) {
+    for (auto it = shard.inProgressRequests.begin(); it != shard.inProgressRequests.end(); ++it) {
+        if (it->elevatorId == elevatorId &&
+            it->msg.floorNumber == msg.floorNumber &&
+            it->msg.destination == msg.destination) {
+            if (learnDemand)
+                shard.demandModel.recordArrival(it->msg.floorNumber, it->msg.timestamp);
+            shard.inProgressRequests.erase(it);
+            return;
         }
     }
-    if (bestElevator == -1) {
-        // Then, choose any idle elevator (not full) that is closest to the pickup floor.
-        for (auto &elevator : elevators) {
-            if (elevator.isFaulted || elevator.passengerCount >= MAX_CAPACITY)
-                continue;
-            if (elevator.isIdle) {
-                int distance = std::abs(elevator.position - request.floorNumber);
-                if (distance < minDistance) {
-                    minDistance = distance;
-                    bestElevator = elevator.id;
-                }
+}
+
+// The only place shard state changes. Live dispatch reaches it through
+// record(); recovery replays journal records straight into it.
+static void applyEvent(SchedulerShard &shard, JournalEventType type, const ElevatorMessage &msg) {
+    std::pair<int, int> requestPair(msg.floorNumber, msg.destination);
+    switch (type) {
+    case JOURNAL_SUBMITTED:
+        shard.pendingRequests.push(msg);
+        return;
+    case JOURNAL_ACCEPTED:
+        if (!shard.pendingRequests.empty()) shard.pendingRequests.pop();
+        shard.processedRequests.insert(requestPair);
+        shard.unservedCalls.push_back(msg);
+        return;
+    case JOURNAL_REJECTED:
+        if (!shard.pendingRequests.empty()) shard.pendingRequests.pop();
+        return;
+    case JOURNAL_MERGED: {
+        if (!shard.pendingRequests.empty()) shard.pendingRequests.pop();
+        // Join the waiting call; if it is already with a car (or full), the
+        // extra passengers wait as a group of their own.
+        ElevatorMessage *waiting = mergeTarget(shard, msg);
+        if (waiting != nullptr)
+            waiting->passengers += msg.passengers;
+        else
+            shard.unservedCalls.push_back(msg);
+        return;
+    }
+    case JOURNAL_ABANDONED:
+        eraseUnserved(shard, msg);
+        shard.processedRequests.erase(requestPair);
+        return;
+    default:
+        break;
+    }
+
+    int car = findCar(shard, msg.assignedElevator);
+    if (car < 0)
+        return;
+
+    Fleet &fleet = shard.fleet;
+    bool faulted = fleet.faulted.test(car);
+    switch (type) {
+    case JOURNAL_ASSIGNED: {
+        eraseUnserved(shard, msg);
+        shard.processedRequests.insert(requestPair);
+        fleet.parkingFloor[car] = -1;
+        fleet.idle.set(car, false);
+        fleet.moving.set(car, true);
+        fleet.goingUp.set(car, msg.directionUp);
+        fleet.reservedPersons[car] += msg.passengers;  // Held until they board
+        fleet.queuedTrips[car]++;
+        fleet.tripEndFloor[car] = msg.destination;
+        InProgressRequest ipr;
+        ipr.msg = msg;
+        ipr.assignedTime = currentTime.load();
+        ipr.elevatorId = fleet.id(car);
+        shard.inProgressRequests.push_back(ipr);
+        break;
+    }
+    case JOURNAL_POSITION:
+        if (!faulted)
+            fleet.position[car] = msg.floorNumber;
+        break;
+    case JOURNAL_BOARDED:
+        // The reserved group is now on board.
+        fleet.reservedPersons[car] -= msg.passengers;
+        if (fleet.reservedPersons[car] < 0)
+            fleet.reservedPersons[car] = 0;
+        fleet.passengerCount[car] = msg.carLoad;
+        fleet.loadKg[car] = msg.carLoadKg;
+        if (!faulted)
+            fleet.position[car] = msg.floorNumber;
+        break;
+    case JOURNAL_COMPLETED:
+        eraseInProgress(shard, msg, fleet.id(car), true);
+        // The call is served; the same hall call may be placed again.
+        shard.processedRequests.erase(requestPair);
+        // Only update if the elevator is not marked as faulted (though faulting no longer happens automatically).
+        if (fleet.queuedTrips[car] > 0)
+            fleet.queuedTrips[car]--;
+        if (!faulted) {
+            fleet.position[car] = msg.destination;
+            // Passengers alighted; take the car's own load report.
+            fleet.passengerCount[car] = msg.carLoad;
+            fleet.loadKg[car] = msg.carLoadKg;
+            if (fleet.queuedTrips[car] == 0) {
+                fleet.idle.set(car, true);
+                fleet.moving.set(car, false);
             }
         }
-    }
-    if (bestElevator == -1) {
-        // Finally, choose elevator with fewest passengers (if not full).
-        for (auto &elevator : elevators) {
-            if (elevator.isFaulted || elevator.passengerCount >= MAX_CAPACITY)
-                continue;
-            if (elevator.passengerCount < minStops) {
-                minStops = elevator.passengerCount;
-                bestElevator = elevator.id;
+        break;
+    case JOURNAL_FAULTED:
+        if (fleet.queuedTrips[car] > 0)
+            fleet.queuedTrips[car]--;
+        if (!faulted && fleet.queuedTrips[car] == 0) {
+            fleet.idle.set(car, true);
+            fleet.moving.set(car, false);
+        }
+        // The group never boarded; release its reservation before reassigning.
+        fleet.reservedPersons[car] -= msg.passengers;
+        if (fleet.reservedPersons[car] < 0)
+            fleet.reservedPersons[car] = 0;
+        eraseInProgress(shard, msg, fleet.id(car), false);
+        // Let the reassignment through the duplicate check.
+        shard.processedRequests.erase(requestPair);
+        break;
+    case JOURNAL_PARKED:
+        fleet.parkingFloor[car] = msg.destination;
+        break;
+    case JOURNAL_REGISTERED:
+        // The car answers only after serving every assignment queued before the
+        // query, so trips still in progress here completed while we were down.
+        fleet.position[car] = msg.floorNumber;
+        fleet.passengerCount[car] = msg.carLoad;
+        fleet.loadKg[car] = msg.carLoadKg;
+        fleet.reservedPersons[car] = 0;
+        fleet.queuedTrips[car] = 0;
+        fleet.tripEndFloor[car] = msg.floorNumber;
+        fleet.parkingFloor[car] = -1;
+        fleet.idle.set(car, true);
+        fleet.moving.set(car, false);
+        fleet.awaitingRegistration.set(car, false);
+        for (auto it = shard.inProgressRequests.begin(); it != shard.inProgressRequests.end();) {
+            if (it->elevatorId == fleet.id(car)) {
+                shard.processedRequests.erase(std::make_pair(it->msg.floorNumber, it->msg.destination));
+                it = shard.inProgressRequests.erase(it);
+            } else {
+                ++it;
             }
         }
+        break;
+    default:
+        break;
     }
+}
 
-    if (bestElevator == -1) {
-        std::lock_guard<std::mutex> lock(printMutex);
-        std::cerr << "[SCHEDULER] ERROR: No available (non-faulted / non-full) elevator for request from " 
-                  << request.floorNumber << " to " << request.destination << "!\n";
+template <typename T>
+static void putPod(std::vector<char> &out, const T &value) {
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// Pairs go field by field; std::pair is not safe to copy as raw bytes.
+template <typename A, typename B>
+static void putPod(std::vector<char> &out, const std::pair<A, B> &value) {
+    putPod(out, value.first);
+    putPod(out, value.second);
+}
+
+template <typename T>
+static void putVector(std::vector<char> &out, const std::vector<T> &values) {
+    putPod(out, static_cast<uint64_t>(values.size()));
+    for (const T &value : values)
+        putPod(out, value);
+}
+
+template <typename T>
+static bool getPod(const std::vector<char> &in, size_t &offset, T &value) {
+    if (in.size() - offset < sizeof(T))
+        return false;
+    memcpy(&value, in.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+template <typename A, typename B>
+static bool getPod(const std::vector<char> &in, size_t &offset, std::pair<A, B> &value) {
+    return getPod(in, offset, value.first) && getPod(in, offset, value.second);
+}
+
+template <typename T>
+static bool getVector(const std::vector<char> &in, size_t &offset, std::vector<T> &values) {
+    uint64_t count;
+    if (!getPod(in, offset, count) || count > (in.size() - offset) / sizeof(T))
+        return false;
+    values.resize(count);
+    for (T &value : values)
+        getPod(in, offset, value);
+    return true;
+}
+
+// The fleet array by array; the masks go as their words.
+static void putFleet(std::vector<char> &out, const Fleet &fleet) {
+    putPod(out, fleet.firstId);
+    putPod(out, fleet.cars);
+    putVector(out, fleet.position);
+    putVector(out, fleet.passengerCount);
+    putVector(out, fleet.loadKg);
+    putVector(out, fleet.reservedPersons);
+    putVector(out, fleet.queuedTrips);
+    putVector(out, fleet.tripEndFloor);
+    putVector(out, fleet.parkingFloor);
+    putVector(out, fleet.idle.words);
+    putVector(out, fleet.moving.words);
+    putVector(out, fleet.goingUp.words);
+    putVector(out, fleet.faulted.words);
+    putVector(out, fleet.awaitingRegistration.words);
+}
+
+static bool getFleet(const std::vector<char> &in, size_t &offset, Fleet &fleet) {
+    return getPod(in, offset, fleet.firstId) && getPod(in, offset, fleet.cars) &&
+           getVector(in, offset, fleet.position) && getVector(in, offset, fleet.passengerCount) &&
+           getVector(in, offset, fleet.loadKg) && getVector(in, offset, fleet.reservedPersons) &&
+           getVector(in, offset, fleet.queuedTrips) && getVector(in, offset, fleet.tripEndFloor) &&
+           getVector(in, offset, fleet.parkingFloor) && getVector(in, offset, fleet.idle.words) &&
+           getVector(in, offset, fleet.moving.words) && getVector(in, offset, fleet.goingUp.words) &&
+           getVector(in, offset, fleet.faulted.words) && getVector(in, offset, fleet.awaitingRegistration.words);
+}
+
+// Everything the journal can rebuild, in a flat form. The demand model is
+// left out: it is a statistical estimate and re-learns after a restart.
+std::vector<char> snapshotShard(const SchedulerShard &shard) {
+    const CallQueue &queue = shard.pendingRequests;
+    std::vector<ElevatorMessage> pending(queue.calls.begin() + queue.head, queue.calls.end());
+    std::vector<std::pair<int, int>> processed = shard.processedRequests.pairs();
+
+    std::vector<char> state;
+    putFleet(state, shard.fleet);
+    putVector(state, shard.inProgressRequests);
+    putVector(state, pending);
+    putVector(state, shard.unservedCalls);
+    putVector(state, processed);
+    putPod(state, shard.nextGroupId);
+    return state;
+}
+
+bool restoreShard(SchedulerShard &shard, const std::vector<char> &state) {
+    Fleet fleet;
+    std::vector<InProgressRequest> inProgress;
+    std::vector<ElevatorMessage> pending, unserved;
+    std::vector<std::pair<int, int>> processed;
+    int nextGroupId;
+    size_t offset = 0;
+    if (!getFleet(state, offset, fleet) || !getVector(state, offset, inProgress) ||
+        !getVector(state, offset, pending) || !getVector(state, offset, unserved) ||
+        !getVector(state, offset, processed) || !getPod(state, offset, nextGroupId))
+        return false;
+    // A snapshot from a different bank layout does not apply.
+    // Addresses are configuration, not state, and stay as they are.
+    if (fleet.size() != shard.fleet.size() || fleet.firstId != shard.fleet.firstId ||
+        fleet.position.size() != shard.fleet.position.size())
+        return false;
+    shard.fleet = fleet;
+    shard.inProgressRequests.swap(inProgress);
+    shard.pendingRequests.calls.swap(pending);
+    shard.pendingRequests.head = 0;
+    shard.unservedCalls.swap(unserved);
+    shard.processedRequests.clear();
+    for (const std::pair<int, int> &call : processed)
+        shard.processedRequests.insert(call);
+    shard.nextGroupId = nextGroupId;
+    return true;
+}
+
+static struct sockaddr_in localAddress(int port) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    return addr;
+}
+
+// Stream a record to the standby (if one is listening).
+static void replicate(SchedulerShard &shard, JournalEventType type, const ElevatorMessage &msg) {
+    shard.replicationSequence++;
+    if (shard.replfd < 0)
         return;
+    ReplicationRecord rec = ReplicationRecord();
+    rec.header.kind = REPL_RECORD;
+    rec.header.bank = static_cast<uint32_t>(shard.bank - banks.data());
+    rec.header.sequence = shard.replicationSequence;
+    rec.type = type;
+    rec.msg = msg;
+    struct sockaddr_in standby = localAddress(REPLICATION_PORT);
+    sendto(shard.replfd, &rec, sizeof(rec), 0, (struct sockaddr*)&standby, sizeof(standby));
+}
+
+// Write-ahead: journal and replicate the change, then apply it.
+static void record(SchedulerShard &shard, JournalEventType type, const ElevatorMessage &msg) {
+    shard.journal.append(type, msg);
+    replicate(shard, type, msg);
+    applyEvent(shard, type, msg);
+    if (shard.journal.snapshotDue())
+        shard.journal.writeSnapshot(snapshotShard(shard));
+}
+
+// Ask every car that has not registered yet for its state (msgType = 7).
+static void queryUnregisteredCars(SchedulerShard &shard) {
+    const Fleet &fleet = shard.fleet;
+    for (int car = 0; car < fleet.size(); car++) {
+        if (!fleet.awaitingRegistration.test(car))
+            continue;
+        ElevatorMessage query(fleet.position[car], fleet.position[car], true, fleet.id(car), currentTime.load());
+        query.msgType = 7;
+        query.passengers = 0;
+        sendto(shard.sockfd, &query, sizeof(query), 0, (struct sockaddr*)&shard.addresses[car], sizeof(shard.addresses[car]));
+    }
+    shard.lastRegistrationQuery = std::chrono::steady_clock::now();
+}
+
+// Rebuild the shard from its last snapshot and the journal records after it.
+static void recoverShard(SchedulerShard &shard) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<char> state;
+    std::vector<JournalRecord> records;
+    shard.journal.recover(state, records);
+    bool fromSnapshot = !state.empty() && restoreShard(shard, state);
+    for (const JournalRecord &rec : records)
+        applyEvent(shard, static_cast<JournalEventType>(rec.type), rec.msg);
+    // Start the next journal from the recovered state.
+    shard.journal.writeSnapshot(snapshotShard(shard));
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (int car = 0; car < shard.fleet.size(); car++)
+        shard.fleet.awaitingRegistration.set(car, true);
+    {
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[SCHEDULER " << shard.bank->name << "] Recovered " << (fromSnapshot ? "snapshot + " : "")
+                  << records.size() << " journal record(s) in " << ms << " ms: "
+                  << shard.inProgressRequests.size() << " trip(s) in progress, "
+                  << shard.pendingRequests.size() + shard.unservedCalls.size() << " call(s) waiting\n";
     }
+    queryUnregisteredCars(shard);
+}
 
-    request.assignedElevator = bestElevator;
+// Commit a request to an elevator: record the assignment, then send it.
+static void dispatchToElevator(SchedulerShard &shard, ElevatorMessage request, int car) {
+    request.assignedElevator = shard.fleet.id(car);
     request.msgType = 0;  // assignment message
-    elevators[bestElevator].isIdle = false;
-    elevators[bestElevator].isMoving = true;
-    elevators[bestElevator].goingUp = request.directionUp;
-    elevators[bestElevator].passengerCount++;  // Increment capacity counter
-    
+    record(shard, JOURNAL_ASSIGNED, request);
+
     {
         std::lock_guard<std::mutex> lock(printMutex);
-        std::cout << "[SCHEDULER] Assigned request (From " << request.floorNumber 
-                  << " to " << request.destination << ") to Elevator " << bestElevator 
+        std::cout << "[SCHEDULER " << shard.bank->name << "] Assigned request (From " << request.floorNumber
+                  << " to " << request.destination << ", " << request.passengers
+                  << " passenger(s)) to Elevator " << request.assignedElevator
                   << " at time " << request.timestamp << "\n";
     }
 
-    sendto(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&elevators[bestElevator].address, sizeof(elevators[bestElevator].address));
+    sendto(shard.sockfd, &request, sizeof(request), 0, (struct sockaddr*)&shard.addresses[car], sizeof(shard.addresses[car]));
+    traceEvent(TRACE_ASSIGNMENT, request.assignedElevator, request.floorNumber, request.destination,
+               request.passengers, request.groupId);
+}
 
-    {
-        std::lock_guard<std::mutex> lock(inProgressMutex);
-        InProgressRequest ipr;
-        ipr.msg = request;
-        ipr.assignedTime = currentTime.load();
-        ipr.elevatorId = bestElevator;
-        inProgressRequests.push_back(ipr);
+// Estimated seconds until the car can reach the pickup floor of a request.
+// Fleet::etas() works out the same for the whole fleet at once.
+int estimateEta(const Fleet &fleet, int car, const ElevatorMessage &request) {
+    if (!canServe(fleet, car, request))
+        return ETA_UNREACHABLE;
+    if (fleet.queuedTrips[car] == 0)
+        return std::abs(fleet.position[car] - request.floorNumber) * ETA_SECONDS_PER_FLOOR;
+    // Busy: finish the queued trips, then travel from the last drop-off.
+    return (std::abs(fleet.position[car] - fleet.tripEndFloor[car]) +
+            std::abs(fleet.tripEndFloor[car] - request.floorNumber)) * ETA_SECONDS_PER_FLOOR +
+           fleet.queuedTrips[car] * ETA_SECONDS_PER_TRIP;
+}
+
+// Tell the floor which car a passenger should board (msgType = 6), via the router.
+static void notifyFloor(SchedulerShard &shard, const ElevatorMessage &request, int elevatorId) {
+    ElevatorMessage notice = request;
+    notice.assignedElevator = elevatorId;
+    notice.msgType = 6;
+    notice.timestamp = currentTime.load();
+    sendto(shard.sockfd, &notice, sizeof(notice), 0, (struct sockaddr*)&shard.routerAddress, sizeof(shard.routerAddress));
+}
+
+// Jointly assign every unserved call. Calls are first grouped (destination
+// dispatch), then each car takes at most one group per round; groups left
+// over stay unserved and are re-optimised with the next arrivals.
+void assignBatch(SchedulerShard &shard) {
+    shard.state = ASSIGNING;
+    shard.batchWindowOpen = false;
+
+    while (!shard.pendingRequests.empty()) {
+        ElevatorMessage request = shard.pendingRequests.front();
+        record(shard, admission(shard, request), request);
+    }
+    if (shard.unservedCalls.empty()) {
+        shard.state = IDLE_SCHEDULER;
+        return;
+    }
+
+    // Dispatching removes calls from unservedCalls, so plan on a copy.
+    std::vector<ElevatorMessage> unserved = shard.unservedCalls;
+
+    // Without destination dispatch a negative span keeps every call in its own group.
+    std::vector<TripGroup> groups = groupCalls(unserved,
+                                               DESTINATION_DISPATCH ? GROUP_DESTINATION_SPAN : -1,
+                                               RATED_PERSONS);
+
+    int cars = shard.fleet.size();
+    int numGroups = static_cast<int>(groups.size());
+    std::vector<int> cost(cars * numGroups);
+    for (int g = 0; g < numGroups; g++) {
+        // ETA to the shared origin, with the whole group's passengers counted for capacity:
+        // one eligibility mask and one vector ETA pass per group (see Fleet::etas()).
+        shard.fleet.eligible(groups[g].passengers, shard.eligible);
+        shard.fleet.etas(groups[g].origin, shard.eligible, shard.etas);
+        for (int c = 0; c < cars; c++)
+            cost[c * numGroups + g] = shard.etas[c];
     }
-    schedulerState = IDLE_SCHEDULER;
+
+    std::vector<int> match = solveAssignment(cost, cars, numGroups);
+    for (int c = 0; c < cars; c++) {
+        if (match[c] < 0) continue;
+        const TripGroup &group = groups[match[c]];
+        int groupId = shard.nextGroupId++;
+        for (int index : group.members) {
+            ElevatorMessage member = unserved[index];
+            member.groupId = groupId;
+            member.groupSize = static_cast<int>(group.members.size());
+            dispatchToElevator(shard, member, c);
+            notifyFloor(shard, member, shard.fleet.id(c));
+        }
+        if (group.members.size() > 1) {
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::cout << "[SCHEDULER " << shard.bank->name << "] Destination group " << groupId << ": "
+                      << group.members.size() << " calls from Floor " << group.origin
+                      << " share Elevator " << shard.fleet.id(c)
+                      << " (" << countStops(unserved, group) << " stop(s))\n";
+        }
+    }
+
+    if (!shard.unservedCalls.empty()) {
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[SCHEDULER " << shard.bank->name << "] Batch dispatch: " << shard.unservedCalls.size()
+                  << " call(s) held for the next round\n";
+    }
+    shard.state = IDLE_SCHEDULER;
 }
 
-void schedulerFunction() {
-    sockfd = socket(AF_INET, SOCK_DGRAM, 0);
-    if (sockfd < 0) {
-        std::cerr << "Error creating socket\n";
+void assignElevator(SchedulerShard &shard) {
+    shard.state = ASSIGNING;
+
+    if (shard.pendingRequests.empty()) {
+        return;
+    }
+    ElevatorMessage request = shard.pendingRequests.front();
+    JournalEventType admitted = admission(shard, request);
+    if (admitted == JOURNAL_MERGED && mergeTarget(shard, request) != nullptr) {
+        // Rides with a call that is still waiting for a car.
+        record(shard, JOURNAL_MERGED, request);
+        return;
+    }
+    record(shard, admitted, request);
+    if (admitted == JOURNAL_REJECTED)
+        return;
+
+    // The first three passes are one vector pass over the fleet (see Fleet::cheapest()):
+    // an idle elevator at the pickup floor, then the nearest moving elevator heading
+    // toward it, then the nearest idle elevator, each with room for the group.
+    const Fleet &fleet = shard.fleet;
+    int best = fleet.cheapest(request.floorNumber, request.passengers, shard.eligible, shard.costs).best;
+    if (best < 0) {
+        // Finally, choose the least loaded elevator that still has room. Finding no car
+        // means the search covered the whole fleet, so the mask is complete.
+        int minLoad = std::numeric_limits<int>::max();
+        for (int car = 0; car < fleet.size(); car++) {
+            if (!shard.eligible.test(car))
+                continue;
+            int load = loadPercent(projectedPersons(fleet, car), projectedKg(fleet, car));
+            if (load < minLoad) {
+                minLoad = load;
+                best = car;
+            }
+        }
+    }
+
+    if (best < 0) {
+        record(shard, JOURNAL_ABANDONED, request);
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cerr << "[SCHEDULER " << shard.bank->name << "] ERROR: No available (non-faulted / non-full) elevator for request from "
+                  << request.floorNumber << " to " << request.destination << "!\n";
         return;
     }
 
-    struct sockaddr_in schedulerAddr, senderAddr;
-    memset(&schedulerAddr, 0, sizeof(schedulerAddr));
-    memset(&senderAddr, 0, sizeof(senderAddr));
+    dispatchToElevator(shard, request, best);
+    notifyFloor(shard, request, fleet.id(best));
+    shard.state = IDLE_SCHEDULER;
+}
+
+// Queue a request for assignment: greedily right away, or into the current batch window.
+void submitRequest(SchedulerShard &shard, const ElevatorMessage &request) {
+    record(shard, JOURNAL_SUBMITTED, request);
+    if (!BATCH_DISPATCH) {
+        assignElevator(shard);
+    } else if (!shard.batchWindowOpen) {
+        shard.batchWindowOpen = true;
+        shard.batchWindowStart = std::chrono::steady_clock::now();
+    }
+}
 
-    schedulerAddr.sin_family = AF_INET;
-    schedulerAddr.sin_addr.s_addr = INADDR_ANY;
-    schedulerAddr.sin_port = htons(SCHEDULER_PORT);
+// A car failed a trip: release it and queue the call again as a fresh request.
+// The report still carries the injected fault code, which would make the next
+// car fail the same call, so only the call itself is resubmitted.
+void reassignFaulted(SchedulerShard &shard, const ElevatorMessage &report) {
+    record(shard, JOURNAL_FAULTED, report);
+    ElevatorMessage retry = report;
+    retry.assignedElevator = -1;
+    retry.status = 0;
+    retry.msgType = 0;
+    retry.faultCode = 0;
+    retry.groupId = 0;
+    retry.groupSize = 1;
+    submitRequest(shard, retry);
+}
+
+// Pre-position idle cars at the floors where calls are expected next.
+static void parkIdleCars(SchedulerShard &shard) {
+    if (!PARKING_ENABLED)
+        return;
+    if (!shard.pendingRequests.empty() || !shard.unservedCalls.empty())
+        return;
+
+    const Fleet &fleet = shard.fleet;
+    std::vector<int> idle;
+    std::vector<int> positions;
+    for (int car = 0; car < fleet.size(); car++) {
+        if (fleet.idle.test(car) && !fleet.faulted.test(car) && !fleet.awaitingRegistration.test(car) &&
+            fleet.reservedPersons[car] == 0) {
+            idle.push_back(car);
+            positions.push_back(fleet.position[car]);
+        }
+    }
+    std::vector<int> floors = chooseParkingFloors(shard.demandModel, static_cast<int>(idle.size()), currentTime.load());
+    if (floors.empty())
+        return;
+    std::vector<int> targets = matchParkingFloors(positions, floors);
 
-    if (bind(sockfd, (struct sockaddr*)&schedulerAddr, sizeof(schedulerAddr)) < 0) {
+    for (size_t i = 0; i < idle.size(); i++) {
+        int car = idle[i];
+        int position = fleet.position[car];
+        if (targets[i] == position || targets[i] == fleet.parkingFloor[car])
+            continue;
+        ElevatorMessage park(position, targets[i], targets[i] > position, fleet.id(car), currentTime.load());
+        park.msgType = 5;
+        park.passengers = 0;
+        record(shard, JOURNAL_PARKED, park);
+        sendto(shard.sockfd, &park, sizeof(park), 0, (struct sockaddr*)&shard.addresses[car], sizeof(shard.addresses[car]));
+        traceEvent(TRACE_PARKING, fleet.id(car), position, targets[i]);
+        {
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::cout << "[SCHEDULER " << shard.bank->name << "] Parking idle Elevator " << fleet.id(car)
+                      << " at Floor " << targets[i] << " (from Floor " << position << ")\n";
+        }
+    }
+}
+
+static int bindUdp(int port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        std::cerr << "Error creating socket\n";
+        return -1;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port);
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
         std::cerr << "Bind failed\n";
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Keep a shard on one core so banks do not compete for the same CPU. Cores
+// are counted within the process's own affinity mask (see --cpu).
+static void pinToCore(std::thread &thread, int core) {
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0)
+        return;
+    int target = core % CPU_COUNT(&allowed);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed) || target-- > 0)
+            continue;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+        return;
+    }
+}
+
+// Heartbeat the standby, and send a snapshot to one that asks for it.
+static void serviceStandby(SchedulerShard &shard) {
+    if (shard.replfd < 0)
         return;
+    ReplicationHeader header;
+    header.bank = static_cast<uint32_t>(shard.bank - banks.data());
+    header.sequence = shard.replicationSequence;
+    struct sockaddr_in standby = localAddress(REPLICATION_PORT);
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - shard.lastHeartbeat >= std::chrono::milliseconds(HEARTBEAT_MS)) {
+        header.kind = REPL_HEARTBEAT;
+        sendto(shard.replfd, &header, sizeof(header), 0, (struct sockaddr*)&standby, sizeof(standby));
+        shard.lastHeartbeat = now;
     }
 
- 
+    ReplicationHeader request;
+    while (recv(shard.replfd, &request, sizeof(request), 0) == sizeof(request)) {
+        if (request.kind != REPL_SYNC_REQUEST)
+            continue;
+        std::vector<char> state = snapshotShard(shard);
+        header.kind = REPL_SNAPSHOT;
+        std::vector<char> datagram(reinterpret_cast<const char *>(&header),
+                                   reinterpret_cast<const char *>(&header) + sizeof(header));
+        datagram.insert(datagram.end(), state.begin(), state.end());
+        if (datagram.size() <= REPLICATION_MAX_BYTES)
+            sendto(shard.replfd, datagram.data(), datagram.size(), 0, (struct sockaddr*)&standby, sizeof(standby));
+    }
+}
+
+// One bank's dispatcher: owns its cars and socket, and handles only their traffic.
+static void runShard(SchedulerShard &shard, bool recover) {
+    // Wake up often enough to close batch windows and send heartbeats on time.
     struct timeval tv;
-    tv.tv_sec = 1;
-    tv.tv_usec = 0;
-    setsockopt(sockfd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
+    tv.tv_sec = 0;
+    tv.tv_usec = BATCH_DISPATCH ? BATCH_WINDOW_MS * 1000 / 2 : HEARTBEAT_MS * 1000;
+    setsockopt(shard.sockfd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
 
     {
         std::lock_guard<std::mutex> lock(printMutex);
-        std::cout << "[SCHEDULER] Listening for requests and elevator responses...\n";
+        std::cout << "[SCHEDULER " << shard.bank->name << "] Dispatching floors " << shard.bank->lowestFloor
+                  << "-" << shard.bank->highestFloor << " with Elevators " << shard.bank->firstElevator
+                  << "-" << shard.bank->firstElevator + shard.bank->numElevators - 1 << "\n";
     }
 
-    // Initialize elevator info.
-    for (int i = 0; i < MAX_ELEVATORS; i++) {
-        elevators[i].id = i;
-        elevators[i].position = MIN_FLOOR;
-        elevators[i].isMoving = false;
-        elevators[i].isIdle = true;
-        elevators[i].goingUp = true;
-        elevators[i].passengerCount = 0;
-        elevators[i].isFaulted = false;
-        elevators[i].address.sin_family = AF_INET;
-        elevators[i].address.sin_port = htons(ELEVATOR_PORT_BASE + i);
-        inet_pton(AF_INET, "127.0.0.1", &elevators[i].address.sin_addr);
+    std::string journalBase = JOURNAL_BASE + std::to_string(shard.bank - banks.data());
+    if (!shard.journal.open(journalBase, !recover)) {
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cerr << "[SCHEDULER " << shard.bank->name << "] Could not open journal " << journalBase
+                  << ".journal; running without crash recovery\n";
+    } else if (recover) {
+        recoverShard(shard);
+    } else if (tookOverFromPrimary) {
+        // State is already warm. Completions sent while no one was bound to the
+        // port are lost, so reconcile with the cars as after a recovery.
+        shard.journal.writeSnapshot(snapshotShard(shard));
+        for (int car = 0; car < shard.fleet.size(); car++)
+            shard.fleet.awaitingRegistration.set(car, true);
+        queryUnregisteredCars(shard);
     }
 
-
     ElevatorMessage request;
+    struct sockaddr_in senderAddr;
     socklen_t addrLen = sizeof(senderAddr);
 
     while (systemActive) {
+        serviceStandby(shard);
+        publishDashboard(shard);
+
+        // Close the batch window once it has been open long enough.
+        if (shard.batchWindowOpen &&
+            std::chrono::steady_clock::now() - shard.batchWindowStart >= std::chrono::milliseconds(BATCH_WINDOW_MS)) {
+            assignBatch(shard);
+        }
+
         memset(&request, 0, sizeof(request));
-        int recvResult = recvfrom(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&senderAddr, &addrLen);
+        int recvResult = recvfrom(shard.sockfd, &request, sizeof(request), 0, (struct sockaddr*)&senderAddr, &addrLen);
         if (recvResult < 0) {
             if (errno == EWOULDBLOCK || errno == EAGAIN) {
-                continue;
+                if (std::chrono::steady_clock::now() - shard.lastRegistrationQuery >=
+                    std::chrono::milliseconds(REGISTRATION_RETRY_MS))
+                    queryUnregisteredCars(shard);
+                parkIdleCars(shard);
             }
+            continue;
         }
         updateTime(request.timestamp);
 
         if (request.msgType == 0) {
-            // New request from the floor subsystem.
-            {
-                std::lock_guard<std::mutex> lock(pendingMutex);
-                pendingRequests.push(request);
-            }
-            assignElevator();
-        } else if (request.msgType == 1) {
+            // New request routed from the floor subsystem.
+            traceEvent(TRACE_REQUEST_ARRIVAL, -1, request.floorNumber, request.destination, request.passengers);
+            submitRequest(shard, request);
+            continue;
+        }
+
+        int car = findCar(shard, request.assignedElevator);
+        if (car < 0) {
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::cerr << "[SCHEDULER " << shard.bank->name << "] Ignoring message for Elevator "
+                      << request.assignedElevator << " outside this bank\n";
+            continue;
+        }
+        int eid = shard.fleet.id(car);
+
+        if (request.msgType == 1) {
             // Normal completion response.
-            {
-                std::lock_guard<std::mutex> lock(inProgressMutex);
-                for (auto it = inProgressRequests.begin(); it != inProgressRequests.end(); ++it) {
-                    if (it->msg.floorNumber == request.floorNumber &&
-                        it->msg.destination == request.destination &&
-                        it->elevatorId == request.assignedElevator) {
-                        inProgressRequests.erase(it);
-                        break;
-                    }
-                }
-            }
-            int eid = request.assignedElevator;
-            // Only update if the elevator is not marked as faulted (though faulting no longer happens automatically).
-            if (!elevators[eid].isFaulted) {
-                elevators[eid].position = request.destination;
-                if (elevators[eid].passengerCount > 0)
-                    elevators[eid].passengerCount--;
-                elevators[eid].isIdle = true;
-                elevators[eid].isMoving = false;
-            }
+            record(shard, JOURNAL_COMPLETED, request);
             {
                 std::lock_guard<std::mutex> lock(printMutex);
-                std::cout << "[SCHEDULER] Received completion response from Elevator " << eid << "\n";
+                std::cout << "[SCHEDULER " << shard.bank->name << "] Received completion response from Elevator " << eid << "\n";
             }
+            // A freed car may be the best match for calls held from earlier rounds.
+            if (BATCH_DISPATCH && !shard.unservedCalls.empty())
+                assignBatch(shard);
+            parkIdleCars(shard);
         } else if (request.msgType == 2) {
             // Fault response from an elevator (transient fault).
             {
                 std::lock_guard<std::mutex> lock(printMutex);
-                std::cout << "[SCHEDULER] Received fault report from Elevator " << request.assignedElevator
+                std::cout << "[SCHEDULER " << shard.bank->name << "] Received fault report from Elevator " << eid
                           << " for request from Floor " << request.floorNumber << " to " << request.destination << "\n";
             }
-            int eid = request.assignedElevator;
-            if (!elevators[eid].isFaulted) {
-                elevators[eid].isIdle = true;
-                elevators[eid].isMoving = false;
-            }
+            reassignFaulted(shard, request);
+        } else if (request.msgType == 3) {
+            // Intermediate update.
+            record(shard, JOURNAL_POSITION, request);
             {
-                std::lock_guard<std::mutex> lock(pendingMutex);
-                pendingRequests.push(request);
+                std::lock_guard<std::mutex> lock(printMutex);
+                std::cout << "[SCHEDULER " << shard.bank->name << "] Intermediate update: Elevator " << eid
+                          << " is now at Floor " << request.floorNumber
+                          << " (time " << request.timestamp << ")\n";
             }
+        } else if (request.msgType == 4) {
+            // Boarding update: the reserved group is now on board.
+            record(shard, JOURNAL_BOARDED, request);
             {
-                std::lock_guard<std::mutex> lock(inProgressMutex);
-                for (auto it = inProgressRequests.begin(); it != inProgressRequests.end(); ++it) {
-                    if (it->elevatorId == eid &&
-                        it->msg.floorNumber == request.floorNumber &&
-                        it->msg.destination == request.destination) {
-                        inProgressRequests.erase(it);
-                        break;
-                    }
-                }
-            }
-            assignElevator();
-        } else if (request.msgType == 3) {
-            // Intermediate update.
-            int eid = request.assignedElevator;
-            if (!elevators[eid].isFaulted) {
-                elevators[eid].position = request.floorNumber;
+                std::lock_guard<std::mutex> lock(printMutex);
+                std::cout << "[SCHEDULER " << shard.bank->name << "] Boarding update: Elevator " << eid
+                          << " picked up " << request.passengers << " at Floor " << request.floorNumber
+                          << " (load " << request.carLoad << "/" << RATED_PERSONS << ", "
+                          << request.carLoadKg << " kg)\n";
             }
+        } else if (request.msgType == 8) {
+            // Status report answering a recovery query: the car is back in service.
+            if (!shard.fleet.awaitingRegistration.test(car))
+                continue;
+            record(shard, JOURNAL_REGISTERED, request);
             {
                 std::lock_guard<std::mutex> lock(printMutex);
-                std::cout << "[SCHEDULER] Intermediate update: Elevator " << eid 
-                          << " is now at Floor " << request.floorNumber 
-                          << " (time " << request.timestamp << ")\n";
+                std::cout << "[SCHEDULER " << shard.bank->name << "] Elevator " << eid << " registered at Floor "
+                          << request.floorNumber << " (load " << request.carLoad << "/" << RATED_PERSONS << ")\n";
+            }
+            if (BATCH_DISPATCH && !shard.unservedCalls.empty())
+                assignBatch(shard);
+            parkIdleCars(shard);
+        }
+    }
+    shard.journal.close();
+}
+
+// Thin router on SCHEDULER_PORT: forwards each hall call to its bank's shard
+// and relays car assignment notices back to the floor subsystem. Elevators
+// talk to their shard directly, since they reply to whoever assigned them.
+void schedulerFunction(bool recover) {
+    int sockfd = bindUdp(SCHEDULER_PORT);
+    if (sockfd < 0)
+        return;
+
+    struct timeval tv;
+    tv.tv_sec = 1;
+    tv.tv_usec = 0;
+    setsockopt(sockfd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
+
+    std::vector<struct sockaddr_in> shardAddresses(shards.size());
+    for (size_t b = 0; b < shards.size(); b++) {
+        shards[b].sockfd = bindUdp(SCHEDULER_PORT + 1 + static_cast<int>(b));
+        if (shards[b].sockfd < 0) {
+            for (size_t i = 0; i < b; i++) close(shards[i].sockfd);
+            close(sockfd);
+            return;
+        }
+        shardAddresses[b] = localAddress(SCHEDULER_PORT + 1 + static_cast<int>(b));
+        shards[b].replfd = socket(AF_INET, SOCK_DGRAM, 0);
+        fcntl(shards[b].replfd, F_SETFL, O_NONBLOCK);
+    }
+
+    // Core 0 is left to the router; shard b runs on core b + 1.
+    std::vector<std::thread> shardThreads;
+    for (size_t b = 0; b < shards.size(); b++) {
+        shardThreads.emplace_back(runShard, std::ref(shards[b]), recover);
+        pinToCore(shardThreads.back(), static_cast<int>(b) + 1);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[SCHEDULER] Routing requests to " << shards.size() << " elevator banks...\n";
+    }
+
+    struct sockaddr_in floorAddress, senderAddr;
+    bool floorAddressKnown = false;
+    socklen_t addrLen = sizeof(senderAddr);
+    ElevatorMessage request;
+
+    while (systemActive) {
+        addrLen = sizeof(senderAddr);
+        int recvResult = recvfrom(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&senderAddr, &addrLen);
+        if (recvResult < 0)
+            continue;
+
+        if (request.msgType == 6) {
+            // Car assignment notice from a shard.
+            if (floorAddressKnown)
+                sendto(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&floorAddress, sizeof(floorAddress));
+            continue;
+        }
+
+        int bank;
+        if (request.msgType == 0) {
+            floorAddress = senderAddr;
+            floorAddressKnown = true;
+            bank = routeToBank(request);
+        } else {
+            // Stray elevator traffic: hand it to the bank that owns the car.
+            bank = 0;
+            for (size_t b = 0; b < banks.size(); b++) {
+                if (request.assignedElevator >= banks[b].firstElevator &&
+                    request.assignedElevator < banks[b].firstElevator + banks[b].numElevators)
+                    bank = static_cast<int>(b);
             }
         }
+        sendto(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&shardAddresses[bank], sizeof(shardAddresses[bank]));
+    }
+
+    for (auto &thread : shardThreads)
+        thread.join();
+    for (auto &shard : shards) {
+        close(shard.sockfd);
+        close(shard.replfd);
     }
     close(sockfd);
 }
+
+// Hot standby: keep every shard in step with the primary's replication
+// stream. Returns true once the primary has gone quiet for
+// FAILOVER_TIMEOUT_MS, after which schedulerFunction() takes over its ports.
+bool schedulerStandby() {
+    int fd = bindUdp(REPLICATION_PORT);
+    if (fd < 0)
+        return false;
+    struct timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = HEARTBEAT_MS * 1000 / 2;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
+    {
+        std::lock_guard<std::mutex> lock(printMutex);
+        std::cout << "[STANDBY] Waiting for the primary scheduler on port " << REPLICATION_PORT << "...\n";
+    }
+
+    std::vector<bool> synced(shards.size(), false);
+    std::vector<uint64_t> nextSequence(shards.size(), 0);
+    std::vector<char> buffer(REPLICATION_MAX_BYTES);
+    bool primarySeen = false;
+    auto lastHeard = std::chrono::steady_clock::now();
+
+    while (systemActive) {
+        struct sockaddr_in sender;
+        socklen_t addrLen = sizeof(sender);
+        int received = recvfrom(fd, buffer.data(), buffer.size(), 0, (struct sockaddr*)&sender, &addrLen);
+        auto now = std::chrono::steady_clock::now();
+        // The standby owns every shard until it takes over.
+        for (auto &shard : shards)
+            publishDashboard(shard);
+
+        if (received < static_cast<int>(sizeof(ReplicationHeader))) {
+            if (primarySeen && now - lastHeard >= std::chrono::milliseconds(FAILOVER_TIMEOUT_MS))
+                break;
+            continue;
+        }
+        ReplicationHeader header;
+        memcpy(&header, buffer.data(), sizeof(header));
+        if (header.bank >= shards.size())
+            continue;
+        SchedulerShard &shard = shards[header.bank];
+        primarySeen = true;
+        lastHeard = now;
+
+        if (header.kind == REPL_SNAPSHOT) {
+            std::vector<char> state(buffer.begin() + sizeof(header), buffer.begin() + received);
+            if (!synced[header.bank] && restoreShard(shard, state)) {
+                synced[header.bank] = true;
+                nextSequence[header.bank] = header.sequence + 1;
+                std::lock_guard<std::mutex> lock(printMutex);
+                std::cout << "[STANDBY] " << shard.bank->name << " in sync at record " << header.sequence << "\n";
+            }
+            continue;
+        }
+        if (header.kind == REPL_RECORD && synced[header.bank] &&
+            received == static_cast<int>(sizeof(ReplicationRecord))) {
+            ReplicationRecord rec;
+            memcpy(&rec, buffer.data(), sizeof(rec));
+            if (rec.header.sequence < nextSequence[header.bank])
+                continue;  // Already in the snapshot
+            if (rec.header.sequence == nextSequence[header.bank]) {
+                applyEvent(shard, static_cast<JournalEventType>(rec.type), rec.msg);
+                nextSequence[header.bank]++;
+                continue;
+            }
+            // A record went missing; only a fresh snapshot can fix that.
+            synced[header.bank] = false;
+        }
+        if (header.kind == REPL_HEARTBEAT && header.sequence >= nextSequence[header.bank])
+            synced[header.bank] = false;  // The last record(s) went missing
+        if (!synced[header.bank]) {
+            ReplicationHeader request;
+            request.kind = REPL_SYNC_REQUEST;
+            request.bank = header.bank;
+            request.sequence = 0;
+            sendto(fd, &request, sizeof(request), 0, (struct sockaddr*)&sender, addrLen);
+        }
+    }
+    close(fd);
+    if (!systemActive)
+        return false;
+
+    tookOverFromPrimary = true;
+    std::lock_guard<std::mutex> lock(printMutex);
+    std::cout << "[STANDBY] No heartbeat for " << FAILOVER_TIMEOUT_MS << " ms; taking over as primary\n";
+    for (size_t b = 0; b < shards.size(); b++) {
+        if (!synced[b])
+            std::cout << "[STANDBY] WARNING: " << shards[b].bank->name << " never synced and starts empty\n";
+    }
+    return true;
+}
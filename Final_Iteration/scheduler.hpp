@@ -2,14 +2,157 @@
 #define SCHEDULER_HPP
 
 #include "message.hpp"
+#include "fleet.hpp"
+#include "parking.hpp"
+#include "scheduler_journal.hpp"
 #include <vector>
 #include <queue> // Add this include for std::queue
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <netinet/in.h>
 
-
+#define SCHEDULER_PORT 8100  // Router; bank b's dispatcher shard listens on SCHEDULER_PORT + 1 + b
+#define ELEVATOR_PORT_BASE 9100
+#define MIN_FLOOR 1
+#define MAX_FLOOR 22
+#define NUM_FLOORS (MAX_FLOOR - MIN_FLOOR + 1)
 
 extern std::vector<bool> elevatorBusy; // Declare as extern
 
-void schedulerFunction();
+// A bank is a group of cars serving one zone of floors plus the lobby. A
+// sky-lobby shuttle is a bank whose zone is the single sky-lobby floor.
+struct Bank {
+    const char *name;
+    int lowestFloor;     // Zone served above the lobby
+    int highestFloor;
+    int firstElevator;   // Cars firstElevator .. firstElevator + numElevators - 1
+    int numElevators;
+};
+
+// Structure to track in-progress assignments.
+struct InProgressRequest {
+    ElevatorMessage msg;
+    int assignedTime;
+    int elevatorId;
+};
+
+// FIFO of calls in one vector. pop() advances a head index and compacts once the
+// popped prefix is half the vector, so a queue that keeps draining reuses its
+// storage instead of allocating as calls pass through.
+struct CallQueue {
+    std::vector<ElevatorMessage> calls;
+    size_t head;
+
+    CallQueue() : head(0) {}
+    bool empty() const { return head == calls.size(); }
+    size_t size() const { return calls.size() - head; }
+    const ElevatorMessage &front() const { return calls[head]; }
+    void push(const ElevatorMessage &msg) { calls.push_back(msg); }
+    void pop() {
+        if (++head * 2 >= calls.size()) {
+            calls.erase(calls.begin(), calls.begin() + head);
+            head = 0;
+        }
+    }
+};
+
+// Set of (pickup, destination) floor pairs as one flag per pair, so checking
+// and marking a call never allocates. Pairs outside the building are never in it.
+struct CallTable {
+    std::vector<uint8_t> flags;   // (floor - MIN_FLOOR) * NUM_FLOORS + destination - MIN_FLOOR
+
+    CallTable() : flags(NUM_FLOORS * NUM_FLOORS, 0) {}
+    static bool inRange(int floor) { return floor >= MIN_FLOOR && floor <= MAX_FLOOR; }
+    static bool inRange(const std::pair<int, int> &call) { return inRange(call.first) && inRange(call.second); }
+    static size_t index(const std::pair<int, int> &call) {
+        return (call.first - MIN_FLOOR) * NUM_FLOORS + call.second - MIN_FLOOR;
+    }
+
+    size_t count(const std::pair<int, int> &call) const { return inRange(call) && flags[index(call)]; }
+    void insert(const std::pair<int, int> &call) { if (inRange(call)) flags[index(call)] = 1; }
+    void erase(const std::pair<int, int> &call) { if (inRange(call)) flags[index(call)] = 0; }
+    void clear() { std::fill(flags.begin(), flags.end(), 0); }
+
+    std::vector<std::pair<int, int>> pairs() const {
+        std::vector<std::pair<int, int>> result;
+        for (size_t i = 0; i < flags.size(); i++) {
+            if (flags[i])
+                result.push_back(std::make_pair(MIN_FLOOR + static_cast<int>(i / NUM_FLOORS),
+                                                MIN_FLOOR + static_cast<int>(i % NUM_FLOORS)));
+        }
+        return result;
+    }
+};
+
+// Everything one bank's dispatcher needs. Each shard is owned by its own
+// thread, so nothing here is shared with other banks on the hot path.
+struct SchedulerShard {
+    const Bank *bank;
+    int sockfd;
+    SchedulerState state;
+    Fleet fleet;                                // Car state, one array per field (see fleet.hpp)
+    std::vector<struct sockaddr_in> addresses;  // Where to send each car its trips
+    CallQueue pendingRequests;
+    CallTable processedRequests;
+    std::vector<InProgressRequest> inProgressRequests;
+
+    // Hall-call demand learned from completed requests, used to park idle cars.
+    DemandModel demandModel;
+
+    // Batch dispatch: accepted calls not yet given to a car, and when the current window opened.
+    std::vector<ElevatorMessage> unservedCalls;
+    std::chrono::steady_clock::time_point batchWindowStart;
+    bool batchWindowOpen;
+    int nextGroupId;
+
+    // Car assignment notices go back through the router, which knows the floor's address.
+    struct sockaddr_in routerAddress;
+
+    // Every state change is recorded here before it is applied (see record()).
+    SchedulerJournal journal;
+    std::chrono::steady_clock::time_point lastRegistrationQuery;
+
+    // Hot standby: every record is also streamed to REPLICATION_PORT from replfd.
+    int replfd;
+    uint64_t replicationSequence;
+    std::chrono::steady_clock::time_point lastHeartbeat;
+    std::chrono::steady_clock::time_point lastDashboardPublish;
+
+    // Scratch for assignElevator() and assignBatch(), kept to avoid allocating per call.
+    FleetMask eligible;
+    std::vector<int16_t> costs;
+    std::vector<int> etas;
+
+    explicit SchedulerShard(const Bank &b);
+};
+
+extern std::vector<Bank> banks;
+
+// Replace the bank layout with count equal zones above the lobby, carsPerBank
+// cars each (elevator ids from 0), and rebuild the shards. Only before any
+// scheduler or dashboard thread starts; load_generator uses it to vary the bank count.
+void splitIntoBanks(int count, int carsPerBank);
+
+// With recover set, rebuild each bank from its journal instead of starting empty.
+void schedulerFunction(bool recover = false);
 void displayDashboard();
 
-#endif // SCHEDULER_HPP
\ No newline at end of file
+// Run as a hot standby until the primary scheduler stops heartbeating.
+// Returns true if this process should now call schedulerFunction() to take over.
+bool schedulerStandby();
+
+// One shard's dispatch steps, for tests and benchmarks. A shard without a
+// socket records every decision but sends nothing.
+bool canServe(const Fleet &fleet, int car, const ElevatorMessage &request);
+int estimateEta(const Fleet &fleet, int car, const ElevatorMessage &request);
+bool isAcceptable(SchedulerShard &shard, const ElevatorMessage &request);
+void submitRequest(SchedulerShard &shard, const ElevatorMessage &request);
+void assignElevator(SchedulerShard &shard);
+void assignBatch(SchedulerShard &shard);
+void reassignFaulted(SchedulerShard &shard, const ElevatorMessage &report);
+std::vector<char> snapshotShard(const SchedulerShard &shard);
+bool restoreShard(SchedulerShard &shard, const std::vector<char> &state);
+
+#endif // SCHEDULER_HPP
@@ -0,0 +1,129 @@
+/* scheduler_journal.cpp */
+#include "scheduler_journal.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+
+struct SnapshotHeader {
+    char magic[8];
+    uint64_t sequence;    // Last journal record the snapshot covers
+    uint64_t size;        // Bytes of state that follow
+};
+
+SchedulerJournal::SchedulerJournal() : fd_(-1), nextSequence_(1), sinceSnapshot_(0) {}
+
+SchedulerJournal::SchedulerJournal(SchedulerJournal &&other) noexcept
+    : fd_(other.fd_), basePath_(std::move(other.basePath_)),
+      nextSequence_(other.nextSequence_), sinceSnapshot_(other.sinceSnapshot_) {
+    other.fd_ = -1;
+}
+
+SchedulerJournal::~SchedulerJournal() {
+    close();
+}
+
+static bool readSnapshot(const std::string &path, SnapshotHeader &header, std::vector<char> &state) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0;
+    if (ok) {
+        state.resize(header.size);
+        ok = header.size == 0 || fread(state.data(), 1, header.size, file) == header.size;
+    }
+    fclose(file);
+    return ok;
+}
+
+bool SchedulerJournal::open(const std::string &basePath, bool fresh) {
+    close();
+    basePath_ = basePath;
+    std::string journalPath = basePath + ".journal";
+    if (fresh) {
+        remove((basePath + ".snapshot").c_str());
+        remove(journalPath.c_str());
+    }
+    fd_ = ::open(journalPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd_ < 0) return false;
+
+    // Continue numbering after whatever is already recorded.
+    nextSequence_ = 1;
+    sinceSnapshot_ = 0;
+    std::vector<char> state;
+    std::vector<JournalRecord> records;
+    if (!fresh && recover(state, records)) {
+        SnapshotHeader header;
+        if (readSnapshot(basePath + ".snapshot", header, state))
+            nextSequence_ = header.sequence + 1;
+        if (!records.empty())
+            nextSequence_ = records.back().sequence + 1;
+        sinceSnapshot_ = static_cast<int>(records.size());
+    }
+    return true;
+}
+
+void SchedulerJournal::append(JournalEventType type, const ElevatorMessage &msg) {
+    if (fd_ < 0) return;
+    JournalRecord record = JournalRecord();
+    record.sequence = nextSequence_++;
+    record.type = type;
+    record.msg = msg;
+    // One write per record: O_APPEND keeps it whole at the end of the file.
+    if (write(fd_, &record, sizeof(record)) == sizeof(record))
+        sinceSnapshot_++;
+}
+
+bool SchedulerJournal::writeSnapshot(const std::vector<char> &state) {
+    if (fd_ < 0) return false;
+    std::string snapshotPath = basePath_ + ".snapshot";
+    std::string tempPath = snapshotPath + ".tmp";
+
+    FILE *file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) return false;
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.sequence = nextSequence_ - 1;
+    header.size = state.size();
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (state.empty() || fwrite(state.data(), 1, state.size(), file) == state.size());
+    ok = (fclose(file) == 0) && ok;
+    if (!ok || rename(tempPath.c_str(), snapshotPath.c_str()) != 0) {
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    // Records up to header.sequence are in the snapshot now.
+    if (ftruncate(fd_, 0) != 0) return false;
+    sinceSnapshot_ = 0;
+    return true;
+}
+
+bool SchedulerJournal::recover(std::vector<char> &state, std::vector<JournalRecord> &records) {
+    state.clear();
+    records.clear();
+    SnapshotHeader header;
+    uint64_t covered = 0;
+    if (readSnapshot(basePath_ + ".snapshot", header, state))
+        covered = header.sequence;
+    else
+        state.clear();
+
+    FILE *file = fopen((basePath_ + ".journal").c_str(), "rb");
+    if (file == nullptr) return true;
+    JournalRecord record;
+    while (fread(&record, sizeof(record), 1, file) == 1) {
+        if (record.sequence > covered)
+            records.push_back(record);
+    }
+    fclose(file);
+    return true;
+}
+
+void SchedulerJournal::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef SCHEDULER_JOURNAL_HPP
+#define SCHEDULER_JOURNAL_HPP
+
+#include "message.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define JOURNAL_SNAPSHOT_EVERY 1000   // Records between compact snapshots
+#define SNAPSHOT_MAGIC "ELVSNAP2"   // 2: fleet stored array by array (fleet.hpp)
+
+// Scheduler state changes, replayed in order to rebuild a shard after a crash.
+enum JournalEventType {
+    JOURNAL_SUBMITTED,    // Call queued for assignment
+    JOURNAL_ACCEPTED,     // Front queued call passed the duplicate check
+    JOURNAL_REJECTED,     // Front queued call was invalid
+    JOURNAL_ABANDONED,    // Accepted call dropped because no car could take it
+    JOURNAL_ASSIGNED,     // Accepted call given to msg.assignedElevator
+    JOURNAL_POSITION,     // Intermediate floor update (msgType 3)
+    JOURNAL_BOARDED,      // msgType 4
+    JOURNAL_COMPLETED,    // msgType 1
+    JOURNAL_FAULTED,      // msgType 2; the call is then SUBMITTED again
+    JOURNAL_PARKED,       // Idle car sent to park at msg.destination
+    JOURNAL_REGISTERED,   // Car reported its state after a scheduler restart (msgType 8)
+    JOURNAL_MERGED        // Front queued call repeats an accepted one; its passengers are carried too
+};
+
+struct JournalRecord {
+    uint64_t sequence;
+    uint32_t type;        // JournalEventType
+    uint32_t reserved;
+    ElevatorMessage msg;
+};
+
+// Append-only journal with periodic snapshots, kept in <base>.journal and
+// <base>.snapshot. Records are written straight to the file, so they
+// survive the process dying; they are not synced to disk.
+//
+// Every record carries a sequence number and each snapshot stores the last
+// one it covers, so records already in the snapshot are skipped on recovery
+// even if the process died before the journal was truncated.
+class SchedulerJournal {
+public:
+    SchedulerJournal();
+    SchedulerJournal(SchedulerJournal &&other) noexcept;
+    ~SchedulerJournal();
+
+    // One owner per file descriptor.
+    SchedulerJournal(const SchedulerJournal &) = delete;
+    SchedulerJournal &operator=(const SchedulerJournal &) = delete;
+
+    // Open the journal. With fresh set, any previous journal and snapshot are discarded.
+    bool open(const std::string &basePath, bool fresh);
+
+    bool isOpen() const { return fd_ >= 0; }
+
+    void append(JournalEventType type, const ElevatorMessage &msg);
+
+    // True once JOURNAL_SNAPSHOT_EVERY records have been appended since the last snapshot.
+    bool snapshotDue() const { return sinceSnapshot_ >= JOURNAL_SNAPSHOT_EVERY; }
+
+    // Replace the snapshot with state (atomically) and start an empty journal.
+    bool writeSnapshot(const std::vector<char> &state);
+
+    // Load the last snapshot (empty if none) and the journal records after it.
+    // A torn final record is ignored.
+    bool recover(std::vector<char> &state, std::vector<JournalRecord> &records);
+
+    void close();
+
+private:
+    int fd_;
+    std::string basePath_;
+    uint64_t nextSequence_;
+    int sinceSnapshot_;
+};
+
+#endif // SCHEDULER_JOURNAL_HPP
@@ -0,0 +1,155 @@
+// scheduler_journal_simple_test.cpp
+#include <iostream>
+#include <cstdio>
+#include <vector>
+#include "scheduler_journal.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+#define TEST_BASE "scheduler_journal_test"
+
+static ElevatorMessage makeCall(int floor, int destination) {
+    return ElevatorMessage(floor, destination, destination > floor, -1, 0);
+}
+
+static void removeFiles() {
+    remove(TEST_BASE ".journal");
+    remove(TEST_BASE ".snapshot");
+}
+
+// Test that records come back in the order they were appended
+int testAppendRecover() {
+    std::cout << "\n=== Testing Append and Recover ===" << std::endl;
+    removeFiles();
+    {
+        SchedulerJournal journal;
+        TEST_ASSERT(journal.open(TEST_BASE, true), "Journal should open");
+        journal.append(JOURNAL_SUBMITTED, makeCall(3, 9));
+        journal.append(JOURNAL_ACCEPTED, makeCall(3, 9));
+        ElevatorMessage assigned = makeCall(3, 9);
+        assigned.assignedElevator = 1;
+        journal.append(JOURNAL_ASSIGNED, assigned);
+    }
+
+    std::cout << "  Test Case 1: Records survive reopening" << std::endl;
+    SchedulerJournal journal;
+    TEST_ASSERT(journal.open(TEST_BASE, false), "Journal should reopen");
+    std::vector<char> state;
+    std::vector<JournalRecord> records;
+    TEST_ASSERT(journal.recover(state, records), "Recovery should succeed");
+    TEST_ASSERT(state.empty(), "No snapshot has been written yet");
+    TEST_ASSERT(records.size() == 3, "All three records should be read back");
+    TEST_ASSERT(records[0].type == JOURNAL_SUBMITTED && records[2].type == JOURNAL_ASSIGNED, "Records should keep their order");
+    TEST_ASSERT(records[2].msg.assignedElevator == 1 && records[2].msg.destination == 9, "Messages should be intact");
+
+    std::cout << "  Test Case 2: Numbering continues after reopening" << std::endl;
+    journal.append(JOURNAL_COMPLETED, makeCall(3, 9));
+    journal.recover(state, records);
+    TEST_ASSERT(records.size() == 4 && records[3].sequence == records[2].sequence + 1, "New record should follow the old ones");
+
+    std::cout << "Append and Recover: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test that a snapshot replaces the records it covers
+int testSnapshot() {
+    std::cout << "\n=== Testing Snapshots ===" << std::endl;
+    removeFiles();
+    SchedulerJournal journal;
+    TEST_ASSERT(journal.open(TEST_BASE, true), "Journal should open");
+    for (int i = 0; i < JOURNAL_SNAPSHOT_EVERY; i++)
+        journal.append(JOURNAL_POSITION, makeCall(2 + i % 10, 2 + i % 10));
+    TEST_ASSERT(journal.snapshotDue(), "Snapshot should be due after JOURNAL_SNAPSHOT_EVERY records");
+
+    std::cout << "  Test Case 1: Snapshot state is returned and old records skipped" << std::endl;
+    std::vector<char> saved(100, 'x');
+    TEST_ASSERT(journal.writeSnapshot(saved), "Snapshot should be written");
+    TEST_ASSERT(!journal.snapshotDue(), "Snapshot should no longer be due");
+    journal.append(JOURNAL_PARKED, makeCall(1, 6));
+    std::vector<char> state;
+    std::vector<JournalRecord> records;
+    journal.recover(state, records);
+    TEST_ASSERT(state == saved, "Snapshot state should be read back");
+    TEST_ASSERT(records.size() == 1 && records[0].type == JOURNAL_PARKED, "Only the record after the snapshot should replay");
+
+    std::cout << "  Test Case 2: Covered records are skipped if the journal was not truncated" << std::endl;
+    journal.close();
+    FILE *file = fopen(TEST_BASE ".journal", "ab");
+    JournalRecord stale;
+    stale.sequence = 5;
+    stale.type = JOURNAL_SUBMITTED;
+    stale.reserved = 0;
+    stale.msg = makeCall(4, 8);
+    fwrite(&stale, sizeof(stale), 1, file);
+    fclose(file);
+    TEST_ASSERT(journal.open(TEST_BASE, false), "Journal should reopen");
+    journal.recover(state, records);
+    TEST_ASSERT(records.size() == 1 && records[0].type == JOURNAL_PARKED, "Record 5 is in the snapshot and should be skipped");
+
+    std::cout << "Snapshots: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test fresh starts and crashes in the middle of a write
+int testFreshAndTornTail() {
+    std::cout << "\n=== Testing Fresh Start and Torn Writes ===" << std::endl;
+    removeFiles();
+    SchedulerJournal journal;
+    journal.open(TEST_BASE, true);
+    journal.append(JOURNAL_SUBMITTED, makeCall(5, 12));
+    journal.append(JOURNAL_ACCEPTED, makeCall(5, 12));
+    journal.close();
+
+    std::cout << "  Test Case 1: A torn final record is ignored" << std::endl;
+    FILE *file = fopen(TEST_BASE ".journal", "ab");
+    char partial[10] = {0};
+    fwrite(partial, sizeof(partial), 1, file);
+    fclose(file);
+    std::vector<char> state;
+    std::vector<JournalRecord> records;
+    TEST_ASSERT(journal.open(TEST_BASE, false), "Journal should reopen");
+    journal.recover(state, records);
+    TEST_ASSERT(records.size() == 2, "Both whole records should be recovered");
+
+    std::cout << "  Test Case 2: A fresh open discards the old run" << std::endl;
+    journal.writeSnapshot(std::vector<char>(8, 'y'));
+    journal.append(JOURNAL_REJECTED, makeCall(5, 12));
+    TEST_ASSERT(journal.open(TEST_BASE, true), "Journal should open fresh");
+    journal.recover(state, records);
+    TEST_ASSERT(state.empty() && records.empty(), "Nothing should be recovered after a fresh open");
+
+    std::cout << "Fresh Start and Torn Writes: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING SCHEDULER JOURNAL TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testAppendRecover();
+    failures += testSnapshot();
+    failures += testFreshAndTornTail();
+    removeFiles();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " SCHEDULER JOURNAL TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " SCHEDULER JOURNAL TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
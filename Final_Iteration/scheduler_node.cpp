@@ -0,0 +1,51 @@
+// scheduler_node.cpp
+// Runs the scheduler as its own process, either as the primary or as a hot
+// standby that mirrors the primary's state and takes over its ports when the
+// primary stops heartbeating.
+//
+// Usage: ./scheduler_node [--standby] [--recover] [--cpu LIST] [--nice N] [--rt-priority N]
+//
+// Local failover drill (three terminals):
+//   ./scheduler_node
+//   ./scheduler_node --standby
+//   ./elevator_sim --external-scheduler
+// then kill -9 the primary; the standby takes over in under a second.
+// floor_node and elevator_node can stand in for elevator_sim.
+#include <iostream>
+#include <thread>
+#include <cstring>
+#include "scheduler.hpp"
+#include "time_manager.hpp"
+#include "process_options.hpp"
+
+bool systemActive = true;
+
+int main(int argc, char *argv[]) {
+    bool standby = false;
+    bool recover = false;
+    ProcessOptions options;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--standby") == 0) standby = true;
+        else if (strcmp(argv[i], "--recover") == 0) recover = true;
+        else if (!parseProcessOption(argc, argv, i, options)) {
+            std::cerr << "Usage: " << argv[0] << " [--standby] [--recover] " PROCESS_OPTIONS_USAGE "\n";
+            return 1;
+        }
+    }
+    applyProcessOptions(options, "SCHEDULER");
+
+    std::thread schedulerThread([standby, recover]() {
+        if (standby && !schedulerStandby())
+            return;
+        schedulerFunction(recover);
+    });
+    std::thread dashboardThread(displayDashboard);
+
+    std::cout << "Press Enter to stop the scheduler..." << std::endl;
+    std::cin.get();
+    systemActive = false;
+
+    schedulerThread.join();
+    dashboardThread.join();
+    return 0;
+}
@@ -0,0 +1,215 @@
+// scheduler_simple_test.cpp
+// Drives a dispatcher shard through the API in scheduler.hpp. The shard has
+// no socket, so assignments and floor notices are recorded but never sent.
+#include "scheduler.hpp"
+#include "load_model.hpp"
+#include <iostream>
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+bool systemActive = true;
+
+static int totalQueuedTrips(const Fleet &fleet) {
+    int trips = 0;
+    for (int car = 0; car < fleet.size(); car++)
+        trips += fleet.queuedTrips[car];
+    return trips;
+}
+
+static int totalReservedPersons(const Fleet &fleet) {
+    int persons = 0;
+    for (int car = 0; car < fleet.size(); car++)
+        persons += fleet.reservedPersons[car];
+    return persons;
+}
+
+static ElevatorMessage makeCall(int floor, int destination, int passengers) {
+    ElevatorMessage call(floor, destination, destination > floor, -1, 0);
+    call.passengers = passengers;
+    return call;
+}
+
+// Test that a call failed by a car goes to a car again, once, without its fault
+int testFaultReassignment() {
+    std::cout << "\n=== Testing Fault Reassignment ===" << std::endl;
+    SchedulerShard shard(banks[0]);
+
+    std::cout << "  Test Case 1: Call with an injected door fault is assigned" << std::endl;
+    ElevatorMessage call(3, 8, true, -1, 0);
+    call.faultCode = 1;  // Door fault
+    submitRequest(shard, call);
+    assignBatch(shard);
+    TEST_ASSERT(shard.inProgressRequests.size() == 1, "Call should be assigned to one car");
+    TEST_ASSERT(shard.inProgressRequests[0].msg.faultCode == 1, "First car should receive the fault to inject");
+
+    std::cout << "  Test Case 2: Fault report releases the car and reassigns the call once" << std::endl;
+    ElevatorMessage report = shard.inProgressRequests[0].msg;
+    report.msgType = 2;
+    report.status = -1;
+    reassignFaulted(shard, report);
+    assignBatch(shard);
+    TEST_ASSERT(shard.inProgressRequests.size() == 1 && shard.unservedCalls.empty(),
+                "Call should be in progress on exactly one car");
+    TEST_ASSERT(totalQueuedTrips(shard.fleet) == 1, "Fleet should hold exactly one trip");
+    const ElevatorMessage &retry = shard.inProgressRequests[0].msg;
+    TEST_ASSERT(retry.faultCode == 0 && retry.status == 0 && retry.msgType == 0,
+                "Reassigned call should carry no fault, so the next car serves it");
+    TEST_ASSERT(!shard.fleet.faulted.test(0) && !shard.fleet.faulted.test(1), "A transient fault marks no car faulted");
+
+    std::cout << "Fault Reassignment: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test that a repeated hall call adds its passengers instead of being dropped
+int testRepeatedCalls() {
+    std::cout << "\n=== Testing Repeated Calls ===" << std::endl;
+
+    std::cout << "  Test Case 1: Repeat while the call waits joins the same group" << std::endl;
+    SchedulerShard waiting(banks[0]);
+    submitRequest(waiting, makeCall(3, 8, 2));
+    submitRequest(waiting, makeCall(3, 8, 3));
+    assignBatch(waiting);
+    TEST_ASSERT(waiting.inProgressRequests.size() == 1 && waiting.inProgressRequests[0].msg.passengers == 5,
+                "One trip should carry both groups");
+    TEST_ASSERT(totalReservedPersons(waiting.fleet) == 5, "All five passengers should be reserved");
+
+    std::cout << "  Test Case 2: Repeat after the call went to a car is carried as its own group" << std::endl;
+    SchedulerShard assigned(banks[0]);
+    submitRequest(assigned, makeCall(3, 8, 2));
+    assignBatch(assigned);
+    submitRequest(assigned, makeCall(3, 8, 4));
+    assignBatch(assigned);
+    TEST_ASSERT(assigned.unservedCalls.empty() && assigned.inProgressRequests.size() == 2,
+                "Both groups should be with a car");
+    TEST_ASSERT(totalReservedPersons(assigned.fleet) == 6 && totalQueuedTrips(assigned.fleet) == 2,
+                "Fleet should reserve both groups");
+
+    std::cout << "  Test Case 3: A merge never makes a group larger than a car" << std::endl;
+    SchedulerShard full(banks[0]);
+    submitRequest(full, makeCall(3, 8, RATED_PERSONS - 1));
+    submitRequest(full, makeCall(3, 8, 2));
+    assignBatch(full);
+    TEST_ASSERT(full.inProgressRequests.size() == 2 && totalReservedPersons(full.fleet) == RATED_PERSONS + 1,
+                "Overflow should go as a second group");
+
+    std::cout << "Repeated Calls: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test that the batch dispatcher's vector ETAs match estimateEta() car by car
+int testFleetEtas() {
+    std::cout << "\n=== Testing Fleet ETAs ===" << std::endl;
+
+    std::cout << "  Test Case 1: Random fleets agree with estimateEta() for every car" << std::endl;
+    bool agrees = true;
+    unsigned seed = 4242;
+    FleetMask eligible;
+    std::vector<int> etas;
+    for (int trial = 0; trial < 100 && agrees; trial++) {
+        seed = seed * 1103515245 + 12345;
+        Fleet fleet(0, 1 + (seed >> 16) % 200, MIN_FLOOR);
+        for (int car = 0; car < fleet.size(); car++) {
+            seed = seed * 1103515245 + 12345;
+            unsigned r = seed >> 8;
+            fleet.faulted.set(car, (r & 0xf) == 0);
+            fleet.position[car] = MIN_FLOOR + (r >> 4) % NUM_FLOORS;
+            fleet.tripEndFloor[car] = MIN_FLOOR + (r >> 9) % NUM_FLOORS;
+            fleet.queuedTrips[car] = (r >> 14) % 4;
+            fleet.reservedPersons[car] = (r >> 16) % (RATED_PERSONS + 1);
+        }
+        ElevatorMessage call = makeCall(MIN_FLOOR + (seed >> 20) % NUM_FLOORS, MIN_FLOOR, 1 + (seed >> 12) % 4);
+        fleet.eligible(call.passengers, eligible);
+        fleet.etas(call.floorNumber, eligible, etas);
+        for (int car = 0; car < fleet.size(); car++) {
+            if (etas[car] != estimateEta(fleet, car, call))
+                agrees = false;
+        }
+    }
+    TEST_ASSERT(agrees, "Vector and per-car ETAs should be identical");
+
+    std::cout << "Fleet ETAs: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test that calls naming a floor outside the building never reach a car
+int testOutOfRangeCalls() {
+    std::cout << "\n=== Testing Out-of-Range Calls ===" << std::endl;
+    SchedulerShard shard(banks[0]);
+
+    std::cout << "  Test Case 1: Pickup or destination outside MIN_FLOOR..MAX_FLOOR is rejected" << std::endl;
+    TEST_ASSERT(!isAcceptable(shard, ElevatorMessage(3, MIN_FLOOR - 1, false, -1, 0)), "Destination below the lobby");
+    TEST_ASSERT(!isAcceptable(shard, ElevatorMessage(3, MAX_FLOOR + 1, true, -1, 0)), "Destination above the top floor");
+    TEST_ASSERT(!isAcceptable(shard, ElevatorMessage(MAX_FLOOR + 5, 3, false, -1, 0)), "Pickup above the top floor");
+    TEST_ASSERT(!isAcceptable(shard, ElevatorMessage(-2, 3, true, -1, 0)), "Negative pickup floor");
+    TEST_ASSERT(isAcceptable(shard, ElevatorMessage(MIN_FLOOR, MAX_FLOOR, true, -1, 0)),
+                "Lobby to top floor is in range");
+
+    std::cout << "  Test Case 2: Rejected calls are dropped, valid ones still assigned" << std::endl;
+    submitRequest(shard, ElevatorMessage(3, MAX_FLOOR + 1, true, -1, 0));
+    submitRequest(shard, ElevatorMessage(4, 9, true, -1, 0));
+    assignBatch(shard);
+    TEST_ASSERT(shard.pendingRequests.empty() && shard.unservedCalls.empty(), "No call should be left waiting");
+    TEST_ASSERT(shard.inProgressRequests.size() == 1 && shard.inProgressRequests[0].msg.destination == 9,
+                "Only the valid call should be assigned");
+
+    std::cout << "Out-of-Range Calls: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test that a snapshot restores the calls the duplicate check is holding
+int testSnapshotRoundTrip() {
+    std::cout << "\n=== Testing Shard Snapshot ===" << std::endl;
+    SchedulerShard shard(banks[0]);
+    submitRequest(shard, ElevatorMessage(3, 8, true, -1, 0));
+    submitRequest(shard, ElevatorMessage(9, 2, false, -1, 0));
+    assignBatch(shard);
+
+    std::cout << "  Test Case 1: Processed pairs survive a snapshot" << std::endl;
+    SchedulerShard restored(banks[0]);
+    TEST_ASSERT(restoreShard(restored, snapshotShard(shard)), "Snapshot should restore into the same bank");
+    TEST_ASSERT(restored.processedRequests.pairs() == shard.processedRequests.pairs() &&
+                restored.processedRequests.count(std::make_pair(9, 2)) == 1,
+                "Restored shard should hold the same processed calls");
+    TEST_ASSERT(restored.inProgressRequests.size() == 2, "Both assignments should be restored");
+
+    std::cout << "  Test Case 2: Truncated snapshot is rejected" << std::endl;
+    std::vector<char> state = snapshotShard(shard);
+    state.resize(state.size() - 6);
+    TEST_ASSERT(!restoreShard(restored, state), "A snapshot cut short should not restore");
+
+    std::cout << "Shard Snapshot: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING SCHEDULER TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testFaultReassignment();
+    failures += testSnapshotRoundTrip();
+    failures += testOutOfRangeCalls();
+    failures += testRepeatedCalls();
+    failures += testFleetEtas();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " SCHEDULER TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " SCHEDULER TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
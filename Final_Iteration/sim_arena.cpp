@@ -0,0 +1,47 @@
+/* sim_arena.cpp */
+#include "sim_arena.hpp"
+#include <cstdint>
+
+SimArena::SimArena(size_t blockBytes) : blockBytes_(blockBytes), current_(0), offset_(0), used_(0) {}
+
+SimArena::~SimArena() {
+    reset();
+    for (char *block : blocks_)
+        ::operator delete(block);
+}
+
+void *SimArena::allocate(size_t bytes, size_t align) {
+    used_ += bytes;
+    if (bytes + align > blockBytes_) {
+        // operator new already aligns for any fundamental type.
+        large_.push_back(static_cast<char *>(::operator new(bytes)));
+        return large_.back();
+    }
+    for (;;) {
+        if (current_ < blocks_.size()) {
+            uintptr_t base = reinterpret_cast<uintptr_t>(blocks_[current_]);
+            size_t start = ((base + offset_ + align - 1) & ~(uintptr_t(align) - 1)) - base;
+            if (start + bytes <= blockBytes_) {
+                offset_ = start + bytes;
+                return blocks_[current_] + start;
+            }
+            if (current_ + 1 < blocks_.size()) {
+                current_++;
+                offset_ = 0;
+                continue;
+            }
+        }
+        blocks_.push_back(static_cast<char *>(::operator new(blockBytes_)));
+        current_ = blocks_.size() - 1;
+        offset_ = 0;
+    }
+}
+
+void SimArena::reset() {
+    for (char *block : large_)
+        ::operator delete(block);
+    large_.clear();
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
@@ -0,0 +1,108 @@
+#ifndef SIM_ARENA_HPP
+#define SIM_ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define ARENA_BLOCK_BYTES (64 * 1024)   // Blocks are carved up in order; larger requests get their own
+
+// Memory for one simulation run. Allocation bumps a pointer through the current
+// block; nothing is freed on its own. reset() drops everything at once between
+// replications and keeps the blocks, so later runs of the same size never call
+// the system allocator.
+class SimArena {
+public:
+    explicit SimArena(size_t blockBytes = ARENA_BLOCK_BYTES);
+    ~SimArena();
+
+    SimArena(const SimArena &) = delete;
+    SimArena &operator=(const SimArena &) = delete;
+
+    void *allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+
+    // Everything allocated so far is gone; objects in it are not destroyed.
+    void reset();
+
+    size_t bytesUsed() const { return used_; }
+    size_t blocksReserved() const { return blocks_.size(); }
+
+private:
+    size_t blockBytes_;
+    std::vector<char *> blocks_;   // Kept across reset()
+    std::vector<char *> large_;    // Oversized requests, released by reset()
+    size_t current_;               // Index into blocks_
+    size_t offset_;                // Next free byte in blocks_[current_]
+    size_t used_;
+};
+
+// Fixed-size slots for T from an arena. destroy() puts a slot on a free list for
+// the next create(), so steady churn reuses the same memory; reset() forgets
+// every object at once and must go with a reset() of the arena.
+template <typename T>
+class ObjectPool {
+    static_assert(std::is_trivially_destructible<T>::value, "reset() drops objects without destroying them");
+
+public:
+    explicit ObjectPool(SimArena &arena) : arena_(arena), free_(nullptr), live_(0) {}
+
+    template <typename... Args>
+    T *create(Args &&... args) {
+        void *slot = free_;
+        if (slot != nullptr)
+            free_ = free_->next;
+        else
+            slot = arena_.allocate(sizeof(Slot), alignof(Slot));
+        live_++;
+        return new (slot) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T *object) {
+        Slot *slot = reinterpret_cast<Slot *>(object);
+        slot->next = free_;
+        free_ = slot;
+        live_--;
+    }
+
+    void reset() {
+        free_ = nullptr;
+        live_ = 0;
+    }
+
+    size_t live() const { return live_; }
+
+private:
+    union Slot {
+        Slot *next;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    SimArena &arena_;
+    Slot *free_;
+    size_t live_;
+};
+
+// Standard-library allocator over an arena, for containers that live no longer
+// than one run. Deallocation does nothing; the memory comes back at reset().
+template <typename T>
+struct ArenaAllocator {
+    typedef T value_type;
+
+    SimArena *arena;
+
+    explicit ArenaAllocator(SimArena &a) : arena(&a) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *, size_t) {}
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) { return a.arena == b.arena; }
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) { return a.arena != b.arena; }
+
+#endif // SIM_ARENA_HPP
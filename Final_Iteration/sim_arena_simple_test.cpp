@@ -0,0 +1,113 @@
+// sim_arena_simple_test.cpp
+#include <iostream>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "sim_arena.hpp"
+
+// Test assertion macro with detailed output
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << " FAILED: " << message << std::endl; \
+            return 1; \
+        } else { \
+            std::cout << "✓ PASSED: " << message << std::endl; \
+        } \
+    } while (0)
+
+struct Node {
+    int floor;
+    Node *next;
+};
+
+// Test bump allocation and bulk reset
+int testArena() {
+    std::cout << "\n=== Testing Simulation Arena ===" << std::endl;
+
+    std::cout << "  Test Case 1: Allocations are aligned and do not overlap" << std::endl;
+    SimArena arena(1024);
+    char *a = static_cast<char *>(arena.allocate(3, 1));
+    double *b = static_cast<double *>(arena.allocate(sizeof(double), alignof(double)));
+    char *c = static_cast<char *>(arena.allocate(100, 64));
+    TEST_ASSERT(reinterpret_cast<uintptr_t>(b) % alignof(double) == 0 &&
+                reinterpret_cast<uintptr_t>(c) % 64 == 0, "Each allocation should honour its alignment");
+    TEST_ASSERT(reinterpret_cast<char *>(b) >= a + 3 && c >= reinterpret_cast<char *>(b + 1),
+                "Allocations should follow one another");
+
+    std::cout << "  Test Case 2: Full blocks spill into new ones; oversized requests get their own" << std::endl;
+    for (int i = 0; i < 20; i++) arena.allocate(100);
+    TEST_ASSERT(arena.blocksReserved() >= 3, "2 KB of small allocations should need at least three 1 KB blocks");
+    size_t blocks = arena.blocksReserved();
+    void *big = arena.allocate(4096);
+    TEST_ASSERT(big != nullptr && arena.blocksReserved() == blocks, "A 4 KB request should not take a block");
+
+    std::cout << "  Test Case 3: reset() reuses the same blocks" << std::endl;
+    arena.reset();
+    char *again = static_cast<char *>(arena.allocate(3, 1));
+    TEST_ASSERT(again == a && arena.bytesUsed() == 3, "First allocation after reset should reuse the first block");
+    for (int i = 0; i < 20; i++) arena.allocate(100);
+    TEST_ASSERT(arena.blocksReserved() == blocks, "A run of the same size should need no new blocks");
+
+    std::cout << "Simulation Arena: All tests passed" << std::endl;
+    return 0;
+}
+
+// Test the fixed-size pool and the container allocator
+int testPool() {
+    std::cout << "\n=== Testing Object Pool ===" << std::endl;
+
+    std::cout << "  Test Case 1: Destroyed slots are reused" << std::endl;
+    SimArena arena;
+    ObjectPool<Node> pool(arena);
+    Node *first = pool.create();
+    Node *second = pool.create();
+    first->floor = 7;
+    TEST_ASSERT(first != second && pool.live() == 2, "Two live nodes in distinct slots");
+    pool.destroy(first);
+    size_t used = arena.bytesUsed();
+    Node *third = pool.create();
+    TEST_ASSERT(third == first && arena.bytesUsed() == used, "Next create should take the freed slot");
+
+    std::cout << "  Test Case 2: Bulk reset forgets every object" << std::endl;
+    pool.reset();
+    arena.reset();
+    TEST_ASSERT(pool.live() == 0, "Pool should start empty after reset");
+    Node *fresh = pool.create();
+    TEST_ASSERT(fresh == first && pool.live() == 1, "Free list should be dropped and the arena reused from the start");
+
+    std::cout << "  Test Case 3: Containers allocate from the arena" << std::endl;
+    arena.reset();
+    size_t before = arena.bytesUsed();
+    {
+        std::deque<int, ArenaAllocator<int>> queue((ArenaAllocator<int>(arena)));
+        for (int i = 0; i < 1000; i++) queue.push_back(i);
+        while (queue.size() > 1) queue.pop_front();
+        TEST_ASSERT(queue.front() == 999, "Queue should behave as usual");
+    }
+    TEST_ASSERT(arena.bytesUsed() > before + 1000 * sizeof(int), "Queue storage should come from the arena");
+
+    std::cout << "Object Pool: All tests passed" << std::endl;
+    return 0;
+}
+
+int main() {
+    int failures = 0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "STARTING SIMULATION ARENA TESTS" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    failures += testArena();
+    failures += testPool();
+
+    std::cout << "\n========================================" << std::endl;
+    if (failures == 0) {
+        std::cout << " SIMULATION ARENA TESTS SUMMARY: All tests passed! " << std::endl;
+    } else {
+        std::cout << " SIMULATION ARENA TESTS SUMMARY: " << failures << " tests failed! " << std::endl;
+    }
+    std::cout << "========================================" << std::endl;
+
+    return failures;
+}
@@ -1,14 +1,15 @@
-#include "time_manager.hpp"
-#include <mutex>
-
-std::atomic<int> currentTime(0);
-std::atomic<int> totalMovements(0);  
-
-static std::mutex timeMutex;
-
-void updateTime(int newTime) {
-    std::lock_guard<std::mutex> lock(timeMutex);
-    if (newTime > currentTime.load()) {
-        currentTime.store(newTime);
-    }
-}
+#include "time_manager.hpp"
+#include <mutex>
+
+std::atomic<int> currentTime(0);
+std::atomic<int> totalMovements(0);  
+std::mutex printMutex;
+
+static std::mutex timeMutex;
+
+void updateTime(int newTime) {
+    std::lock_guard<std::mutex> lock(timeMutex);
+    if (newTime > currentTime.load()) {
+        currentTime.store(newTime);
+    }
+}
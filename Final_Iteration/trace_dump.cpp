@@ -0,0 +1,57 @@
+// trace_dump.cpp
+// Summarises a binary event trace written by the simulation.
+//
+// Usage: ./trace_dump [trace_file] [-v]
+//   -v also prints every record, one per line.
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include "event_trace.hpp"
+
+#define DEFAULT_TRACE "simulation_trace.bin"
+
+int main(int argc, char *argv[]) {
+    std::string path = DEFAULT_TRACE;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) verbose = true;
+        else path = argv[i];
+    }
+
+    TraceReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "[TRACE] " << path << " is missing or is not an elevator trace\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    long counts[TRACE_EVENT_TYPES + 1] = {0};
+    long total = 0;
+    int lastSimTime = 0;
+    TraceRecord record;
+    while (reader.next(record)) {
+        counts[record.type < TRACE_EVENT_TYPES ? static_cast<int>(record.type) : static_cast<int>(TRACE_EVENT_TYPES)]++;
+        total++;
+        lastSimTime = record.simTime;
+        if (verbose) {
+            std::cout << std::setw(12) << record.wallNs / 1000 << " us  t=" << std::setw(5) << record.simTime
+                      << "  " << std::left << std::setw(15) << traceEventName(record.type) << std::right
+                      << " car " << std::setw(2) << record.elevator
+                      << "  floor " << std::setw(2) << record.floor
+                      << " -> " << std::setw(2) << record.destination
+                      << "  pax " << record.passengers
+                      << "  detail " << record.detail << "\n";
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "=== Trace " << path << " (version " << reader.header().version << ") ===" << std::endl;
+    for (int type = 0; type < TRACE_EVENT_TYPES; type++)
+        std::cout << std::left << std::setw(16) << traceEventName(type) << std::right << counts[type] << std::endl;
+    if (counts[TRACE_EVENT_TYPES])
+        std::cout << std::left << std::setw(16) << "UNKNOWN" << std::right << counts[TRACE_EVENT_TYPES] << std::endl;
+    std::cout << "Total: " << total << " events over " << lastSimTime << " simulated seconds, read in "
+              << std::fixed << std::setprecision(3) << seconds << " s" << std::endl;
+    return 0;
+}
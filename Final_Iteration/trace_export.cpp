@@ -0,0 +1,229 @@
+// trace_export.cpp
+// Converts a binary event trace into Chrome trace JSON, viewable in
+// chrome://tracing or ui.perfetto.dev.
+//
+// Each car gets a track of IDLE, MOVING and DOOR spans (with PARKING for
+// idle repositioning); each floor gets a track of hall calls, and each call
+// shows how long its passengers waited. Flow arrows link every hall call to
+// the car it was assigned to and to its completion.
+//
+// Usage: ./trace_export [trace_file] [output_json]
+#include <iostream>
+#include <cstdio>
+#include <map>
+#include <deque>
+#include <utility>
+#include "event_trace.hpp"
+
+#define DEFAULT_TRACE "simulation_trace.bin"
+#define DEFAULT_OUTPUT "simulation_trace.json"
+#define CAR_PROCESS 1
+#define CALL_PROCESS 2
+
+enum CarSpan { SPAN_IDLE, SPAN_MOVING, SPAN_PARKING, SPAN_DOOR };
+
+static const char *spanName(CarSpan span) {
+    switch (span) {
+    case SPAN_MOVING: return "MOVING";
+    case SPAN_PARKING: return "PARKING";
+    case SPAN_DOOR: return "DOOR";
+    default: return "IDLE";
+    }
+}
+
+struct CarTrack {
+    CarSpan span;
+    double spanStartUs;
+    double lastEventUs;   // When the car last did anything; moves start from here
+    bool parking;         // Current movement is a parking move
+};
+
+static FILE *out;
+static bool firstEvent = true;
+
+static void beginEvent() {
+    fputs(firstEvent ? "\n" : ",\n", out);
+    firstEvent = false;
+}
+
+static void emitSpan(int car, CarSpan span, double startUs, double endUs) {
+    if (endUs <= startUs) return;
+    beginEvent();
+    fprintf(out, "{\"name\":\"%s\",\"cat\":\"car\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+            spanName(span), CAR_PROCESS, car, startUs, endUs - startUs);
+}
+
+static void emitInstant(const char *name, int pid, int tid, double us) {
+    beginEvent();
+    fprintf(out, "{\"name\":\"%s\",\"cat\":\"car\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f}",
+            name, pid, tid, us);
+}
+
+// Flow arrow step: phase "s" starts, "t" continues and "f" finishes flow id.
+static void emitFlow(char phase, long id, int pid, int tid, double us) {
+    beginEvent();
+    fprintf(out, "{\"name\":\"hall call\",\"cat\":\"dispatch\",\"ph\":\"%c\",\"id\":%ld,\"pid\":%d,\"tid\":%d,\"ts\":%.3f%s}",
+            phase, id, pid, tid, us, phase == 'f' ? ",\"bp\":\"e\"" : "");
+}
+
+static void emitName(const char *kind, int pid, int tid, const char *label, int number) {
+    beginEvent();
+    fprintf(out, "{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s",
+            kind, pid, tid, label);
+    if (number >= 0) fprintf(out, " %d", number);
+    fputs("\"}}", out);
+}
+
+// Close the car's current span at us and start a new one.
+static void switchSpan(std::map<int, CarTrack> &cars, int car, CarSpan span, double startUs, double us) {
+    CarTrack &track = cars[car];
+    emitSpan(car, track.span, track.spanStartUs, startUs);
+    track.span = span;
+    track.spanStartUs = startUs;
+    track.lastEventUs = us;
+}
+
+int main(int argc, char *argv[]) {
+    const char *tracePath = argc > 1 ? argv[1] : DEFAULT_TRACE;
+    const char *outputPath = argc > 2 ? argv[2] : DEFAULT_OUTPUT;
+
+    TraceReader reader;
+    if (!reader.open(tracePath)) {
+        std::cerr << "[TRACE] " << tracePath << " is missing or is not an elevator trace\n";
+        return 1;
+    }
+    out = fopen(outputPath, "w");
+    if (out == nullptr) {
+        std::cerr << "[TRACE] Cannot write " << outputPath << "\n";
+        return 1;
+    }
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", out);
+    emitName("process_name", CAR_PROCESS, 0, "Elevators", -1);
+    emitName("process_name", CALL_PROCESS, 0, "Hall calls", -1);
+
+    std::map<int, CarTrack> cars;
+    std::map<int, bool> floorsSeen;
+    // Hall calls are identified by (floor, destination); a call is waiting
+    // for a car, then riding one, until it completes.
+    std::map<std::pair<int, int>, std::deque<long>> waiting;
+    std::map<int, std::map<std::pair<int, int>, std::deque<long>>> riding;  // Per car
+    std::map<long, double> arrivedUs;
+    long nextCall = 1;
+    long records = 0;
+    double lastUs = 0.0;
+
+    TraceRecord record;
+    while (reader.next(record)) {
+        records++;
+        double us = record.wallNs / 1000.0;
+        lastUs = us;
+        int car = record.elevator;
+        std::pair<int, int> call(record.floor, record.destination);
+
+        if (car >= 0 && !cars.count(car)) {
+            CarTrack track = {SPAN_IDLE, 0.0, 0.0, false};
+            cars[car] = track;
+            emitName("thread_name", CAR_PROCESS, car, "Car", car);
+        }
+
+        switch (record.type) {
+        case TRACE_REQUEST_ARRIVAL: {
+            if (!floorsSeen[record.floor]) {
+                floorsSeen[record.floor] = true;
+                emitName("thread_name", CALL_PROCESS, record.floor, "Floor", record.floor);
+            }
+            long id = nextCall++;
+            waiting[call].push_back(id);
+            arrivedUs[id] = us;
+            beginEvent();
+            fprintf(out, "{\"name\":\"call %d->%d (%d pax)\",\"cat\":\"call\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+                         "\"ts\":%.3f,\"dur\":1}",
+                    record.floor, record.destination, record.passengers, CALL_PROCESS, record.floor, us);
+            emitFlow('s', id, CALL_PROCESS, record.floor, us);
+            break;
+        }
+        case TRACE_ASSIGNMENT: {
+            std::deque<long> &queue = waiting[call];
+            if (queue.empty()) break;
+            long id = queue.front();
+            queue.pop_front();
+            riding[car][call].push_back(id);
+            emitInstant("assigned", CAR_PROCESS, car, us);
+            emitFlow('t', id, CAR_PROCESS, car, us);
+            cars[car].lastEventUs = us;
+            break;
+        }
+        case TRACE_PARKING:
+            cars[car].parking = true;
+            cars[car].lastEventUs = us;
+            break;
+        case TRACE_FLOOR_PASS: {
+            CarTrack &track = cars[car];
+            CarSpan span = track.parking ? SPAN_PARKING : SPAN_MOVING;
+            if (track.span != span)
+                switchSpan(cars, car, span, track.lastEventUs, us);
+            track.lastEventUs = us;
+            break;
+        }
+        case TRACE_DOOR_OPEN:
+            cars[car].parking = false;
+            switchSpan(cars, car, SPAN_DOOR, us, us);
+            break;
+        case TRACE_DOOR_CLOSE:
+            cars[car].lastEventUs = us;
+            break;
+        case TRACE_BOARDING: {
+            std::deque<long> &queue = riding[car][call];
+            for (long id : queue) {
+                // Wait time for the passengers of this call, as an async span on the floor track.
+                if (!arrivedUs.count(id)) continue;
+                beginEvent();
+                fprintf(out, "{\"name\":\"waiting %d->%d\",\"cat\":\"wait\",\"ph\":\"b\",\"id\":%ld,\"pid\":%d,\"tid\":%d,\"ts\":%.3f}",
+                        record.floor, record.destination, id, CALL_PROCESS, record.floor, arrivedUs[id]);
+                beginEvent();
+                fprintf(out, "{\"name\":\"waiting %d->%d\",\"cat\":\"wait\",\"ph\":\"e\",\"id\":%ld,\"pid\":%d,\"tid\":%d,\"ts\":%.3f}",
+                        record.floor, record.destination, id, CALL_PROCESS, record.floor, us);
+                arrivedUs.erase(id);
+                break;
+            }
+            emitInstant("boarded", CAR_PROCESS, car, us);
+            cars[car].lastEventUs = us;
+            break;
+        }
+        case TRACE_COMPLETION: {
+            std::deque<long> &queue = riding[car][call];
+            if (!queue.empty()) {
+                emitFlow('f', queue.front(), CAR_PROCESS, car, us);
+                arrivedUs.erase(queue.front());
+                queue.pop_front();
+            }
+            // Idle until the car's next move or door cycle shows otherwise.
+            switchSpan(cars, car, SPAN_IDLE, us, us);
+            break;
+        }
+        case TRACE_FAULT: {
+            // The scheduler hands the call out again; it waits for a new car.
+            std::deque<long> &queue = riding[car][call];
+            if (!queue.empty()) {
+                waiting[call].push_front(queue.front());
+                queue.pop_front();
+            }
+            emitInstant(record.detail == 1 ? "door fault" : "stuck fault", CAR_PROCESS, car, us);
+            cars[car].parking = false;
+            switchSpan(cars, car, SPAN_IDLE, us, us);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    for (auto &entry : cars)
+        emitSpan(entry.first, entry.second.span, entry.second.spanStartUs, lastUs);
+    fputs("\n]}\n", out);
+    fclose(out);
+
+    std::cout << "Exported " << records << " events for " << cars.size() << " cars and " << nextCall - 1
+              << " hall calls to " << outputPath << std::endl;
+    return 0;
+}
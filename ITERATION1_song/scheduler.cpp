@@ -2,6 +2,7 @@
 #include <iostream>
 #include <algorithm>
 #include <sstream>
+#include <functional>
 
 // ElevatorRequest implementation
 ElevatorRequest::ElevatorRequest(int t, int f, int bt) 
@@ -21,89 +22,180 @@ bool ElevatorRequest::operator==(const ElevatorRequest& other) const {
            buttonType == other.buttonType;
 }
 
-// Check if a request exists in a queue
-bool Scheduler::contains(const std::queue<ElevatorRequest>& q, const ElevatorRequest& req) const {
-    auto temp = q;
-    while (!temp.empty()) {
-        if (temp.front() == req) return true;
-        temp.pop();
+// Combine the fields into one hash value
+size_t ElevatorRequestHash::operator()(const ElevatorRequest& req) const {
+    size_t h = std::hash<int>()(req.time);
+    h = h * 31 + std::hash<int>()(req.floor);
+    h = h * 31 + std::hash<int>()(req.buttonType);
+    return h * 0x9E3779B97F4A7C15ull >> 16; // Spread low bits before masking
+}
+
+RequestSet::RequestSet(size_t capacity)
+    : slots(capacity), used(capacity, false), mask(capacity - 1) {}
+
+// Linear probing; the table is kept at most half full so probes stay short
+size_t RequestSet::find(const ElevatorRequest& req) const {
+    size_t i = ElevatorRequestHash()(req) & mask;
+    while (used[i] && !(slots[i] == req)) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+bool RequestSet::insert(const ElevatorRequest& req) {
+    size_t i = find(req);
+    if (used[i]) return false;
+    slots[i] = req;
+    used[i] = true;
+    return true;
+}
+
+// Remove by shifting later entries of the probe chain back, so no tombstones are left
+void RequestSet::erase(const ElevatorRequest& req) {
+    size_t i = find(req);
+    if (!used[i]) return;
+    for (size_t j = (i + 1) & mask; used[j]; j = (j + 1) & mask) {
+        size_t home = ElevatorRequestHash()(slots[j]) & mask;
+        // Move j into the hole at i unless its home slot lies cyclically in (i, j]
+        bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays) {
+            slots[i] = slots[j];
+            i = j;
+        }
+    }
+    used[i] = false;
+}
+
+RequestChannel::RequestChannel()
+    : ring(CAPACITY), head(0), tail(0), reclaimed(0), queued(2 * CAPACITY), sleeping(false) {}
+
+RequestChannel::PutResult RequestChannel::put(const ElevatorRequest& req) {
+    size_t start = head.load(std::memory_order_acquire);
+    // Forget requests the consumer has taken since the last put
+    for (; reclaimed != start; ++reclaimed) {
+        queued.erase(ring[reclaimed & (CAPACITY - 1)]);
+    }
+
+    size_t end = tail.load(std::memory_order_relaxed);
+    if (end - start == CAPACITY) return FULL;
+    if (!queued.insert(req)) return DUPLICATE;
+
+    ring[end & (CAPACITY - 1)] = req;
+    tail.store(end + 1, std::memory_order_release);
+
+    // Pairs with the fence in take(): either the consumer sees the new tail or we see it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        parked.notify_one();
     }
-    return false;
+    return ADDED;
+}
+
+bool RequestChannel::tryTake(ElevatorRequest& req) {
+    size_t start = head.load(std::memory_order_relaxed);
+    if (start == tail.load(std::memory_order_acquire)) return false;
+    req = ring[start & (CAPACITY - 1)];
+    head.store(start + 1, std::memory_order_release);
+    return true;
+}
+
+bool RequestChannel::take(ElevatorRequest& req, const std::atomic<bool>& running) {
+    // A request usually follows shortly; spinning avoids a sleep/wake round trip
+    for (int spin = 0; spin < 1000; spin++) {
+        if (tryTake(req)) return true;
+        if (!running.load(std::memory_order_acquire)) return false;
+        if (spin >= 100) std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(parkMutex);
+    while (true) {
+        sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (tryTake(req)) break;
+        if (!running.load(std::memory_order_acquire)) {
+            // Stopped: hand out what is left, then report termination
+            sleeping.store(false, std::memory_order_relaxed);
+            return tryTake(req);
+        }
+        parked.wait(lock);
+    }
+    sleeping.store(false, std::memory_order_relaxed);
+    return true;
+}
+
+void RequestChannel::wake() {
+    std::lock_guard<std::mutex> lock(parkMutex);
+    parked.notify_all();
+}
+
+size_t RequestChannel::size() const {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
 }
 
 // Log messages to the console
 void Scheduler::log(const std::string& message) {
-    std::cout << "[Scheduler] " << message << std::endl;
+    // One write per line so lines from different threads do not interleave
+    std::cout << ("[Scheduler] " + message + "\n") << std::flush;
 }
 
 // Add a new request to the queue
 void Scheduler::putRequest(const ElevatorRequest& req) {
-    std::lock_guard<std::mutex> lock(mtx);
-    
     // Avoid duplicate requests
-    if (!contains(requestsQueue, req)) {
-        requestsQueue.push(req);
-        log("Added " + req.toString() + " | Queue size: " + std::to_string(requestsQueue.size()));
+    switch (requests.put(req)) {
+    case RequestChannel::ADDED:
+        log("Added " + req.toString() + " | Queue size: " + std::to_string(requests.size()));
+        break;
+    case RequestChannel::FULL:
+        log("Dropped " + req.toString() + " | Queue full");
+        break;
+    case RequestChannel::DUPLICATE:
+        break;
     }
-    cv.notify_all(); // Notify waiting threads
 }
 
 // Retrieve the next request to process
 ElevatorRequest Scheduler::dispatchRequest() {
-    std::unique_lock<std::mutex> lock(mtx);
+    ElevatorRequest req;
     // Wait until there is a request or the scheduler is stopped
-    cv.wait(lock, [this] { 
-        return !requestsQueue.empty() || !running; 
-    });
-
-    // Return a termination signal if the scheduler is stopped and the queue is empty
-    if (!running && requestsQueue.empty()) {
+    if (!requests.take(req, running)) {
+        // Return a termination signal if the scheduler is stopped and the queue is empty
         return {-1, -1, -1};
     }
-
-    // Retrieve and remove the next request
-    auto req = requestsQueue.front();
-    requestsQueue.pop();
-    log("Dispatched " + req.toString() + " | Remaining: " + std::to_string(requestsQueue.size()));
+    log("Dispatched " + req.toString() + " | Remaining: " + std::to_string(requests.size()));
     return req;
 }
 
 // Mark a request as completed
 void Scheduler::putCompletedRequest(const ElevatorRequest& req) {
-    std::lock_guard<std::mutex> lock(mtx);
-    
     // Avoid duplicate completed requests
-    if (!contains(completedQueue, req)) {
-        completedQueue.push(req);
-        log("Completed " + req.toString() + " | Processed: " + std::to_string(completedQueue.size()));
+    switch (completed.put(req)) {
+    case RequestChannel::ADDED:
+        log("Completed " + req.toString() + " | Processed: " + std::to_string(completed.size()));
+        break;
+    case RequestChannel::FULL:
+        log("Dropped completion " + req.toString() + " | Queue full");
+        break;
+    case RequestChannel::DUPLICATE:
+        break;
     }
-    cv.notify_all(); // Notify waiting threads
 }
 
 // Retrieve a completed request
 ElevatorRequest Scheduler::getCompletedRequest() {
-    std::unique_lock<std::mutex> lock(mtx);
+    ElevatorRequest req;
     // Wait until there is a completed request or the scheduler is stopped
-    cv.wait(lock, [this] { 
-        return !completedQueue.empty() || !running; 
-    });
-
-    // Return a termination signal if the scheduler is stopped and the queue is empty
-    if (!running && completedQueue.empty()) {
+    if (!completed.take(req, running)) {
         return {-1, -1, -1};
     }
-
-    // Retrieve and remove the next completed request
-    auto req = completedQueue.front();
-    completedQueue.pop();
     return req;
 }
 
 // Stop the scheduler
 void Scheduler::stop() {
-    std::lock_guard<std::mutex> lock(mtx);
-    running = false;
-    cv.notify_all(); // Notify all waiting threads
+    running.store(false, std::memory_order_release);
+    requests.wake(); // Wake all waiting threads
+    completed.wake();
 }
 
 // Main processing loop (to run in a thread)
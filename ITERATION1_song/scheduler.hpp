@@ -2,11 +2,12 @@
 #define SCHEDULER_H
 
 #include <mutex>
-#include <queue>
 #include <condition_variable>
 #include <thread>
 #include <atomic>
 #include <string>
+#include <vector>
+#include <cstddef>
 
 // Represents a request for the elevator system
 class ElevatorRequest {
@@ -20,17 +21,68 @@ public:
     bool operator==(const ElevatorRequest& other) const; // Compare requests
 };
 
-// Manages elevator requests and coordinates between floors and elevators
+// Hash of a request, for duplicate detection
+struct ElevatorRequestHash {
+    size_t operator()(const ElevatorRequest& req) const;
+};
+
+// Open-addressing set of requests with a fixed capacity (no allocation after construction)
+class RequestSet {
+private:
+    std::vector<ElevatorRequest> slots;
+    std::vector<bool> used;
+    size_t mask;
+
+    size_t find(const ElevatorRequest& req) const; // Slot holding req, or the empty slot ending its probe
+
+public:
+    explicit RequestSet(size_t capacity); // capacity must be a power of two
+    bool insert(const ElevatorRequest& req); // False if already present
+    void erase(const ElevatorRequest& req);
+};
+
+// Bounded lock-free queue for one producer thread and one consumer thread.
+// The producer keeps a set of the requests still queued so duplicates are rejected in O(1).
+class RequestChannel {
+public:
+    static const size_t CAPACITY = 1024; // Power of two
+    enum PutResult { ADDED, DUPLICATE, FULL };
+
+    RequestChannel();
+    // Producer side
+    PutResult put(const ElevatorRequest& req);
+    // Consumer side: take the next request without waiting
+    bool tryTake(ElevatorRequest& req);
+    // Consumer side: spin briefly, then sleep until a request arrives or running is cleared
+    bool take(ElevatorRequest& req, const std::atomic<bool>& running);
+    // Wake a sleeping consumer so it can notice running was cleared
+    void wake();
+    // Number of queued requests (approximate while other threads are active)
+    size_t size() const;
+
+private:
+    std::vector<ElevatorRequest> ring;
+    alignas(64) std::atomic<size_t> head; // Next slot to take; written by the consumer
+    alignas(64) std::atomic<size_t> tail; // Next slot to fill; written by the producer
+
+    // Producer only
+    alignas(64) size_t reclaimed; // Slots before this have been removed from queued
+    RequestSet queued;
+
+    // Slow path for a consumer with nothing to do
+    std::atomic<bool> sleeping;
+    std::mutex parkMutex;
+    std::condition_variable parked;
+};
+
+// Manages elevator requests and coordinates between floors and elevators.
+// Requests and completions travel on separate channels, each with one producer and one consumer.
 class Scheduler {
 private:
-    std::mutex mtx; // Mutex for thread synchronization
-    std::condition_variable cv; // Condition variable for thread signaling
-    std::queue<ElevatorRequest> requestsQueue; // Queue for pending requests
-    std::queue<ElevatorRequest> completedQueue; // Queue for completed requests
-    bool running = true; // Flag to control the scheduler's running state
-
-    // Check if a request already exists in a queue
-    bool contains(const std::queue<ElevatorRequest>& q, const ElevatorRequest& req) const;
+    RequestChannel requests; // Pending requests: floor -> elevator
+    RequestChannel completed; // Completed requests: elevator -> floor
+    std::atomic<bool> running{true}; // Flag to control the scheduler's running state
+
     // Log messages to the console
     static void log(const std::string& message);
 
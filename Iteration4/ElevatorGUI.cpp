@@ -1,42 +1,138 @@
 #include "ElevatorGUI.h"
 #include <QtWidgets/QVBoxLayout>
-#include <QtWidgets/QDateTime>
-#include <thread>
-#include "floor.cpp"
-#include "scheduler.cpp"
-#include "elevator.cpp"
-#include "shared.hpp"
+#include <QtWidgets/QStatusBar>
+#include <QtCore/QDateTime>
+#include <QtCore/QProcess>
+#include <QtGui/QPainter>
+#include <QtNetwork/QHostAddress>
+#include <algorithm>
+#include "message.hpp"
 
-std::atomic<int> currentTime(0);
-//std::mutex printMutex;
-bool systemActive = true;
+#define SCHEDULER_IP "127.0.0.1"
+#define SCHEDULER_PORT 8100
+#define SYSTEM_EXECUTABLE "./elevator_system"
+
+static QString stateName(int state) {
+    switch (state) {
+    case CAR_MOVING: return "Moving";
+    case CAR_FAULTED: return "Faulted";
+    default: return "Idle";
+    }
+}
+
+static QColor stateColor(int state) {
+    switch (state) {
+    case CAR_MOVING: return QColor(70, 130, 200);
+    case CAR_FAULTED: return QColor(200, 60, 60);
+    default: return QColor(120, 170, 120);
+    }
+}
+
+void FrameStats::endFrame() {
+    if (currentNs == 0)
+        return;
+    frames++;
+    totalNs += currentNs;
+    worstNs = std::max(worstNs, currentNs);
+    currentNs = 0;
+}
+
+ShaftView::ShaftView(const std::vector<StatusEvent> &cars, FrameStats &stats, QWidget *parent)
+    : QWidget(parent), cars(cars), stats(stats) {
+    setMinimumHeight(240);
+    // Everything is repainted each frame; skip clearing to the background first.
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void ShaftView::paintEvent(QPaintEvent *) {
+    QElapsedTimer clock;
+    clock.start();
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().window());
+
+    int floors = MAX_FLOOR - MIN_FLOOR + 1;
+    int shafts = cars.empty() ? 1 : static_cast<int>(cars.size());
+    double floorHeight = static_cast<double>(height()) / floors;
+    double shaftWidth = static_cast<double>(width()) / shafts;
+
+    // Floor lines, labelled while there is room for text.
+    painter.setPen(QColor(200, 200, 200));
+    for (int f = 0; f < floors; f++) {
+        int y = static_cast<int>(height() - (f + 1) * floorHeight);
+        painter.drawLine(0, y, width(), y);
+        if (floorHeight >= 12)
+            painter.drawText(2, y + static_cast<int>(floorHeight) - 2, QString::number(MIN_FLOOR + f));
+    }
+
+    for (size_t i = 0; i < cars.size(); i++) {
+        const StatusEvent &car = cars[i];
+        if (car.elevatorId < 0)
+            continue;  // Id not reported yet
+        double x = i * shaftWidth;
+        int margin = shaftWidth > 6 ? 2 : 0;
+        int carY = static_cast<int>(height() - (car.currentFloor - MIN_FLOOR + 1) * floorHeight);
+        QRectF box(x + margin, carY + 1, shaftWidth - 2 * margin, floorHeight - 2);
+        painter.fillRect(box, stateColor(car.state));
+
+        // Mark the destination floor with a tick in the same shaft.
+        if (car.destination >= MIN_FLOOR) {
+            int y = static_cast<int>(height() - (car.destination - MIN_FLOOR + 0.5) * floorHeight);
+            painter.setPen(Qt::black);
+            painter.drawLine(static_cast<int>(x + margin), y, static_cast<int>(x + shaftWidth - margin), y);
+        }
+    }
+    stats.currentNs += clock.nsecsElapsed();
+}
+
+StatusTable::StatusTable(FrameStats &stats, QWidget *parent)
+    : QTableWidget(0, 5, parent), stats(stats) {}
+
+void StatusTable::paintEvent(QPaintEvent *event) {
+    QElapsedTimer clock;
+    clock.start();
+    QTableWidget::paintEvent(event);
+    stats.currentNs += clock.nsecsElapsed();
+}
 
 ElevatorGUI::ElevatorGUI(QWidget *parent)
-    : QMainWindow(parent) {
+    : QMainWindow(parent), streaming(false) {
 
     QWidget *central = new QWidget(this);
     QVBoxLayout *layout = new QVBoxLayout(central);
 
     startButton = new QPushButton("Start System");
-    statusTable = new QTableWidget(2, 5);
+    statusTable = new StatusTable(frameStats);
     statusTable->setHorizontalHeaderLabels({"Elevator", "Current Floor", "Status", "Destination", "Fault"});
+    shaftView = new ShaftView(cars, frameStats);
     logBox = new QTextEdit();
     logBox->setReadOnly(true);
 
     layout->addWidget(startButton);
-    layout->addWidget(statusTable);
+    layout->addWidget(shaftView, 2);
+    layout->addWidget(statusTable, 1);
     layout->addWidget(logBox);
     setCentralWidget(central);
 
     connect(startButton, &QPushButton::clicked, this, &ElevatorGUI::handleStartSystem);
 
-    // Auto refresh every second
-    updateTimer = new QTimer(this);
-    connect(updateTimer, &QTimer::timeout, this, &ElevatorGUI::refreshStatusTable);
-    updateTimer->start(1000);
+    // Status changes arrive as datagrams; the socket wakes us only when there is one.
+    statusSocket = new QUdpSocket(this);
+    statusSocket->bind(QHostAddress::LocalHost, 0);
+    connect(statusSocket, &QUdpSocket::readyRead, this, &ElevatorGUI::readStatusEvents);
+
+    subscribeTimer = new QTimer(this);
+    connect(subscribeTimer, &QTimer::timeout, this, &ElevatorGUI::subscribe);
+    subscribeTimer->start(MONITOR_RESUBSCRIBE_MS);
+    subscribe();
+
+    // Changes are coalesced and drawn once per frame.
+    frameTimer = new QTimer(this);
+    connect(frameTimer, &QTimer::timeout, this, &ElevatorGUI::renderFrame);
+    frameTimer->start(MONITOR_FRAME_MS);
+    statsClock.start();
 
     setWindowTitle("Elevator System Monitor");
-    resize(600, 400);
+    resize(800, 600);
 }
 
 ElevatorGUI::~ElevatorGUI() {}
@@ -46,38 +142,96 @@ void ElevatorGUI::logMessage(const QString &msg) {
     logBox->append("[" + timestamp + "] " + msg);
 }
 
+// The simulation runs as its own process; the GUI only watches it.
 void ElevatorGUI::handleStartSystem() {
-    logMessage("System starting...");
-
-    std::thread schedulerThread([]() {
-        schedulerFunction();
-    });
-    std::thread elevator0([]() {
-        elevatorFunction(0);
-    });
-    std::thread elevator1([]() {
-        elevatorFunction(1);
-    });
-    std::thread floorThread([]() {
-        floorFunction();
-    });
-
-    schedulerThread.detach();
-    elevator0.detach();
-    elevator1.detach();
-    floorThread.detach();
-
-    logMessage("All components started.");
+    if (QProcess::startDetached(SYSTEM_EXECUTABLE, QStringList()))
+        logMessage("System starting...");
+    else
+        logMessage("Could not start " SYSTEM_EXECUTABLE);
+}
+
+void ElevatorGUI::subscribe() {
+    ElevatorMessage request;
+    request.msgType = MSG_SUBSCRIBE_STATUS;
+    statusSocket->writeDatagram(reinterpret_cast<const char *>(&request), sizeof(request),
+                                QHostAddress(SCHEDULER_IP), SCHEDULER_PORT);
+}
+
+void ElevatorGUI::readStatusEvents() {
+    while (statusSocket->hasPendingDatagrams()) {
+        StatusEvent event;
+        if (statusSocket->readDatagram(reinterpret_cast<char *>(&event), sizeof(event)) == static_cast<qint64>(sizeof(event)))
+            applyEvent(event);
+    }
+}
+
+void ElevatorGUI::applyEvent(const StatusEvent &event) {
+    if (event.elevatorId < 0)
+        return;
+    if (!streaming) {
+        streaming = true;
+        logMessage("Receiving status from the scheduler.");
+    }
+    size_t row = static_cast<size_t>(event.elevatorId);
+    if (row >= cars.size()) {
+        StatusEvent unknown = {-1, MIN_FLOOR, -1, CAR_IDLE, 0};
+        cars.resize(row + 1, unknown);
+        rowDirty.resize(row + 1, false);
+    }
+    cars[row] = event;
+    if (!rowDirty[row]) {
+        rowDirty[row] = true;
+        dirtyRows.push_back(static_cast<int>(row));
+    }
+}
+
+void ElevatorGUI::updateRow(int row) {
+    const StatusEvent &e = cars[row];
+    QString text[5] = {
+        QString::number(e.elevatorId),
+        QString::number(e.currentFloor),
+        stateName(e.state),
+        e.destination == -1 ? "-" : QString::number(e.destination),
+        e.state == CAR_FAULTED ? "Yes" : "No"
+    };
+    for (int column = 0; column < 5; column++) {
+        QTableWidgetItem *item = statusTable->item(row, column);
+        if (item == nullptr) {
+            item = new QTableWidgetItem();
+            statusTable->setItem(row, column, item);
+        }
+        if (item->text() != text[column])
+            item->setText(text[column]);
+    }
+}
+
+// Frames drawn and their average and worst time since the last report.
+void ElevatorGUI::showFrameStats() {
+    QString text = QString("%1 cars | %2 frames/s | frame %3 ms avg, %4 ms worst")
+        .arg(cars.size())
+        .arg(frameStats.frames * 1000.0 / statsClock.restart(), 0, 'f', 1)
+        .arg(frameStats.frames ? frameStats.totalNs / 1e6 / frameStats.frames : 0.0, 0, 'f', 2)
+        .arg(frameStats.worstNs / 1e6, 0, 'f', 2);
+    statusBar()->showMessage(text);
+    frameStats = FrameStats();
 }
 
-void ElevatorGUI::refreshStatusTable() {
-    std::lock_guard<std::mutex> lock(statusMutex);
-    for (int i = 0; i < elevatorStatuses.size(); ++i) {
-        const ElevatorStatus &e = elevatorStatuses[i];
-        statusTable->setItem(i, 0, new QTableWidgetItem(QString::number(e.id)));
-        statusTable->setItem(i, 1, new QTableWidgetItem(QString::number(e.currentFloor)));
-        statusTable->setItem(i, 2, new QTableWidgetItem(QString::fromStdString(e.status)));
-        statusTable->setItem(i, 3, new QTableWidgetItem(e.destination == -1 ? "-" : QString::number(e.destination)));
-        statusTable->setItem(i, 4, new QTableWidgetItem(e.fault ? "Yes" : "No"));
+// Apply the changes since the last frame: only changed rows are touched.
+void ElevatorGUI::renderFrame() {
+    frameStats.endFrame();
+    if (statsClock.elapsed() >= MONITOR_STATS_MS)
+        showFrameStats();
+    if (dirtyRows.empty())
+        return;
+    QElapsedTimer clock;
+    clock.start();
+    if (statusTable->rowCount() < static_cast<int>(cars.size()))
+        statusTable->setRowCount(static_cast<int>(cars.size()));
+    for (int row : dirtyRows) {
+        updateRow(row);
+        rowDirty[row] = false;
     }
+    dirtyRows.clear();
+    shaftView->update();
+    frameStats.currentNs += clock.nsecsElapsed();
 }
@@ -5,7 +5,52 @@
 #include <QtWidgets/QPushButton>
 #include <QtWidgets/QTextEdit>
 #include <QtWidgets/QTableWidget>
-#include <QtWidgets/QTimer>
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtNetwork/QUdpSocket>
+#include <vector>
+#include "status_stream.hpp"
+
+#define MONITOR_FRAME_MS 33          // Repaint at most ~30 times a second
+#define MONITOR_RESUBSCRIBE_MS 5000  // Re-subscribe (and resync) in case the scheduler restarted
+#define MONITOR_STATS_MS 1000        // Show the frame time in the status bar this often
+
+// Time spent on each frame: applying the changes plus painting the views they
+// dirtied. A frame ends when the next one starts.
+struct FrameStats {
+    FrameStats() : frames(0), totalNs(0), worstNs(0), currentNs(0) {}
+    int frames;
+    qint64 totalNs;
+    qint64 worstNs;
+    qint64 currentNs;   // Frame in progress
+
+    void endFrame();
+};
+
+// Draws every car in its own shaft, one column per car.
+class ShaftView : public QWidget {
+public:
+    ShaftView(const std::vector<StatusEvent> &cars, FrameStats &stats, QWidget *parent = nullptr);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    const std::vector<StatusEvent> &cars;
+    FrameStats &stats;
+};
+
+// The status table, with its painting counted in the frame time.
+class StatusTable : public QTableWidget {
+public:
+    StatusTable(FrameStats &stats, QWidget *parent = nullptr);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    FrameStats &stats;
+};
 
 class ElevatorGUI : public QMainWindow {
     Q_OBJECT
@@ -16,14 +61,29 @@ public:
 
 private slots:
     void handleStartSystem();
-    void refreshStatusTable();
+    void subscribe();
+    void readStatusEvents();
+    void renderFrame();
 
 private:
     QPushButton *startButton;
-    QTableWidget *statusTable;
+    StatusTable *statusTable;
+    ShaftView *shaftView;
     QTextEdit *logBox;
-    QTimer *updateTimer;
+    QTimer *frameTimer;
+    QTimer *subscribeTimer;
+    QUdpSocket *statusSocket;
+
+    std::vector<StatusEvent> cars;   // Latest state, indexed by elevator id
+    std::vector<bool> rowDirty;      // Changed since the last frame
+    std::vector<int> dirtyRows;
+    bool streaming;
+    FrameStats frameStats;
+    QElapsedTimer statsClock;
 
+    void applyEvent(const StatusEvent &event);
+    void updateRow(int row);
+    void showFrameStats();
     void logMessage(const QString &msg);
 };
 
@@ -0,0 +1,9 @@
+# qmake project for the monitor GUI (see readme.txt).
+# qmake ElevatorGUI.pro && make
+
+QT += widgets network
+CONFIG += c++11
+TARGET = ElevatorGUI
+
+SOURCES += main2.0.cpp ElevatorGUI.cpp
+HEADERS += ElevatorGUI.h status_stream.hpp message.hpp
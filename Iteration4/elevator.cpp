@@ -18,7 +18,6 @@ extern bool systemActive;
 #define SCHEDULER_IP "127.0.0.1"
 #define SCHEDULER_PORT 8100
 #define FLOOR_TRAVEL_TIME 1  // seconds per floor
-#define MIN_FLOOR 1
 
 // Fault codes
 #define NO_FAULT 0
@@ -13,8 +13,6 @@
 #define SCHEDULER_IP "127.0.0.1"
 #define SCHEDULER_PORT 8100
 #define INPUT_FILE "input.txt"
-#define MIN_FLOOR 1
-#define MAX_FLOOR 12
 
 extern std::mutex printMutex;
 
@@ -1,6 +1,11 @@
 #ifndef MESSAGE_HPP
 #define MESSAGE_HPP
 
+// Floors of the building, shared by the floor subsystem, the cars, the
+// scheduler and the monitor GUI.
+#define MIN_FLOOR 1
+#define MAX_FLOOR 12
+
 // Enumerations for elevator and scheduler states (if needed)
 enum ElevatorState {
     IDLE,
@@ -22,7 +27,7 @@ struct ElevatorMessage {
     bool directionUp;        // true for UP request; false for DOWN
     int assignedElevator;    // Elevator id assigned (-1 if not yet assigned)
     int status;              // 1 for success, negative for faults
-    int msgType;             // 0: new request/assignment, 1: normal completion, 2: fault, 3: intermediate update
+    int msgType;             // 0: new request/assignment, 1: normal completion, 2: fault, 3: intermediate update, 4: status subscription
     int faultCode;           // 0: no fault, 1: door fault, 2: elevator stuck fault
     int timestamp;           // Simulated time when the message is sent
 
@@ -2,6 +2,7 @@
 #include "message.hpp"
 #include "time_manager.hpp"
 #include "shared.hpp"
+#include "status_stream.hpp"
 #include <iostream>
 #include <cstring>
 #include <arpa/inet.h>
@@ -16,7 +17,6 @@
 #define SCHEDULER_PORT 8100
 #define ELEVATOR_PORT_BASE 9100
 #define MAX_ELEVATORS 2
-#define MIN_FLOOR 1  
 #define RESPONSE_TIMEOUT 10  // seconds
 
 extern bool systemActive;
@@ -38,12 +38,73 @@ struct Elevator {
     bool isIdle;
     bool goingUp;
     int passengerCount;
+    int destination; // destination of the current trip, -1 if none
+    uint8_t faultBits; // STATUS_FAULT_* seen since the last completed trip
     bool isFaulted; // added to indicate a hard fault (shutdown)
     struct sockaddr_in address;
 };
 
 std::vector<Elevator> elevators(MAX_ELEVATORS);
 
+// Monitors subscribed to the status stream (see status_stream.hpp).
+std::mutex subscriberMutex;
+std::vector<struct sockaddr_in> statusSubscribers;
+
+// Send one car's published state to a single monitor.
+static void sendStatus(int eid, const struct sockaddr_in &subscriber) {
+    ElevatorStatus status;
+    if (!readElevatorStatus(eid, status))
+        return;
+    StatusEvent event;
+    event.elevatorId = status.id;
+    event.currentFloor = status.currentFloor;
+    event.destination = status.destination;
+    event.state = status.state == STATUS_FAULTED ? CAR_FAULTED :
+                  (status.state == STATUS_MOVING ? CAR_MOVING : CAR_IDLE);
+    event.timestamp = status.timestamp;
+    sendto(sockfd, &event, sizeof(event), 0, (struct sockaddr*)&subscriber, sizeof(subscriber));
+}
+
+// Publish a car's new state to the shared status table and every subscribed monitor.
+static void publishStatus(int eid) {
+    const Elevator &elevator = elevators[eid];
+    ElevatorStatus status;
+    status.id = static_cast<int16_t>(elevator.id);
+    status.currentFloor = static_cast<int16_t>(elevator.position);
+    status.destination = static_cast<int16_t>(elevator.destination);
+    status.state = elevator.isFaulted ? STATUS_FAULTED : (elevator.isIdle ? STATUS_IDLE : STATUS_MOVING);
+    status.faultBits = elevator.faultBits;
+    status.tripsAssigned = static_cast<uint16_t>(elevator.passengerCount);
+    status.reserved = 0;
+    status.timestamp = currentTime.load();
+    publishElevatorStatus(status);
+
+    std::lock_guard<std::mutex> lock(subscriberMutex);
+    for (const auto &subscriber : statusSubscribers) {
+        sendStatus(eid, subscriber);
+    }
+}
+
+// Register a monitor (once) and bring it up to date with every car.
+static void addSubscriber(const struct sockaddr_in &address) {
+    std::lock_guard<std::mutex> lock(subscriberMutex);
+    bool known = false;
+    for (const auto &subscriber : statusSubscribers) {
+        if (subscriber.sin_addr.s_addr == address.sin_addr.s_addr && subscriber.sin_port == address.sin_port)
+            known = true;
+    }
+    if (!known) {
+        if (statusSubscribers.size() >= MAX_STATUS_SUBSCRIBERS)
+            statusSubscribers.erase(statusSubscribers.begin());
+        statusSubscribers.push_back(address);
+        std::lock_guard<std::mutex> printLock(printMutex);
+        std::cout << "[SCHEDULER] Status monitor subscribed from port " << ntohs(address.sin_port) << "\n";
+    }
+    for (const auto &elevator : elevators) {
+        sendStatus(elevator.id, address);
+    }
+}
+
 // Structure to track in-progress assignments.
 struct InProgressRequest {
     ElevatorMessage msg;
@@ -69,8 +130,11 @@ void faultMonitor() {
                 }
                 // Mark this elevator as faulted (shutdown it) and do not assign it further.
                 elevators[it->elevatorId].isFaulted = true;
+                elevators[it->elevatorId].faultBits |= STATUS_FAULT_HARD;
                 elevators[it->elevatorId].isIdle = false;
                 elevators[it->elevatorId].isMoving = false;
+                elevators[it->elevatorId].destination = -1;
+                publishStatus(it->elevatorId);
                 // Requeue the request for reassignment.
                 {
                     std::lock_guard<std::mutex> pendingLock(pendingMutex);
@@ -170,6 +234,8 @@ void assignElevator() {
     elevators[bestElevator].isMoving = true;
     elevators[bestElevator].goingUp = request.directionUp;
     elevators[bestElevator].passengerCount++;
+    elevators[bestElevator].destination = request.destination;
+    publishStatus(bestElevator);
 
     {
         std::lock_guard<std::mutex> lock(printMutex);
@@ -224,10 +290,13 @@ void schedulerFunction() {
         elevators[i].isIdle = true;
         elevators[i].goingUp = true;
         elevators[i].passengerCount = 0;
+        elevators[i].destination = -1;
+        elevators[i].faultBits = 0;
         elevators[i].isFaulted = false;
         elevators[i].address.sin_family = AF_INET;
         elevators[i].address.sin_port = htons(ELEVATOR_PORT_BASE + i);
         inet_pton(AF_INET, "127.0.0.1", &elevators[i].address.sin_addr);
+        publishStatus(i);
     }
 
     // Start fault monitor thread.
@@ -243,7 +312,9 @@ void schedulerFunction() {
             continue;
         updateTime(request.timestamp);
 
-        if (request.msgType == 0) {
+        if (request.msgType == MSG_SUBSCRIBE_STATUS) {
+            addSubscriber(senderAddr);
+        } else if (request.msgType == 0) {
             // New request from floor subsystem.
             {
                 std::lock_guard<std::mutex> lock(pendingMutex);
@@ -269,6 +340,9 @@ void schedulerFunction() {
                 elevators[eid].position = request.destination;
                 elevators[eid].isIdle = true;
                 elevators[eid].isMoving = false;
+                elevators[eid].destination = -1;
+                elevators[eid].faultBits &= STATUS_FAULT_HARD;
+                publishStatus(eid);
             }
             {
                 std::lock_guard<std::mutex> lock(printMutex);
@@ -286,6 +360,9 @@ void schedulerFunction() {
             if (!elevators[eid].isFaulted) {
                 elevators[eid].isIdle = true;
                 elevators[eid].isMoving = false;
+                elevators[eid].destination = -1;
+                elevators[eid].faultBits |= (request.faultCode == 1) ? STATUS_FAULT_DOOR : STATUS_FAULT_STUCK;
+                publishStatus(eid);
             }
             {
                 std::lock_guard<std::mutex> lock(pendingMutex);
@@ -308,6 +385,7 @@ void schedulerFunction() {
             int eid = request.assignedElevator;
             if (!elevators[eid].isFaulted) {
                 elevators[eid].position = request.floorNumber;
+                publishStatus(eid);
             }
             {
                 std::lock_guard<std::mutex> lock(printMutex);
@@ -0,0 +1,45 @@
+// shared.cpp
+#include "shared.hpp"
+
+static_assert(sizeof(ElevatorStatusSlot) == CACHE_LINE_BYTES, "one status slot per cache line");
+
+ElevatorStatusSlot elevatorStatuses[MAX_STATUS_ELEVATORS];
+
+void publishElevatorStatus(const ElevatorStatus &status) {
+    if (status.id < 0 || status.id >= MAX_STATUS_ELEVATORS)
+        return;
+    ElevatorStatusSlot &slot = elevatorStatuses[status.id];
+
+    // Writers claim the slot by making the counter odd; a second writer waits for the first.
+    uint32_t version = slot.version.load(std::memory_order_relaxed);
+    do {
+        version &= ~1u;
+    } while (!slot.version.compare_exchange_weak(version, version + 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.status = status;
+    // Even again (and one step on) once the new status is in place.
+    slot.version.store(version + 2, std::memory_order_release);
+}
+
+bool readElevatorStatus(int id, ElevatorStatus &status) {
+    if (id < 0 || id >= MAX_STATUS_ELEVATORS)
+        return false;
+    const ElevatorStatusSlot &slot = elevatorStatuses[id];
+    uint32_t before, after;
+    do {
+        before = slot.version.load(std::memory_order_acquire);
+        status = slot.status;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = slot.version.load(std::memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+    return before != 0;
+}
+
+const char *statusStateName(int state) {
+    switch (state) {
+    case STATUS_MOVING: return "Moving";
+    case STATUS_FAULTED: return "Faulted";
+    default: return "Idle";
+    }
+}
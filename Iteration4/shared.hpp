@@ -2,19 +2,53 @@
 #ifndef SHARED_HPP
 #define SHARED_HPP
 
-#include <vector>
-#include <string>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 
+#define MAX_STATUS_ELEVATORS 64
+#define CACHE_LINE_BYTES 64
+
+enum ElevatorStatusState {
+    STATUS_IDLE,
+    STATUS_MOVING,
+    STATUS_FAULTED
+};
+
+// Fault bits; a car can carry more than one.
+#define STATUS_FAULT_DOOR  0x1   // Transient door fault reported by the car
+#define STATUS_FAULT_STUCK 0x2   // Transient stuck fault reported by the car
+#define STATUS_FAULT_HARD  0x4   // No response in time; car taken out of service
+
+// One car's status. Plain data: copying it never allocates, and text is
+// only produced when it is displayed (see statusStateName).
 struct ElevatorStatus {
-    int id = 0;
-    int currentFloor = 1;
-    int destination = -1;
-    std::string status = "Idle";
-    bool fault = false;
+    int16_t id;
+    int16_t currentFloor;
+    int16_t destination;     // -1 when the car has no trip
+    uint8_t state;           // ElevatorStatusState
+    uint8_t faultBits;       // STATUS_FAULT_*
+    uint16_t tripsAssigned;  // Trips given to the car since start (cars do not report passenger load)
+    uint16_t reserved;
+    int32_t timestamp;       // Simulated time of the last change
 };
 
-extern std::vector<ElevatorStatus> elevatorStatuses;
-extern std::mutex statusMutex;
+// A status record on its own cache line, guarded by a sequence counter: the
+// counter is odd while a writer is updating the record, and readers retry
+// until they copy it between two equal, even values. Readers never block
+// writers.
+struct alignas(CACHE_LINE_BYTES) ElevatorStatusSlot {
+    std::atomic<uint32_t> version;
+    ElevatorStatus status;
+};
+
+extern ElevatorStatusSlot elevatorStatuses[MAX_STATUS_ELEVATORS];
+
+// Publish a car's status (status.id selects the slot).
+void publishElevatorStatus(const ElevatorStatus &status);
+
+// Copy out a consistent status. Returns false for an id that was never published.
+bool readElevatorStatus(int id, ElevatorStatus &status);
+
+const char *statusStateName(int state);
 
 #endif // SHARED_HPP
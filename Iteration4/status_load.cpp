@@ -0,0 +1,146 @@
+/* status_load.cpp */
+// Stands in for the scheduler's status stream with many cars, to load the
+// monitor GUI. Run it instead of elevator_system (both use SCHEDULER_PORT):
+//
+//     ./status_load [cars] [seconds per floor]
+//
+// Each car travels between random floors, one floor every `seconds per floor`
+// (FLOOR_TRAVEL_TIME in elevator.cpp by default), rests for a second at each
+// destination and now and then faults. Every change goes to every subscribed
+// monitor as a StatusEvent, exactly as the scheduler sends it.
+#include "message.hpp"
+#include "status_stream.hpp"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define SCHEDULER_PORT 8100
+#define DEFAULT_CARS 128
+#define DEFAULT_FLOOR_MS 1000
+#define TICK_MS 10            // Step the cars this often
+#define REST_MS 1000          // Idle time at each destination
+#define FAULT_ONE_IN 200      // Chance per trip that the car faults instead
+#define REPORT_MS 5000        // Print the event rate this often
+
+struct LoadCar {
+    StatusEvent status;
+    long nextChangeMs;
+};
+
+static long elapsedMs(std::chrono::steady_clock::time_point start) {
+    return static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+static void sendEvent(int sockfd, const StatusEvent &event, const std::vector<sockaddr_in> &subscribers) {
+    for (const auto &subscriber : subscribers)
+        sendto(sockfd, &event, sizeof(event), 0, (const struct sockaddr*)&subscriber, sizeof(subscriber));
+}
+
+int main(int argc, char *argv[]) {
+    int numCars = argc > 1 ? std::atoi(argv[1]) : DEFAULT_CARS;
+    long floorMs = argc > 2 ? static_cast<long>(std::atof(argv[2]) * 1000) : DEFAULT_FLOOR_MS;
+    if (numCars <= 0 || floorMs <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [cars] [seconds per floor]\n";
+        return 1;
+    }
+
+    int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sockfd < 0) {
+        perror("[STATUS LOAD] Socket creation failed");
+        return 1;
+    }
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(SCHEDULER_PORT);
+    if (bind(sockfd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        perror("[STATUS LOAD] Bind failed (is elevator_system running?)");
+        close(sockfd);
+        return 1;
+    }
+    struct timeval tv = {0, TICK_MS * 1000};
+    setsockopt(sockfd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
+
+    std::mt19937 rng(39);
+    std::uniform_int_distribution<int> floorDist(MIN_FLOOR, MAX_FLOOR);
+    std::uniform_int_distribution<int> faultDist(1, FAULT_ONE_IN);
+    std::uniform_int_distribution<long> phaseDist(0, floorMs);
+
+    std::vector<LoadCar> cars(numCars);
+    for (int i = 0; i < numCars; i++) {
+        StatusEvent status = {i, floorDist(rng), -1, CAR_IDLE, 0};
+        cars[i].status = status;
+        cars[i].nextChangeMs = phaseDist(rng);  // Spread the cars over the first floor time
+    }
+
+    std::cout << "[STATUS LOAD] " << numCars << " cars, " << floorMs << " ms per floor, on port "
+              << SCHEDULER_PORT << "\n";
+
+    std::vector<sockaddr_in> subscribers;
+    auto start = std::chrono::steady_clock::now();
+    long events = 0;
+    long lastReport = 0;
+    while (true) {
+        // A subscribe (or re-subscribe) gets every car's state, as from the scheduler.
+        ElevatorMessage request;
+        struct sockaddr_in from;
+        socklen_t fromLen = sizeof(from);
+        int received = recvfrom(sockfd, &request, sizeof(request), 0, (struct sockaddr*)&from, &fromLen);
+        if (received == sizeof(request) && request.msgType == MSG_SUBSCRIBE_STATUS) {
+            bool known = false;
+            for (const auto &subscriber : subscribers)
+                known = known || (subscriber.sin_addr.s_addr == from.sin_addr.s_addr && subscriber.sin_port == from.sin_port);
+            if (!known && subscribers.size() < MAX_STATUS_SUBSCRIBERS) {
+                subscribers.push_back(from);
+                std::cout << "[STATUS LOAD] Monitor subscribed from port " << ntohs(from.sin_port) << "\n";
+            }
+            for (const auto &car : cars)
+                sendto(sockfd, &car.status, sizeof(car.status), 0, (struct sockaddr*)&from, fromLen);
+        }
+
+        long now = elapsedMs(start);
+        for (auto &car : cars) {
+            if (now < car.nextChangeMs)
+                continue;
+            StatusEvent &s = car.status;
+            s.timestamp = static_cast<int>(now / 1000);
+            if (s.state != CAR_MOVING) {
+                // Idle or repaired: take a new trip, or fault in place.
+                s.destination = floorDist(rng);
+                if (s.destination == s.currentFloor)
+                    s.destination = s.currentFloor == MAX_FLOOR ? MIN_FLOOR : MAX_FLOOR;
+                s.state = faultDist(rng) == 1 ? CAR_FAULTED : CAR_MOVING;
+                car.nextChangeMs = now + (s.state == CAR_FAULTED ? REST_MS * 5 : floorMs);
+                if (s.state == CAR_FAULTED)
+                    s.destination = -1;
+            } else {
+                s.currentFloor += s.destination > s.currentFloor ? 1 : -1;
+                if (s.currentFloor == s.destination) {
+                    s.state = CAR_IDLE;
+                    s.destination = -1;
+                    car.nextChangeMs = now + REST_MS;
+                } else {
+                    car.nextChangeMs = now + floorMs;
+                }
+            }
+            sendEvent(sockfd, s, subscribers);
+            events++;
+        }
+
+        if (now - lastReport >= REPORT_MS) {
+            std::cout << "[STATUS LOAD] " << events * 1000 / std::max(1L, now - lastReport)
+                      << " events/s to " << subscribers.size() << " monitor(s)\n";
+            events = 0;
+            lastReport = now;
+        }
+    }
+}
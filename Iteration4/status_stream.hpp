@@ -0,0 +1,26 @@
+// status_stream.hpp
+#ifndef STATUS_STREAM_HPP
+#define STATUS_STREAM_HPP
+
+// A monitor (e.g. ElevatorGUI) sends an ElevatorMessage with this msgType to
+// SCHEDULER_PORT to subscribe. The scheduler answers with one StatusEvent per
+// car, then sends a StatusEvent every time a car's state changes.
+#define MSG_SUBSCRIBE_STATUS 4
+#define MAX_STATUS_SUBSCRIBERS 8
+
+enum CarState {
+    CAR_IDLE,
+    CAR_MOVING,
+    CAR_FAULTED
+};
+
+// One car's state after a change, sent as a raw datagram.
+struct StatusEvent {
+    int elevatorId;
+    int currentFloor;
+    int destination;     // -1 when the car has no trip
+    int state;           // CarState
+    int timestamp;       // Simulated time of the change
+};
+
+#endif // STATUS_STREAM_HPP
@@ -1,75 +1,121 @@
 #include <iostream>
 #include <thread>
-#include <queue>
 #include <mutex>
 #include <condition_variable>
-#include <string>
+#include <type_traits>
+
+// Hall button pressed. An enum rather than text, so a message is plain data
+// and copying it into or out of a channel slot never allocates.
+enum Button {
+	BUTTON_UP,
+	BUTTON_DOWN
+};
+
+const char* button_name(int button) {
+	return button == BUTTON_DOWN ? "down" : "up";
+}
 
 struct MyStruct
 {
 	int time;
 	int floor;
-	std::string button;
-	int priority;
+	int button; // One of Button
+	int priority; // One of Priority
+};
+
+// Message priorities, lowest first. A channel always hands out the most urgent message it holds.
+enum Priority {
+	PRIORITY_BACKGROUND = 0,
+	PRIORITY_ROUTINE = 1,
+	PRIORITY_FAULT = 2,
+	PRIORITY_EMERGENCY = 3,
+	PRIORITY_LEVELS = 4
+};
+
+// One-way channel between two subsystems.
+// Each priority has its own fixed ring of Capacity slots, so nothing is allocated after construction
+// and routine traffic filling its ring never blocks a fault or emergency message.
+// Every channel has its own lock and condition variable: a push wakes only the thread waiting on this channel.
+template <typename T, size_t Capacity>
+class Channel {
+	static_assert(std::is_trivially_copyable<T>::value, "Messages are copied in and out of slots and must not own heap memory");
+
+public:
+	Channel() : count(), first() {}
+
+	// Blocks while the ring for this priority is full
+	void push(const T& message) {
+		int level = clamp(message.priority);
+		std::unique_lock<std::mutex> lock(mtx);
+		not_full[level].wait(lock, [this, level] {return count[level] < Capacity;});
+		slots[level][(first[level] + count[level]) % Capacity] = message;
+		count[level]++;
+		not_empty.notify_one();
+	}
+
+	// Blocks until a message arrives; the highest priority is served first
+	T pop() {
+		std::unique_lock<std::mutex> lock(mtx);
+		int level;
+		not_empty.wait(lock, [this, &level] {return (level = highest()) >= 0;});
+		T message = slots[level][first[level]];
+		first[level] = (first[level] + 1) % Capacity;
+		count[level]--;
+		not_full[level].notify_one();
+		return message;
+	}
+
+private:
+	T slots[PRIORITY_LEVELS][Capacity];
+	size_t count[PRIORITY_LEVELS];
+	size_t first[PRIORITY_LEVELS];
+	std::mutex mtx;
+	std::condition_variable not_empty;
+	std::condition_variable not_full[PRIORITY_LEVELS];
 
-	bool operator<(const MyStruct& other) const {
-		return priority < other.priority;
+	static int clamp(int priority) {
+		return priority < 0 ? 0 : (priority >= PRIORITY_LEVELS ? PRIORITY_LEVELS - 1 : priority);
+	}
+
+	// Most urgent non-empty ring, or -1; at most PRIORITY_LEVELS checks
+	int highest() const {
+		for (int level = PRIORITY_LEVELS - 1; level >= 0; level--) {
+			if (count[level] > 0) return level;
+		}
+		return -1;
 	}
 };
 
-std::priority_queue<MyStruct> floor_to_scheduler;
-std::priority_queue<MyStruct> elevator_to_scheduler;
-std::priority_queue<MyStruct> scheduler_to_floor;
-std::priority_queue<MyStruct> scheduler_to_elevator;
+const size_t CHANNEL_CAPACITY = 16;
 
-std::mutex mtx;
-std::condition_variable cv;
+Channel<MyStruct, CHANNEL_CAPACITY> floor_to_scheduler;
+Channel<MyStruct, CHANNEL_CAPACITY> elevator_to_scheduler;
+Channel<MyStruct, CHANNEL_CAPACITY> scheduler_to_floor;
+Channel<MyStruct, CHANNEL_CAPACITY> scheduler_to_elevator;
 
 void floor_system() {
-	MyStruct a = { 1, 3, "up", 2 };
+	MyStruct a = { 1, 3, BUTTON_UP, PRIORITY_ROUTINE };
 	std::cout << "Floor subsystem sent message" << std::endl;
 
-	{
-		std::lock_guard<std::mutex> lock(mtx);
-		floor_to_scheduler.push(a);
-	}
-	cv.notify_all();
-	{
-	std::unique_lock<std::mutex> lock(mtx);
-	cv.wait(lock, [] {return !scheduler_to_floor.empty();});
-	MyStruct response0 = scheduler_to_floor.top();
-	scheduler_to_floor.pop();
-	std::cout << "Floor received the response: Floor " << response0.floor << ", button " << response0.button << "processed." << std::endl;
-	}
+	floor_to_scheduler.push(a);
+
+	MyStruct response0 = scheduler_to_floor.pop();
+	std::cout << "Floor received the response: Floor " << response0.floor << ", button " << button_name(response0.button) << "processed." << std::endl;
 }
 
 void scheduler_system() {
-	std::unique_lock<std::mutex> lock(mtx);
-
-	cv.wait(lock, [] {return !floor_to_scheduler.empty();});
-	MyStruct response = floor_to_scheduler.top();
-	floor_to_scheduler.pop();
-
+	MyStruct response = floor_to_scheduler.pop();
 	scheduler_to_elevator.push(response);
-	cv.notify_all();
-
-	cv.wait(lock, [] {return !elevator_to_scheduler.empty();});
-	MyStruct response1 = elevator_to_scheduler.top();
-	elevator_to_scheduler.pop();
 
+	MyStruct response1 = elevator_to_scheduler.pop();
 	scheduler_to_floor.push(response1);
-	cv.notify_all();
 }
 
 void elevactor_system() {
-	std::unique_lock<std::mutex> lock(mtx);
-	cv.wait(lock, [] {return !scheduler_to_elevator.empty();});
-	MyStruct request = scheduler_to_elevator.top();
-	scheduler_to_elevator.pop();
+	MyStruct request = scheduler_to_elevator.pop();
 
-	std::cout << "Elevactor sent the request: Elevactor " << request.floor << ", button " << request.button << std::endl;
+	std::cout << "Elevactor sent the request: Elevactor " << request.floor << ", button " << button_name(request.button) << std::endl;
 	elevator_to_scheduler.push(request);
-	cv.notify_all();
 }
 
 int main() {
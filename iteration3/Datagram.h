@@ -1,13 +1,22 @@
 /* -*- c++-mode -*-
  * Helper classes modelled on the Java versions for interfacing to the internet.
  *
- * A work in progress.
+ * Sockets report failures as -errno return values rather than exceptions,
+ * and can receive a batch of datagrams straight into slabs of a PacketPool
+ * with one recvmmsg(2) call.
  */
 
+#ifndef DATAGRAM_H
+#define DATAGRAM_H
+
 #include <vector>
-#include <exception>
+#include <string>
+#include <algorithm>
 #include <cstring>
-#include <sys/errno.h>
+#include <cstdint>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/types.h> 
 #include <sys/socket.h> 
 #include <arpa/inet.h> 
@@ -22,47 +31,147 @@ public:
 
 class DatagramPacket {
 public:
-    DatagramPacket( std::vector<uint8_t>& data, size_t length, in_addr_t address=INADDR_ANY, in_port_t port=0 ) : _data(data) {
-	_address.sin_family = AF_INET; 
-	_address.sin_port = port;
-	_address.sin_addr.s_addr = address;
-	_length = std::min( data.size(), length );	// Take smaller value.
+    DatagramPacket( std::vector<uint8_t>& data, size_t length, in_addr_t address=INADDR_ANY, in_port_t port=0 )
+	: _data(data.data()), _capacity(data.size()) {
+	init( length, address, port );
+    }
+
+    /*
+     * Wrap memory owned by someone else (e.g. a pool slab); nothing is copied.
+     */
+
+    DatagramPacket( uint8_t * data, size_t capacity, size_t length, in_addr_t address=INADDR_ANY, in_port_t port=0 )
+	: _data(data), _capacity(capacity) {
+	init( length, address, port );
     }
 
-    void * getData() const { return const_cast<void *>(static_cast<const void *>(_data.data())); }
+    void * getData() const { return _data; }
     size_t getLength() const { return _length; }
-    void setLength( size_t length ) { _length = std::min( length, _data.size() ); }
+    size_t getCapacity() const { return _capacity; }
+    void setLength( size_t length ) { _length = std::min( length, _capacity ); }
     in_addr_t getAddress() { return _address.sin_addr.s_addr; }
     in_port_t getPort() { return _address.sin_port; } 	// swap to host byte order.
     std::string getAddressAsString() const { return std::string( inet_ntoa( _address.sin_addr ) ); }
 
     struct sockaddr* address() { return reinterpret_cast<sockaddr*>(&_address); }
-    std::vector<uint8_t>::const_iterator begin() const { return _data.begin(); }
-    std::vector<uint8_t>::const_iterator end() const { return _data.end(); }
+    const uint8_t * begin() const { return _data; }
+    const uint8_t * end() const { return _data + _length; }
 
 private:
-    std::vector<uint8_t>& _data;	/* Don't copy data passed in constructor */
+    void init( size_t length, in_addr_t address, in_port_t port ) {
+	memset( &_address, 0, sizeof(_address) );
+	_address.sin_family = AF_INET; 
+	_address.sin_port = port;
+	_address.sin_addr.s_addr = address;
+	_length = std::min( _capacity, length );	// Take smaller value.
+    }
+
+    uint8_t * _data;		/* Don't copy data passed in constructor */
+    size_t _capacity;
     size_t _length;
     struct sockaddr_in _address;
 };
 
-// Creating socket file descriptor
-class DatagramSocket {
+/*
+ * Fixed-size receive buffers carved out of one allocation made up front.
+ * acquire() and release() never allocate; acquire() returns nullptr when
+ * every slab is lent out.
+ */
+
+class PacketPool {
 public:
-    DatagramSocket() : socket_fd(socket(AF_INET, SOCK_DGRAM, 0)) {
-	if ( socket_fd < 0 ) {
-	    throw std::runtime_error( std::string("socket creation failed: ") + strerror(errno) );
+    PacketPool( size_t slabs, size_t slabSize=1024 ) : _storage(slabs * slabSize), _slabSize(slabSize) {
+	_free.reserve( slabs );
+	for ( size_t i = 0; i < slabs; ++i ) {
+	    _free.push_back( &_storage[i * slabSize] );
 	}
     }
 
+    uint8_t * acquire() {
+	if ( _free.empty() ) return nullptr;
+	uint8_t * slab = _free.back();
+	_free.pop_back();
+	return slab;
+    }
+    void release( uint8_t * slab ) { if ( slab ) _free.push_back( slab ); }	// Capacity reserved: no allocation.
+
+    size_t slabSize() const { return _slabSize; }
+    size_t available() const { return _free.size(); }
+
+private:
+    PacketPool( const PacketPool& );
+    PacketPool& operator=( const PacketPool& );
+
+    std::vector<uint8_t> _storage;
+    std::vector<uint8_t *> _free;
+    size_t _slabSize;
+};
+
+/*
+ * A received datagram that borrows its slab from a PacketPool and hands it
+ * back when destroyed. The payload is followed by a '\0' so text messages
+ * can be parsed in place.
+ */
+
+class PacketView {
+public:
+    PacketView() : _pool(nullptr), _slab(nullptr), _length(0) { memset( &_address, 0, sizeof(_address) ); }
+    PacketView( PacketView&& other ) : _pool(nullptr), _slab(nullptr), _length(0) { *this = std::move(other); }
+    PacketView& operator=( PacketView&& other ) {
+	if ( this != &other ) {
+	    reset();
+	    _pool = other._pool;
+	    _slab = other._slab;
+	    _length = other._length;
+	    _address = other._address;
+	    other._pool = nullptr;
+	    other._slab = nullptr;
+	    other._length = 0;
+	}
+	return *this;
+    }
+    ~PacketView() { reset(); }
+
+    const uint8_t * getData() const { return _slab; }
+    const char * getText() const { return reinterpret_cast<const char *>(_slab); }
+    size_t getLength() const { return _length; }
+    in_addr_t getAddress() const { return _address.sin_addr.s_addr; }
+    in_port_t getPort() const { return _address.sin_port; }
+    bool empty() const { return _slab == nullptr; }
+
+    /* Give the slab back to its pool now rather than at destruction. */
+    void reset() {
+	if ( _pool ) _pool->release( _slab );
+	_pool = nullptr;
+	_slab = nullptr;
+	_length = 0;
+    }
+
+private:
+    friend class DatagramSocket;
+    PacketView( const PacketView& );
+    PacketView& operator=( const PacketView& );
+
+    PacketPool * _pool;
+    uint8_t * _slab;
+    size_t _length;
+    struct sockaddr_in _address;
+};
+
+// Creating socket file descriptor
+class DatagramSocket {
+public:
+    enum { MAX_BATCH=32 };	/* Most datagrams moved by one receiveBatch/sendBatch call */
+
+    DatagramSocket() : socket_fd(socket(AF_INET, SOCK_DGRAM, 0)), _error(socket_fd < 0 ? errno : 0) {}
+
     /*
      * Open a socket and bind to a specific port.  The socket is attached to all interfaces.
+     * Check ok() (or error()) before use.
      */
     
-    DatagramSocket(in_port_t port) : socket_fd(socket(AF_INET, SOCK_DGRAM, 0)) {
-	if ( socket_fd < 0 ) {
-	    throw std::runtime_error( std::string("socket creation failed: ") + strerror(errno) );
-	}
+    DatagramSocket(in_port_t port) : socket_fd(socket(AF_INET, SOCK_DGRAM, 0)), _error(socket_fd < 0 ? errno : 0) {
+	if ( socket_fd < 0 ) return;
 
 	struct sockaddr_in address;
 	memset(&address, 0, sizeof(address)); 
@@ -72,33 +181,117 @@ public:
 	address.sin_addr.s_addr = INADDR_ANY;		/* Bind to all local interfaces */
 
 	if ( bind(socket_fd, (const struct sockaddr *)&address, sizeof(address) ) < 0 ) {
-	    throw std::runtime_error( std::string("socket bind failed") + strerror(errno) );
+	    _error = errno;
 	}
-	
     }
     
     ~DatagramSocket() {
-	close( socket_fd );
+	if ( socket_fd >= 0 ) close( socket_fd );
     }
 
+    bool ok() const { return _error == 0; }
+    int error() const { return _error; }	/* errno from socket()/bind(), 0 if none */
+
+    /*
+     * In non-blocking mode receive() and receiveBatch() return -EAGAIN when nothing is queued.
+     */
+
+    int setNonBlocking( bool enabled ) {
+	int flags = fcntl( socket_fd, F_GETFL, 0 );
+	if ( flags < 0 ) return -errno;
+	flags = enabled ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+	return fcntl( socket_fd, F_SETFL, flags ) < 0 ? -errno : 0;
+    }
+
+    /* Bytes sent, or -errno. */
     ssize_t send( DatagramPacket& packet ) {
-	ssize_t sent = sendto( socket_fd, packet.getData(), packet.getLength(), 0, packet.address(), sizeof(*packet.address()) );
-	if ( sent == -1 ) {
-	    throw std::runtime_error( std::string("sendto failed: ") + strerror(errno) );
-	}
-	return sent;
+	ssize_t sent = sendto( socket_fd, packet.getData(), packet.getLength(), 0, packet.address(), sizeof(struct sockaddr_in) );
+	return sent < 0 ? -errno : sent;
     }
     
-    void receive( DatagramPacket& packet ) {
-	socklen_t len = sizeof(*packet.address());
-	int received = recvfrom(socket_fd, packet.getData(), MAXLINE, MSG_WAITALL, packet.address(), &len);
-	if ( received < 0 ) {
-	    throw std::runtime_error( std::string("recvfrom failed: ") + strerror(errno) );
-	}
+    /* Bytes received, or -errno. */
+    ssize_t receive( DatagramPacket& packet ) {
+	socklen_t len = sizeof(struct sockaddr_in);
+	ssize_t received = recvfrom(socket_fd, packet.getData(), packet.getCapacity(), 0, packet.address(), &len);
+	if ( received < 0 ) return -errno;
 	packet.setLength(received);
+	return received;
+    }
+
+    /*
+     * Receive up to count (at most MAX_BATCH) datagrams with one recvmmsg(2),
+     * each into its own slab from pool. Blocks until at least one arrives
+     * unless the socket is non-blocking. Returns the number received, or
+     * -errno (-ENOBUFS if the pool is empty). Datagrams longer than a slab
+     * (less one byte for the terminator) are truncated.
+     */
+
+    int receiveBatch( PacketPool& pool, PacketView * views, int count ) {
+	count = std::min( count, static_cast<int>(MAX_BATCH) );
+	int slabs = 0;
+	for ( ; slabs < count; ++slabs ) {
+	    _slabs[slabs] = pool.acquire();
+	    if ( !_slabs[slabs] ) break;
+	    _iov[slabs].iov_base = _slabs[slabs];
+	    _iov[slabs].iov_len = pool.slabSize() - 1;
+	    memset( &_msgs[slabs], 0, sizeof(_msgs[slabs]) );
+	    _msgs[slabs].msg_hdr.msg_iov = &_iov[slabs];
+	    _msgs[slabs].msg_hdr.msg_iovlen = 1;
+	    _msgs[slabs].msg_hdr.msg_name = &_addresses[slabs];
+	    _msgs[slabs].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+	}
+	if ( slabs == 0 ) return -ENOBUFS;
+
+	int received = recvmmsg( socket_fd, _msgs, slabs, MSG_WAITFORONE, nullptr );
+	int result = received < 0 ? -errno : received;
+	for ( int i = 0; i < slabs; ++i ) {
+	    if ( i >= received ) {
+		pool.release( _slabs[i] );
+		continue;
+	    }
+	    PacketView& view = views[i];
+	    view.reset();
+	    view._pool = &pool;
+	    view._slab = _slabs[i];
+	    view._length = _msgs[i].msg_len;
+	    view._slab[view._length] = '\0';
+	    view._address = _addresses[i];
+	}
+	return result;
+    }
+
+    /*
+     * Send count (at most MAX_BATCH) packets with one sendmmsg(2).
+     * Returns the number sent, or -errno if none was.
+     */
+
+    int sendBatch( DatagramPacket * packets, int count ) {
+	count = std::min( count, static_cast<int>(MAX_BATCH) );
+	for ( int i = 0; i < count; ++i ) {
+	    _iov[i].iov_base = packets[i].getData();
+	    _iov[i].iov_len = packets[i].getLength();
+	    memset( &_msgs[i], 0, sizeof(_msgs[i]) );
+	    _msgs[i].msg_hdr.msg_iov = &_iov[i];
+	    _msgs[i].msg_hdr.msg_iovlen = 1;
+	    _msgs[i].msg_hdr.msg_name = packets[i].address();
+	    _msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+	}
+	int sent = sendmmsg( socket_fd, _msgs, count, 0 );
+	return sent < 0 ? -errno : sent;
     }
     
 private:
+    DatagramSocket( const DatagramSocket& );
+    DatagramSocket& operator=( const DatagramSocket& );
+
     int socket_fd;
-    static const size_t MAXLINE=1024;
+    int _error;
+
+    /* Scratch for the batch calls, kept here so they never allocate. */
+    struct mmsghdr _msgs[MAX_BATCH];
+    struct iovec _iov[MAX_BATCH];
+    struct sockaddr_in _addresses[MAX_BATCH];
+    uint8_t * _slabs[MAX_BATCH];
 };
+
+#endif // DATAGRAM_H
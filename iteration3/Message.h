@@ -0,0 +1,193 @@
+/* -*- c++-mode -*-
+ * Wire format for the messages exchanged by floor, scheduler and elevator.
+ *
+ * Each datagram is one frame: a 4 byte header (magic, type, payload length)
+ * followed by fixed 32 bit fields in network byte order.  Frames are decoded
+ * in place from the receive buffer.
+ *
+ * The old "floor destination" style text format is kept for debugging:
+ * encoders write it when text mode is on, and decoders accept either format
+ * (a binary frame never starts with a printable character).
+ */
+
+#ifndef MESSAGE_H
+#define MESSAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <arpa/inet.h>
+#include "Datagram.h"
+
+enum MessageType : uint8_t {
+    MSG_FLOOR_REQUEST=1,	/* floor -> scheduler */
+    MSG_ASSIGNMENT=2,		/* scheduler -> elevator */
+    MSG_ELEVATOR_STATUS=3	/* elevator -> scheduler */
+};
+
+enum ElevatorStatusCode : int32_t { STATUS_IDLE=0, STATUS_BUSY=1 };
+
+struct FloorRequestMessage {
+    static const MessageType TYPE = MSG_FLOOR_REQUEST;
+    int32_t floor;
+    int32_t destination;
+};
+
+struct AssignmentMessage {
+    static const MessageType TYPE = MSG_ASSIGNMENT;
+    int32_t elevatorId;
+    int32_t startFloor;
+    int32_t destinationFloor;
+};
+
+struct ElevatorStatusMessage {
+    static const MessageType TYPE = MSG_ELEVATOR_STATUS;
+    int32_t elevatorId;
+    int32_t floor;
+    int32_t status;		/* ElevatorStatusCode */
+};
+
+class MessageCodec {
+public:
+    static const uint8_t MAGIC = 0xE1;
+    static const size_t HEADER_SIZE = 4;
+    static const size_t MAX_FRAME = 64;	/* Large enough for any message in either format */
+
+    /*
+     * Text mode is for watching the traffic (e.g. with tcpdump -A); it is a
+     * process-wide switch so every encoder agrees.
+     */
+
+    static bool& textMode() { static bool text = false; return text; }
+
+    /* Bytes written to buffer, or 0 if it is too small. */
+    static size_t encode( const FloorRequestMessage& m, uint8_t * buffer, size_t capacity ) {
+	int32_t fields[] = { m.floor, m.destination };
+	return textMode() ? encodeText( buffer, capacity, "%d %d", m.floor, m.destination )
+	    : encodeFrame( m.TYPE, fields, 2, buffer, capacity );
+    }
+    static size_t encode( const AssignmentMessage& m, uint8_t * buffer, size_t capacity ) {
+	int32_t fields[] = { m.elevatorId, m.startFloor, m.destinationFloor };
+	return textMode() ? encodeText( buffer, capacity, "%d %d %d", m.elevatorId, m.startFloor, m.destinationFloor )
+	    : encodeFrame( m.TYPE, fields, 3, buffer, capacity );
+    }
+    static size_t encode( const ElevatorStatusMessage& m, uint8_t * buffer, size_t capacity ) {
+	int32_t fields[] = { m.elevatorId, m.floor, m.status };
+	return textMode() ? encodeText( buffer, capacity, "%d %d %s", m.elevatorId, m.floor, m.status == STATUS_IDLE ? "IDLE" : "BUSY" )
+	    : encodeFrame( m.TYPE, fields, 3, buffer, capacity );
+    }
+
+    /* Encode straight into the packet's buffer and set its length. */
+    template<class M> static bool encode( const M& m, DatagramPacket& packet ) {
+	size_t length = encode( m, static_cast<uint8_t *>(packet.getData()), packet.getCapacity() );
+	packet.setLength( length );
+	return length != 0;
+    }
+
+    /* False if the datagram is not a well formed message of this type. */
+    static bool decode( const uint8_t * data, size_t length, FloorRequestMessage& m ) {
+	int32_t f[2];
+	if ( !decodeFields( m.TYPE, data, length, f, 2 ) ) return false;
+	m.floor = f[0]; m.destination = f[1];
+	return true;
+    }
+    static bool decode( const uint8_t * data, size_t length, AssignmentMessage& m ) {
+	int32_t f[3];
+	if ( !decodeFields( m.TYPE, data, length, f, 3 ) ) return false;
+	m.elevatorId = f[0]; m.startFloor = f[1]; m.destinationFloor = f[2];
+	return true;
+    }
+    static bool decode( const uint8_t * data, size_t length, ElevatorStatusMessage& m ) {
+	int32_t f[3];
+	if ( !decodeFields( m.TYPE, data, length, f, 3 ) ) return false;
+	m.elevatorId = f[0]; m.floor = f[1]; m.status = f[2];
+	return true;
+    }
+
+    /* Works for DatagramPacket and PacketView alike. */
+    template<class P, class M> static bool decode( const P& packet, M& m ) {
+	return decode( static_cast<const uint8_t *>(packet.getData()), packet.getLength(), m );
+    }
+
+private:
+    static size_t encodeFrame( MessageType type, const int32_t * fields, size_t count, uint8_t * buffer, size_t capacity ) {
+	size_t payload = count * sizeof(int32_t);
+	if ( capacity < HEADER_SIZE + payload ) return 0;
+	buffer[0] = MAGIC;
+	buffer[1] = type;
+	uint16_t length = htons( static_cast<uint16_t>(payload) );
+	memcpy( buffer + 2, &length, sizeof(length) );
+	for ( size_t i = 0; i < count; ++i ) {
+	    uint32_t field = htonl( static_cast<uint32_t>(fields[i]) );
+	    memcpy( buffer + HEADER_SIZE + i * sizeof(field), &field, sizeof(field) );
+	}
+	return HEADER_SIZE + payload;
+    }
+
+    template<class... Args> static size_t encodeText( uint8_t * buffer, size_t capacity, const char * format, Args... args ) {
+	int length = snprintf( reinterpret_cast<char *>(buffer), capacity, format, args... );
+	return ( length < 0 || static_cast<size_t>(length) >= capacity ) ? 0 : length;
+    }
+
+    static bool decodeFields( MessageType type, const uint8_t * data, size_t length, int32_t * fields, size_t count ) {
+	if ( length > 0 && data[0] == MAGIC ) {
+	    uint16_t payload;
+	    if ( length < HEADER_SIZE || data[1] != type ) return false;
+	    memcpy( &payload, data + 2, sizeof(payload) );
+	    if ( ntohs(payload) != count * sizeof(int32_t) || length != HEADER_SIZE + ntohs(payload) ) return false;
+	    for ( size_t i = 0; i < count; ++i ) {
+		uint32_t field;
+		memcpy( &field, data + HEADER_SIZE + i * sizeof(field), sizeof(field) );
+		fields[i] = static_cast<int32_t>( ntohl(field) );
+	    }
+	    return true;
+	}
+	return decodeText( type, data, length, fields, count );
+    }
+
+    /*
+     * Debug format: whitespace separated integers; a status message ends
+     * with a word instead of a number.  Parsed within [data, data+length)
+     * so the buffer need not be NUL terminated.
+     */
+
+    static bool decodeText( MessageType type, const uint8_t * data, size_t length, int32_t * fields, size_t count ) {
+	const uint8_t * p = data;
+	const uint8_t * end = data + length;
+	size_t numbers = type == MSG_ELEVATOR_STATUS ? count - 1 : count;
+	for ( size_t i = 0; i < numbers; ++i ) {
+	    if ( !parseInt( p, end, fields[i] ) ) return false;
+	}
+	if ( type == MSG_ELEVATOR_STATUS ) {
+	    skipSpace( p, end );
+	    const uint8_t * word = p;
+	    while ( p < end && *p > ' ' ) ++p;
+	    if ( p - word == 4 && memcmp( word, "IDLE", 4 ) == 0 ) fields[count-1] = STATUS_IDLE;
+	    else if ( p > word ) fields[count-1] = STATUS_BUSY;
+	    else return false;
+	}
+	skipSpace( p, end );
+	return p == end || *p == '\0';
+    }
+
+    static void skipSpace( const uint8_t *& p, const uint8_t * end ) {
+	while ( p < end && ( *p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' ) ) ++p;
+    }
+
+    static bool parseInt( const uint8_t *& p, const uint8_t * end, int32_t& value ) {
+	skipSpace( p, end );
+	bool negative = p < end && *p == '-';
+	if ( negative ) ++p;
+	if ( p == end || *p < '0' || *p > '9' ) return false;
+	int64_t result = 0;
+	while ( p < end && *p >= '0' && *p <= '9' ) {
+	    result = result * 10 + ( *p++ - '0' );
+	    if ( result > INT32_MAX ) return false;
+	}
+	value = static_cast<int32_t>( negative ? -result : result );
+	return true;
+    }
+};
+
+#endif // MESSAGE_H
@@ -1,39 +1,46 @@
 #include "Datagram.h"
+#include "Message.h"
 #include <iostream>
 #include <vector>
-#include <sstream>
+#include <cstring>
+#include <string>
 #include <thread>
 #include <chrono>
 
 #define ELEVATOR_PORT 9002
-#define SCHEDULER_PORT 9001
+#define STATUS_PORT 9101     // Scheduler listens for elevator updates here
 
 enum class ElevatorState { IDLE, MOVING, STOPPING, DOOR_OPEN, DOOR_CLOSED };
 
 void elevatorFunction(int elevatorId) {
     DatagramSocket receiveSocket(ELEVATOR_PORT);
     DatagramSocket sendSocket;
+    if (!receiveSocket.ok()) {
+        std::cerr << "Elevator " << elevatorId << " cannot open port " << ELEVATOR_PORT << ": " << strerror(receiveSocket.error()) << std::endl;
+        return;
+    }
     ElevatorState state = ElevatorState::IDLE;
 
     std::cout << "Elevator " << elevatorId << " Listening on port " << ELEVATOR_PORT << "..." << std::endl;
 
-    while (true) {
-        std::vector<uint8_t> data(100);
-        DatagramPacket receivePacket(data, data.size());
+    PacketPool pool(1, 128);
+    PacketView packet;
 
-        try {
-            receiveSocket.receive(receivePacket);
-        } catch (const std::runtime_error& e) {
-            std::cerr << "Error receiving: " << e.what() << std::endl;
+    while (true) {
+        int count = receiveSocket.receiveBatch(pool, &packet, 1);
+        if (count < 0) {
+            std::cerr << "Error receiving: " << strerror(-count) << std::endl;
             continue;
         }
 
-        std::string receivedMsg(reinterpret_cast<const char*>(receivePacket.getData()), receivePacket.getLength());
-        std::istringstream iss(receivedMsg);
-        int receivedElevatorId, pickupFloor, destinationFloor;
-        iss >> receivedElevatorId >> pickupFloor >> destinationFloor;
+        AssignmentMessage assignment;
+        bool valid = MessageCodec::decode(packet, assignment);
+        packet.reset();
+        if (!valid) continue;
 
-        if (receivedElevatorId != elevatorId) continue;
+        if (assignment.elevatorId != elevatorId) continue;
+        int pickupFloor = assignment.startFloor;
+        int destinationFloor = assignment.destinationFloor;
 
         if (state != ElevatorState::IDLE) {
             std::cout << "Elevator " << elevatorId << " is busy. Cannot process request." << std::endl;
@@ -54,10 +61,14 @@ void elevatorFunction(int elevatorId) {
         state = ElevatorState::DOOR_CLOSED;
         std::cout << "Elevator " << elevatorId << " closing doors..." << std::endl;
 
-        std::string updateMsg = std::to_string(elevatorId) + " " + std::to_string(destinationFloor) + " IDLE";
-        std::vector<uint8_t> out(updateMsg.begin(), updateMsg.end());
-        DatagramPacket sendPacket(out, out.size(), InetAddress::getLocalHost(), SCHEDULER_PORT);
-        sendSocket.send(sendPacket);
+        ElevatorStatusMessage update = {elevatorId, destinationFloor, STATUS_IDLE};
+        uint8_t out[MessageCodec::MAX_FRAME];
+        DatagramPacket sendPacket(out, sizeof(out), 0, InetAddress::getLocalHost(), STATUS_PORT);
+        MessageCodec::encode(update, sendPacket);
+        ssize_t sent = sendSocket.send(sendPacket);
+        if (sent < 0) {
+            std::cerr << "Error sending update: " << strerror(-sent) << std::endl;
+        }
 
         std::cout << "Elevator " << elevatorId << " is now idle." << std::endl;
         state = ElevatorState::IDLE;
@@ -66,10 +77,11 @@ void elevatorFunction(int elevatorId) {
 
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: ./elevator <elevator_id>" << std::endl;
+    if (argc < 2 || argc > 3 || (argc == 3 && strcmp(argv[2], "--text") != 0)) {
+        std::cerr << "Usage: ./elevator <elevator_id> [--text]" << std::endl;
         return 1;
     }
+    MessageCodec::textMode() = argc == 3;
 
     int elevatorId = std::stoi(argv[1]);
     elevatorFunction(elevatorId);
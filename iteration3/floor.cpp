@@ -1,9 +1,11 @@
 #include "Datagram.h"
+#include "Message.h"
 #include <iostream>
 #include <vector>
 #include <fstream>
 #include <thread>
 #include <chrono>
+#include <cstring>
 
 #define SCHEDULER_PORT 9001
 
@@ -22,24 +24,27 @@ void floorFunction() {
     while (inputFile >> floor >> destination) {
         if (floor == destination) continue; 
 
-        std::string request = std::to_string(floor) + " " + std::to_string(destination);
-        std::vector<uint8_t> out(request.begin(), request.end());
-        DatagramPacket sendPacket(out, out.size(), InetAddress::getLocalHost(), SCHEDULER_PORT);
+        FloorRequestMessage request = {floor, destination};
+        uint8_t out[MessageCodec::MAX_FRAME];
+        DatagramPacket sendPacket(out, sizeof(out), 0, InetAddress::getLocalHost(), SCHEDULER_PORT);
+        MessageCodec::encode(request, sendPacket);
 
-        try {
-            sendSocket.send(sendPacket);
-            std::cout << "Floor: Sent request " << request << " to Scheduler" << std::endl;
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        } catch (const std::runtime_error& e) {
-            std::cerr << "Error sending request: " << e.what() << std::endl;
+        ssize_t sent = sendSocket.send(sendPacket);
+        if (sent < 0) {
+            std::cerr << "Error sending request: " << strerror(-sent) << std::endl;
+            continue;
         }
+        std::cout << "Floor: Sent request " << floor << " " << destination << " to Scheduler" << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
 
     std::cout << "Floor: All requests sent. Waiting before exit..." << std::endl;
     std::this_thread::sleep_for(std::chrono::seconds(5));
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // --text sends requests in the readable debug format
+    MessageCodec::textMode() = argc > 1 && strcmp(argv[1], "--text") == 0;
     floorFunction();
     return 0;
 }
@@ -1,7 +1,8 @@
 #include "Datagram.h"
+#include "Message.h"
 #include <iostream>
 #include <vector>
-#include <sstream>
+#include <cstring>
 #include <unordered_map>
 #include <thread>
 #include <mutex>
@@ -11,6 +12,8 @@
 
 #define SCHEDULER_PORT 9001
 #define ELEVATOR_PORT 9002
+#define RECEIVE_BATCH 16       // 每次 recvmmsg 最多收取的数据报数
+#define RECEIVE_SLAB_SIZE 128  // 每个接收缓冲区的大小
 
 // 存储楼层请求的结构
 struct FloorRequest {
@@ -26,29 +29,34 @@ std::queue<FloorRequest> pendingRequests;
 // 处理来自楼层的请求线程
 void handleFloorRequests() {
     DatagramSocket receiveSocket(SCHEDULER_PORT);
+    if (!receiveSocket.ok()) {
+        std::cerr << "Scheduler: Cannot open port " << SCHEDULER_PORT << ": " << strerror(receiveSocket.error()) << std::endl;
+        return;
+    }
     std::cout << "Scheduler: Listening for floor requests on port " << SCHEDULER_PORT << "..." << std::endl;
     
+    // 接收缓冲区预先分配，收包时不再申请内存
+    PacketPool pool(RECEIVE_BATCH, RECEIVE_SLAB_SIZE);
+    PacketView packets[RECEIVE_BATCH];
+    
     while (true) {
-        std::vector<uint8_t> data(100);
-        DatagramPacket receivePacket(data, data.size());
+        std::cout << "Scheduler: Waiting for floor requests..." << std::endl;
+        int count = receiveSocket.receiveBatch(pool, packets, RECEIVE_BATCH);
+        if (count < 0) {
+            std::cerr << "Error receiving floor request: " << strerror(-count) << std::endl;
+            continue;
+        }
         
-        try {
-            std::cout << "Scheduler: Waiting for floor requests..." << std::endl;
-            receiveSocket.receive(receivePacket);
-            
-            std::string receivedMsg(reinterpret_cast<const char*>(receivePacket.getData()), receivePacket.getLength());
-            std::istringstream iss(receivedMsg);
-            int floor, destination;
-            iss >> floor >> destination;
-            
-            std::cout << "Scheduler: Received request from Floor " << floor << " to Floor " << destination << std::endl;
-            
-            // 添加到待处理队列
-            std::lock_guard<std::mutex> lock(mtx);
-            pendingRequests.push({floor, destination});
-            
-        } catch (const std::runtime_error& e) {
-            std::cerr << "Error receiving floor request: " << e.what() << std::endl;
+        std::lock_guard<std::mutex> lock(mtx);
+        for (int i = 0; i < count; i++) {
+            FloorRequestMessage message;
+            if (MessageCodec::decode(packets[i], message)) {
+                std::cout << "Scheduler: Received request from Floor " << message.floor << " to Floor " << message.destination << std::endl;
+                
+                // 添加到待处理队列
+                pendingRequests.push({message.floor, message.destination});
+            }
+            packets[i].reset();
         }
     }
 }
@@ -56,30 +64,31 @@ void handleFloorRequests() {
 // 处理来自电梯的状态更新线程
 void handleElevatorUpdates() {
     DatagramSocket receiveSocket(SCHEDULER_PORT + 100); // 使用不同端口9101
+    if (!receiveSocket.ok()) {
+        std::cerr << "Scheduler: Cannot open port " << (SCHEDULER_PORT + 100) << ": " << strerror(receiveSocket.error()) << std::endl;
+        return;
+    }
     std::cout << "Scheduler: Listening for elevator updates on port " << (SCHEDULER_PORT + 100) << "..." << std::endl;
     
+    PacketPool pool(RECEIVE_BATCH, RECEIVE_SLAB_SIZE);
+    PacketView packets[RECEIVE_BATCH];
+    
     while (true) {
-        std::vector<uint8_t> data(100);
-        DatagramPacket receivePacket(data, data.size());
+        int count = receiveSocket.receiveBatch(pool, packets, RECEIVE_BATCH);
+        if (count < 0) {
+            std::cerr << "Error receiving elevator status: " << strerror(-count) << std::endl;
+            continue;
+        }
         
-        try {
-            receiveSocket.receive(receivePacket);
-            
-            std::string statusMsg(reinterpret_cast<const char*>(receivePacket.getData()), receivePacket.getLength());
-            std::istringstream iss(statusMsg);
-            int elevatorId, newPosition;
-            std::string status;
-            iss >> elevatorId >> newPosition >> status;
-            
-            if (status == "IDLE") {
-                std::cout << "Scheduler: Elevator " << elevatorId << " is now IDLE at Floor " << newPosition << std::endl;
+        for (int i = 0; i < count; i++) {
+            ElevatorStatusMessage message;
+            if (MessageCodec::decode(packets[i], message) && message.status == STATUS_IDLE) {
+                std::cout << "Scheduler: Elevator " << message.elevatorId << " is now IDLE at Floor " << message.floor << std::endl;
                 std::lock_guard<std::mutex> lock(mtx);
-                elevatorBusy[elevatorId] = false;
-                elevatorPositions[elevatorId] = newPosition;
+                elevatorBusy[message.elevatorId] = false;
+                elevatorPositions[message.elevatorId] = message.floor;
             }
-            
-        } catch (const std::runtime_error& e) {
-            std::cerr << "Error receiving elevator status: " << e.what() << std::endl;
+            packets[i].reset();
         }
     }
 }
@@ -125,18 +134,16 @@ void assignElevators() {
                     elevatorBusy[bestElevator] = true;
                 }
                 
-                std::string elevatorRequest = std::to_string(bestElevator) + " " + 
-                                             std::to_string(request.startFloor) + " " + 
-                                             std::to_string(request.destinationFloor);
-                                             
-                std::vector<uint8_t> out(elevatorRequest.begin(), elevatorRequest.end());
-                DatagramPacket sendPacket(out, out.size(), InetAddress::getLocalHost(), ELEVATOR_PORT);
+                AssignmentMessage assignment = {bestElevator, request.startFloor, request.destinationFloor};
+                uint8_t out[MessageCodec::MAX_FRAME];
+                DatagramPacket sendPacket(out, sizeof(out), 0, InetAddress::getLocalHost(), ELEVATOR_PORT);
+                MessageCodec::encode(assignment, sendPacket);
                 
-                try {
-                    sendSocket.send(sendPacket);
+                ssize_t sent = sendSocket.send(sendPacket);
+                if (sent >= 0) {
                     std::cout << "Scheduler: Assigned request to Elevator " << bestElevator << std::endl;
-                } catch (const std::runtime_error& e) {
-                    std::cerr << "Error sending to Elevator: " << e.what() << std::endl;
+                } else {
+                    std::cerr << "Error sending to Elevator: " << strerror(-sent) << std::endl;
                     // 请求失败，放回队列
                     std::lock_guard<std::mutex> lock(mtx);
                     pendingRequests.push(request);
@@ -156,7 +163,10 @@ void assignElevators() {
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // --text: 以文本格式发送消息，便于调试
+    MessageCodec::textMode() = argc > 1 && strcmp(argv[1], "--text") == 0;
+    
     // 启动多线程处理
     std::thread floorThread(handleFloorRequests);
     std::thread elevatorThread(handleElevatorUpdates);